@@ -8,6 +8,7 @@
 # SITK_HAS_CXX11_NULLPTR          - True if "nullptr" keyword is supported
 # SITK_HAS_CXX11_UNIQUE_PTR
 # SITK_HAS_CXX11_ALIAS_TEMPLATE   - Able to use alias templates
+# SITK_HAS_CXX11_RVALUE_REFERENCES - True if "&&" rvalue references are supported
 #
 # SITK_HAS_TR1_SUB_INCLUDE
 #
@@ -59,6 +60,7 @@ sitkCXX11Test(SITK_HAS_CXX11_UNORDERED_MAP)
 sitkCXX11Test(SITK_HAS_CXX11_NULLPTR)
 sitkCXX11Test(SITK_HAS_CXX11_UNIQUE_PTR)
 sitkCXX11Test(SITK_HAS_CXX11_ALIAS_TEMPLATE)
+sitkCXX11Test(SITK_HAS_CXX11_RVALUE_REFERENCES)
 
 
 
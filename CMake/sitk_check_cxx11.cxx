@@ -78,6 +78,21 @@ int main(void) {
 
 #endif
 
+//-------------------------------------
+
+#ifdef SITK_HAS_CXX11_RVALUE_REFERENCES
+
+#include <utility>
+
+int f(int &&i) { return i; }
+
+int main(void) {
+  int i = 0;
+  return f( std::move(i) );
+}
+
+#endif
+
 
 
 //-------------------------------------
@@ -20,35 +20,46 @@
 
 
 #include "itkSimpleDataObjectDecorator.h"
-#include "itkImageLinearConstIteratorWithIndex.h"
-#include "itkCastImageFilter.h"
+#include "itkImageToImageFilter.h"
 #include "itkByteSwapper.h"
 
 
 #include "Ancillary/hl_md5.h"
 #include "Ancillary/hl_sha1.h"
+#include "Ancillary/xxhash64.h"
+
+#include <vector>
 
 namespace itk {
 
 /** \class HashImageFilter
  * \brief Generates a hash string from an image.
  *
+ * The input is passed through as the output, the hash is computed
+ * read-only on the input buffer. The pixel values are hashed as little
+ * endian data, on big endian platforms blocks of the buffer are
+ * byte swapped into a temporary copy.
+ *
+ * The XXH64 hash function is a fast non-cryptographic tree hash: the
+ * buffer is split into blocks of BlockSize bytes, which are hashed
+ * in parallel with XXH64, then the block hashes are hashed
+ * together. The result does not depend on the number of threads. The
+ * SHA1 and MD5 hash functions are sequential.
+ *
  * \note This class utlizes low level buffer pointer access, to work
  * with itk::Image and itk::VectorImage. It is modeled after the access
  * an ImageFileWriter provides to an ImageIO.
- *
- * \todo Update in-place on to default after fixing bug in InPlaceImageFilter
  */
 template < class TImageType >
 class HashImageFilter:
-    public CastImageFilter< TImageType, TImageType >
+    public ImageToImageFilter< TImageType, TImageType >
 {
 public:
   /** Standard Self typedef */
-  typedef HashImageFilter                           Self;
-  typedef CastImageFilter< TImageType, TImageType > Superclass;
-  typedef SmartPointer< Self >                      Pointer;
-  typedef SmartPointer< const Self >                ConstPointer;
+  typedef HashImageFilter                              Self;
+  typedef ImageToImageFilter< TImageType, TImageType > Superclass;
+  typedef SmartPointer< Self >                         Pointer;
+  typedef SmartPointer< const Self >                   ConstPointer;
 
   typedef typename TImageType::RegionType RegionType;
 
@@ -56,7 +67,7 @@ public:
   itkNewMacro(Self);
 
   /** Runtime information support. */
-  itkTypeMacro(HashImageFilter, CastImageFilter);
+  itkTypeMacro(HashImageFilter, ImageToImageFilter);
 
   /** Smart Pointer type to a DataObject. */
   typedef typename DataObject::Pointer DataObjectPointer;
@@ -72,12 +83,15 @@ public:
   const HashObjectType* GetHashOutput() const
   { return static_cast<const HashObjectType *>( this->ProcessObject::GetOutput(1) ); }
 
-  enum  HashFunction { SHA1, MD5 };
+  enum  HashFunction { SHA1, MD5, XXH64 };
 
   /** Set/Get hashing function as enumerated type */
   itkSetMacro( HashFunction, HashFunction );
   itkGetMacro( HashFunction, HashFunction );
 
+  /** The size in bytes of the blocks of the XXH64 tree hash. */
+  itkStaticConstMacro(BlockSize, size_t, 1048576);
+
 /** Make a DataObject of the correct type to be used as the specified
    * output. */
   typedef ProcessObject::DataObjectPointerArraySizeType DataObjectPointerArraySizeType;
@@ -86,27 +100,51 @@ public:
 
 protected:
 
+  typedef typename TImageType::PixelType               PixelType;
+  typedef typename NumericTraits<PixelType>::ValueType ValueType;
+
   HashImageFilter();
 
   // virtual ~HashImageFilter(); // implementation not needed
 
   virtual void PrintSelf(std::ostream & os, Indent indent) const ITK_OVERRIDE;
 
-  // See superclass for doxygen documentation
-  //
-  // This method is to do work after the superclass potential threaded
-  // copy.
-  void AfterThreadedGenerateData() ITK_OVERRIDE;
+  // Pass the input through as the output
+  virtual void AllocateOutputs() ITK_OVERRIDE;
+
+  // Compute the hash of the input buffer
+  virtual void GenerateData() ITK_OVERRIDE;
+
+  // Override since the filter needs all of its input
+  virtual void GenerateInputRequestedRegion() ITK_OVERRIDE;
 
   // See superclass for doxygen documentation
   //
   // Override since the filter produces all of its output
   void EnlargeOutputRequestedRegion(DataObject *data) ITK_OVERRIDE;
 
+  // Return a pointer to numberOfValues values as little endian
+  // data. On big endian platforms they are swapped into the
+  // temporary buffer.
+  static const unsigned char *GetLittleEndianValues( const ValueType *values,
+                                                     size_t numberOfValues,
+                                                     std::vector<ValueType> &temporary );
+
 private:
   HashImageFilter(const Self &); //purposely not implemented
   void operator=(const Self &);  //purposely not implemented
 
+  std::string ComputeSequentialHash( const ValueType *buffer, size_t numberOfValues );
+  std::string ComputeTreeHash( const ValueType *buffer, size_t numberOfValues );
+
+  // The block hashes are computed by the threads of the multi-threader
+  struct ThreadStruct
+  {
+    const ValueType       *Buffer;
+    size_t                 NumberOfValues;
+    std::vector<uint64_t> *BlockHashes;
+  };
+  static ITK_THREAD_RETURN_TYPE BlockHashThreaderCallback( void *arg );
 
   HashFunction m_HashFunction;
 };
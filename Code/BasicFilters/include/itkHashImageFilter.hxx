@@ -19,6 +19,9 @@
 #define itkHashImageFilter_hxx
 
 #include "itkHashImageFilter.h"
+#include "itkMultiThreader.h"
+
+#include <algorithm>
 
 namespace itk {
 
@@ -32,9 +35,6 @@ HashImageFilter<TImageType>::HashImageFilter()
 
   // create data object
   this->ProcessObject::SetNthOutput( 1, this->MakeOutput(1).GetPointer() );
-
-  // NOTE: Turning this on causes a crash due to a bug is InPlaceImageFilter
-  this->InPlaceOff();
 }
 
 //
@@ -52,35 +52,27 @@ HashImageFilter<TImageType>::MakeOutput(DataObjectPointerArraySizeType idx)
 }
 
 //
-// AfterThreadedGenerateData
+// AllocateOutputs
 //
 template<class TImageType>
 void
-HashImageFilter<TImageType>::AfterThreadedGenerateData()
+HashImageFilter<TImageType>::AllocateOutputs()
 {
-  // NOTE: We have choose our super class to be the
-  // CastImageFilter. The filter is derived from the
-  // InPlaceFilter. The CastImageFilter will copy its input, in the
-  // best fashion based on the InPlace setting. We want the
-  // behavior. This methods is called after the caster has done it's
-  // work.
-
-  Superclass::AfterThreadedGenerateData();
-
-  typedef TImageType                                   ImageType;
-  typedef typename ImageType::PixelType                PixelType;
-  typedef typename NumericTraits<PixelType>::ValueType ValueType;
-  typedef itk::ByteSwapper<ValueType>                  Swapper;
-
-  ::MD5 md5;
-  ::HL_MD5_CTX md5Context;
-  md5.MD5Init ( &md5Context );
-  ::SHA1 sha1;
-  ::HL_SHA1_CTX sha1Context;
-  sha1.SHA1Reset ( &sha1Context );
+  // Pass the input through as the output, the buffer is not copied
+  TImageType *image = const_cast< TImageType * >( this->GetInput() );
+  this->GraftOutput( image );
+}
 
-  typename ImageType::ConstPointer input = this->GetInput();
+//
+// GenerateData
+//
+template<class TImageType>
+void
+HashImageFilter<TImageType>::GenerateData()
+{
+  this->AllocateOutputs();
 
+  typename TImageType::ConstPointer input = this->GetInput();
 
   // make a good guess about the number of components in each pixel
   size_t numberOfComponent =   sizeof(PixelType) / sizeof(ValueType );
@@ -88,36 +80,89 @@ HashImageFilter<TImageType>::AfterThreadedGenerateData()
   if ( strcmp(input->GetNameOfClass(), "VectorImage") == 0 )
     {
     // spacial case for VectorImages
-    numberOfComponent = ImageType::AccessorFunctorType::GetVectorLength(input);
+    numberOfComponent = TImageType::AccessorFunctorType::GetVectorLength(input);
     }
   else if ( sizeof(PixelType) % sizeof(ValueType) != 0 )
     {
     itkExceptionMacro("Unsupported data type for hashing!");
     }
 
-  // we feel bad about accessing the data this way
-  ValueType *buffer = static_cast<ValueType*>( (void *)input->GetBufferPointer() );
+  // the buffer is only read
+  const ValueType *buffer = reinterpret_cast<const ValueType*>( input->GetBufferPointer() );
 
-  typename ImageType::RegionType largestRegion = input->GetBufferedRegion();
+  typename TImageType::RegionType largestRegion = input->GetBufferedRegion();
   const size_t numberOfValues = largestRegion.GetNumberOfPixels()*numberOfComponent;
 
+  if ( this->m_HashFunction == XXH64 )
+    {
+    this->GetHashOutput()->Set( this->ComputeTreeHash( buffer, numberOfValues ) );
+    }
+  else
+    {
+    this->GetHashOutput()->Set( this->ComputeSequentialHash( buffer, numberOfValues ) );
+    }
+}
 
-  // Possibly byte swap so we always calculate on little endian data
-  Swapper::SwapRangeFromSystemToLittleEndian ( buffer, numberOfValues );
+//
+// GetLittleEndianValues
+//
+template<class TImageType>
+const unsigned char *
+HashImageFilter<TImageType>::GetLittleEndianValues( const ValueType *values,
+                                                    size_t numberOfValues,
+                                                    std::vector<ValueType> &temporary )
+{
+  typedef itk::ByteSwapper<ValueType> Swapper;
 
-  // Update the hash
-  switch ( this->m_HashFunction )
+  if ( !Swapper::SystemIsBigEndian() || sizeof(ValueType) == 1 )
     {
-    case SHA1:
-      sha1.SHA1Input ( &sha1Context, (unsigned char*)buffer, numberOfValues*sizeof(ValueType) );
-      break;
-    case MD5:
-      md5.MD5Update ( &md5Context, (unsigned char*)buffer, numberOfValues*sizeof(ValueType) );
-      break;
+    return reinterpret_cast<const unsigned char*>( values );
+    }
+
+  temporary.assign( values, values + numberOfValues );
+  Swapper::SwapRangeFromSystemToLittleEndian( &temporary[0], numberOfValues );
+  return reinterpret_cast<const unsigned char*>( &temporary[0] );
+}
+
+//
+// ComputeSequentialHash
+//
+template<class TImageType>
+std::string
+HashImageFilter<TImageType>::ComputeSequentialHash( const ValueType *buffer, size_t numberOfValues )
+{
+  ::MD5 md5;
+  ::HL_MD5_CTX md5Context;
+  md5.MD5Init ( &md5Context );
+  ::SHA1 sha1;
+  ::HL_SHA1_CTX sha1Context;
+  sha1.SHA1Reset ( &sha1Context );
+
+  // Update the hash block by block, so that the length of each update
+  // fits the hash interface and big endian data is swapped in a
+  // bounded temporary buffer
+  const size_t valuesPerBlock = BlockSize / sizeof(ValueType);
+  std::vector<ValueType> temporary;
+
+  for ( size_t offset = 0; offset < numberOfValues; offset += valuesPerBlock )
+    {
+    const size_t n = std::min( valuesPerBlock, numberOfValues - offset );
+    unsigned char *bytes = const_cast<unsigned char*>( GetLittleEndianValues( buffer + offset, n, temporary ) );
+
+    switch ( this->m_HashFunction )
+      {
+      case SHA1:
+        sha1.SHA1Input ( &sha1Context, bytes, static_cast<unsigned int>( n*sizeof(ValueType) ) );
+        break;
+      case MD5:
+        md5.MD5Update ( &md5Context, bytes, static_cast<unsigned int>( n*sizeof(ValueType) ) );
+        break;
+      default:
+        itkExceptionMacro("Unexpected hash function!");
+      }
     }
 
   // Calculate and return the hash value
-  std::string hash;
   int HashSize = SHA1HashSize;
   unsigned char Digest[1024];
   switch ( this->m_HashFunction )
@@ -129,6 +174,7 @@ HashImageFilter<TImageType>::AfterThreadedGenerateData()
     break;
     }
     case MD5:
+    default:
     {
     HashSize = 16;
     md5.MD5Final ( Digest, &md5Context );
@@ -148,9 +194,96 @@ HashImageFilter<TImageType>::AfterThreadedGenerateData()
     os << std::hex << static_cast<unsigned int>(Digest[i]);
     }
 
-  this->GetHashOutput()->Set( os.str() );
+  return os.str();
+}
+
+//
+// ComputeTreeHash
+//
+template<class TImageType>
+std::string
+HashImageFilter<TImageType>::ComputeTreeHash( const ValueType *buffer, size_t numberOfValues )
+{
+  const size_t valuesPerBlock = BlockSize / sizeof(ValueType);
+  const size_t numberOfBlocks = ( numberOfValues + valuesPerBlock - 1 ) / valuesPerBlock;
+
+  std::vector<uint64_t> blockHashes( numberOfBlocks );
+
+  ThreadStruct str;
+  str.Buffer = buffer;
+  str.NumberOfValues = numberOfValues;
+  str.BlockHashes = &blockHashes;
+
+  if ( numberOfBlocks > 0 )
+    {
+    const ThreadIdType numberOfThreads =
+      static_cast<ThreadIdType>( std::min<size_t>( std::max<ThreadIdType>( this->GetNumberOfThreads(), 1 ), numberOfBlocks ) );
+
+    this->GetMultiThreader()->SetNumberOfThreads( numberOfThreads );
+    this->GetMultiThreader()->SetSingleMethod( Self::BlockHashThreaderCallback, &str );
+    this->GetMultiThreader()->SingleMethodExecute();
+    }
+
+  // hash the little endian block hashes, seeded with the length of
+  // the data
+  std::vector<unsigned char> encoded( 8*numberOfBlocks );
+  for ( size_t i = 0; i < numberOfBlocks; ++i )
+    {
+    ::XXH64::Encode( blockHashes[i], &encoded[8*i] );
+    }
+  const uint64_t hash = ::XXH64::Hash( encoded.empty() ? ITK_NULLPTR : &encoded[0],
+                                       encoded.size(),
+                                       static_cast<uint64_t>( numberOfValues*sizeof(ValueType) ) );
+
+  std::ostringstream os;
+  os.width(16);
+  os.fill('0');
+  os << std::hex << hash;
+
+  return os.str();
+}
+
+//
+// BlockHashThreaderCallback
+//
+template<class TImageType>
+ITK_THREAD_RETURN_TYPE
+HashImageFilter<TImageType>::BlockHashThreaderCallback( void *arg )
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast<MultiThreader::ThreadInfoStruct *>( arg );
+  ThreadStruct *str = static_cast<ThreadStruct *>( info->UserData );
+
+  const size_t valuesPerBlock = BlockSize / sizeof(ValueType);
+  std::vector<uint64_t> &blockHashes = *str->BlockHashes;
+  std::vector<ValueType> temporary;
+
+  // the blocks are interleaved over the threads
+  for ( size_t block = info->ThreadID; block < blockHashes.size(); block += info->NumberOfThreads )
+    {
+    const size_t offset = block*valuesPerBlock;
+    const size_t n = std::min( valuesPerBlock, str->NumberOfValues - offset );
+    const unsigned char *bytes = GetLittleEndianValues( str->Buffer + offset, n, temporary );
+    blockHashes[block] = ::XXH64::Hash( bytes, n*sizeof(ValueType) );
+    }
+
+  return ITK_THREAD_RETURN_VALUE;
 }
 
+//
+// GenerateInputRequestedRegion
+//
+template<class TImageType>
+void
+HashImageFilter<TImageType>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  TImageType *input = const_cast< TImageType * >( this->GetInput() );
+  if ( input )
+    {
+    input->SetRequestedRegionToLargestPossibleRegion();
+    }
+}
 
 //
 // EnlargeOutputRequestedRegion
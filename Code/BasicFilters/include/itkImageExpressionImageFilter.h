@@ -0,0 +1,189 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageExpressionImageFilter_h
+#define itkImageExpressionImageFilter_h
+
+#include "itkImageToImageFilter.h"
+
+#include <vector>
+
+namespace itk
+{
+
+/** \class ImageExpressionInstruction
+ * \brief A single operation of the program evaluated by
+ * ImageExpressionImageFilter.
+ *
+ * The program is a sequence of instructions in postfix order
+ * operating on a stack of values. An Input instruction pushes the
+ * pixel of the indexed input image, a Constant instruction pushes
+ * Value. The unary operations replace the top of the stack, the
+ * binary operations pop two values and push the result.
+ */
+class ImageExpressionInstruction
+{
+public:
+  typedef enum {
+    Input,
+    Constant,
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Minimum,
+    Maximum,
+    Equal,
+    NotEqual,
+    Less,
+    LessEqual,
+    Greater,
+    GreaterEqual,
+    UnaryMinus,
+    Abs,
+    Sqrt,
+    Exp,
+    Log
+  } OpCodeType;
+
+  ImageExpressionInstruction( OpCodeType opCode = Constant, unsigned int index = 0, double value = 0.0 )
+    : OpCode( opCode ),
+      Index( index ),
+      Value( value )
+    {}
+
+  /** Number of values popped from the stack by the operation. */
+  unsigned int GetNumberOfOperands() const
+    {
+      if ( OpCode == Input || OpCode == Constant )
+        {
+        return 0;
+        }
+      return ( OpCode >= UnaryMinus ) ? 1 : 2;
+    }
+
+  OpCodeType   OpCode;
+  unsigned int Index;
+  double       Value;
+};
+
+
+/** \class ImageExpressionImageFilter
+ * \brief Evaluates a pixel-wise arithmetic expression of several
+ * images in a single pass.
+ *
+ * The expression is described by a program of
+ * ImageExpressionInstruction in postfix order. Each indexed input of
+ * the filter can be referenced by Input instructions any number of
+ * times. All inputs must have the same pixel type and occupy the same
+ * physical space.
+ *
+ * The program is interpreted over blocks of pixels of a scan-line,
+ * so that each operation is a simple loop over contiguous arrays of
+ * doubles which the compiler can vectorize. No intermediate images
+ * are allocated. Intermediate values are computed in double
+ * precision, the result is then converted to the output pixel
+ * type. Values outside the range of an integer output pixel type are
+ * clamped and NaN is converted to zero.
+ *
+ * The comparison operations evaluate to 1 when true and 0 when false.
+ *
+ * \ingroup IntensityImageFilters MultiThreaded
+ */
+template< class TInputImage, class TOutputImage >
+class ITK_EXPORT ImageExpressionImageFilter:
+  public ImageToImageFilter< TInputImage, TOutputImage >
+{
+public:
+  /** Standard class typedefs. */
+  typedef ImageExpressionImageFilter                      Self;
+  typedef ImageToImageFilter< TInputImage, TOutputImage > Superclass;
+  typedef SmartPointer< Self >                            Pointer;
+  typedef SmartPointer< const Self >                      ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ImageExpressionImageFilter, ImageToImageFilter);
+
+  /** Typedef to images */
+  typedef TOutputImage                          OutputImageType;
+  typedef TInputImage                           InputImageType;
+  typedef typename OutputImageType::PixelType   OutputPixelType;
+  typedef typename InputImageType::PixelType    InputPixelType;
+
+  /** Typedef to describe the output image region type. */
+  typedef typename TOutputImage::RegionType OutputImageRegionType;
+
+  typedef ImageExpressionInstruction        InstructionType;
+  typedef std::vector<InstructionType>      ProgramType;
+
+  /** ImageDimension enumeration. */
+  itkStaticConstMacro(ImageDimension, unsigned int,
+                      TInputImage::ImageDimension);
+  itkStaticConstMacro(OutputImageDimension, unsigned int,
+                      TOutputImage::ImageDimension);
+
+  /** Set/Get the program of the expression in postfix order. */
+  void SetProgram( const ProgramType & program );
+  const ProgramType &GetProgram() const { return m_Program; }
+
+  /** Set the input image with index idx. */
+  using Superclass::SetInput;
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  /** Begin concept checking */
+  itkConceptMacro( SameDimensionCheck,
+                   ( Concept::SameDimension< ImageDimension, OutputImageDimension > ) );
+  /** End concept checking */
+#endif
+
+protected:
+  ImageExpressionImageFilter();
+  // ~ImageExpressionImageFilter() {} default ok
+  void PrintSelf(std::ostream & os, Indent indent) const ITK_OVERRIDE;
+
+  /** Verify the program against the number of inputs and compute the
+   * size of the stack needed to evaluate it. */
+  void BeforeThreadedGenerateData() ITK_OVERRIDE;
+
+  void ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
+                            ThreadIdType threadId) ITK_OVERRIDE;
+
+private:
+  ImageExpressionImageFilter(const Self &); //purposely not implemented
+  void operator=(const Self &);             //purposely not implemented
+
+  /** Number of pixels of a scan-line evaluated at once. */
+  static const SizeValueType BlockSize = 256;
+
+  static void EvaluateUnary( InstructionType::OpCodeType opCode, double *a, SizeValueType n );
+  static void EvaluateBinary( InstructionType::OpCodeType opCode, double *a, const double *b, SizeValueType n );
+
+  static OutputPixelType ConvertToOutput( double v );
+
+  ProgramType  m_Program;
+  unsigned int m_StackDepth;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkImageExpressionImageFilter.hxx"
+#endif
+
+#endif
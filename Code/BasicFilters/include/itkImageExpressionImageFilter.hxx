@@ -0,0 +1,329 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageExpressionImageFilter_hxx
+#define itkImageExpressionImageFilter_hxx
+
+#include "itkImageExpressionImageFilter.h"
+#include "itkImageScanlineIterator.h"
+#include "itkMath.h"
+#include "itkProgressReporter.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace itk
+{
+
+template< class TInputImage, class TOutputImage >
+const SizeValueType
+ImageExpressionImageFilter< TInputImage, TOutputImage >
+::BlockSize;
+
+/**
+ *
+ */
+template< class TInputImage, class TOutputImage >
+ImageExpressionImageFilter< TInputImage, TOutputImage >
+::ImageExpressionImageFilter()
+  : m_StackDepth(0)
+{
+}
+
+/**
+ *
+ */
+template< class TInputImage, class TOutputImage >
+void
+ImageExpressionImageFilter< TInputImage, TOutputImage >
+::SetProgram( const ProgramType & program )
+{
+  m_Program = program;
+  this->Modified();
+}
+
+/**
+ *
+ */
+template< class TInputImage, class TOutputImage >
+void
+ImageExpressionImageFilter< TInputImage, TOutputImage >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Program: " << m_Program.size() << " instructions" << std::endl;
+  os << indent << "StackDepth: " << m_StackDepth << std::endl;
+}
+
+/**
+ *
+ */
+template< class TInputImage, class TOutputImage >
+void
+ImageExpressionImageFilter< TInputImage, TOutputImage >
+::BeforeThreadedGenerateData()
+{
+  const unsigned int numberOfInputs = this->GetNumberOfIndexedInputs();
+
+  unsigned int depth = 0;
+  m_StackDepth = 0;
+  for ( size_t i = 0; i < m_Program.size(); ++i )
+    {
+    const InstructionType &instruction = m_Program[i];
+
+    if ( instruction.OpCode == InstructionType::Input )
+      {
+      if ( instruction.Index >= numberOfInputs || this->GetInput( instruction.Index ) == ITK_NULLPTR )
+        {
+        itkExceptionMacro( "Instruction " << i << " references missing input " << instruction.Index << "." );
+        }
+      }
+
+    const unsigned int numberOfOperands = instruction.GetNumberOfOperands();
+    if ( depth < numberOfOperands )
+      {
+      itkExceptionMacro( "Instruction " << i << " has insufficient operands on the stack." );
+      }
+
+    // operations leave exactly one value on the stack
+    depth = depth - numberOfOperands + 1;
+    m_StackDepth = std::max( m_StackDepth, depth );
+    }
+
+  if ( depth != 1 )
+    {
+    itkExceptionMacro( "The program must evaluate to exactly one value, but leaves " << depth << " on the stack." );
+    }
+}
+
+/**
+ *
+ */
+template< class TInputImage, class TOutputImage >
+void
+ImageExpressionImageFilter< TInputImage, TOutputImage >
+::EvaluateUnary( InstructionType::OpCodeType opCode, double *a, SizeValueType n )
+{
+  switch ( opCode )
+    {
+    case InstructionType::UnaryMinus:
+      for ( SizeValueType i = 0; i < n; ++i ) { a[i] = -a[i]; }
+      break;
+    case InstructionType::Abs:
+      for ( SizeValueType i = 0; i < n; ++i ) { a[i] = std::fabs( a[i] ); }
+      break;
+    case InstructionType::Sqrt:
+      for ( SizeValueType i = 0; i < n; ++i ) { a[i] = std::sqrt( a[i] ); }
+      break;
+    case InstructionType::Exp:
+      for ( SizeValueType i = 0; i < n; ++i ) { a[i] = std::exp( a[i] ); }
+      break;
+    case InstructionType::Log:
+      for ( SizeValueType i = 0; i < n; ++i ) { a[i] = std::log( a[i] ); }
+      break;
+    default:
+      itkGenericExceptionMacro( "Unexpected unary operation " << opCode << "." );
+    }
+}
+
+/**
+ *
+ */
+template< class TInputImage, class TOutputImage >
+void
+ImageExpressionImageFilter< TInputImage, TOutputImage >
+::EvaluateBinary( InstructionType::OpCodeType opCode, double *a, const double *b, SizeValueType n )
+{
+  switch ( opCode )
+    {
+    case InstructionType::Add:
+      for ( SizeValueType i = 0; i < n; ++i ) { a[i] += b[i]; }
+      break;
+    case InstructionType::Subtract:
+      for ( SizeValueType i = 0; i < n; ++i ) { a[i] -= b[i]; }
+      break;
+    case InstructionType::Multiply:
+      for ( SizeValueType i = 0; i < n; ++i ) { a[i] *= b[i]; }
+      break;
+    case InstructionType::Divide:
+      for ( SizeValueType i = 0; i < n; ++i ) { a[i] /= b[i]; }
+      break;
+    case InstructionType::Minimum:
+      for ( SizeValueType i = 0; i < n; ++i ) { a[i] = ( b[i] < a[i] ) ? b[i] : a[i]; }
+      break;
+    case InstructionType::Maximum:
+      for ( SizeValueType i = 0; i < n; ++i ) { a[i] = ( a[i] < b[i] ) ? b[i] : a[i]; }
+      break;
+    case InstructionType::Equal:
+      for ( SizeValueType i = 0; i < n; ++i ) { a[i] = ( a[i] == b[i] ) ? 1.0 : 0.0; }
+      break;
+    case InstructionType::NotEqual:
+      for ( SizeValueType i = 0; i < n; ++i ) { a[i] = ( a[i] != b[i] ) ? 1.0 : 0.0; }
+      break;
+    case InstructionType::Less:
+      for ( SizeValueType i = 0; i < n; ++i ) { a[i] = ( a[i] < b[i] ) ? 1.0 : 0.0; }
+      break;
+    case InstructionType::LessEqual:
+      for ( SizeValueType i = 0; i < n; ++i ) { a[i] = ( a[i] <= b[i] ) ? 1.0 : 0.0; }
+      break;
+    case InstructionType::Greater:
+      for ( SizeValueType i = 0; i < n; ++i ) { a[i] = ( a[i] > b[i] ) ? 1.0 : 0.0; }
+      break;
+    case InstructionType::GreaterEqual:
+      for ( SizeValueType i = 0; i < n; ++i ) { a[i] = ( a[i] >= b[i] ) ? 1.0 : 0.0; }
+      break;
+    default:
+      itkGenericExceptionMacro( "Unexpected binary operation " << opCode << "." );
+    }
+}
+
+/**
+ *
+ */
+template< class TInputImage, class TOutputImage >
+typename ImageExpressionImageFilter< TInputImage, TOutputImage >::OutputPixelType
+ImageExpressionImageFilter< TInputImage, TOutputImage >
+::ConvertToOutput( double v )
+{
+  if ( NumericTraits<OutputPixelType>::is_integer )
+    {
+    // only NaN is not equal to itself
+    if ( v != v )
+      {
+      return NumericTraits<OutputPixelType>::ZeroValue();
+      }
+    if ( v <= static_cast<double>( NumericTraits<OutputPixelType>::NonpositiveMin() ) )
+      {
+      return NumericTraits<OutputPixelType>::NonpositiveMin();
+      }
+    if ( v >= static_cast<double>( NumericTraits<OutputPixelType>::max() ) )
+      {
+      return NumericTraits<OutputPixelType>::max();
+      }
+    // round to the nearest integer instead of truncating toward zero
+    return Math::Round<OutputPixelType>( v );
+    }
+  return static_cast<OutputPixelType>( v );
+}
+
+/**
+ *
+ */
+template< class TInputImage, class TOutputImage >
+void
+ImageExpressionImageFilter< TInputImage, TOutputImage >
+::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
+                       ThreadIdType threadId)
+{
+  const SizeValueType size0 = outputRegionForThread.GetSize(0);
+  if ( size0 == 0 )
+    {
+    return;
+    }
+  const SizeValueType numberOfLinesToProcess = outputRegionForThread.GetNumberOfPixels() / size0;
+  ProgressReporter progress( this, threadId, numberOfLinesToProcess );
+
+  typedef ImageScanlineConstIterator< InputImageType > InputIteratorType;
+  typedef ImageScanlineIterator< OutputImageType >     OutputIteratorType;
+
+  const unsigned int numberOfInputs = this->GetNumberOfIndexedInputs();
+
+  // Each input is read once per block into its own buffer, it may be
+  // pushed onto the stack several times by the program.
+  std::vector< InputIteratorType > inputIts;
+  std::vector< unsigned int >      inputOffsets( numberOfInputs, 0 );
+  unsigned int                     numberOfBufferedInputs = 0;
+  for ( unsigned int i = 0; i < numberOfInputs; ++i )
+    {
+    const InputImageType *input = this->GetInput( i );
+    if ( input != ITK_NULLPTR )
+      {
+      inputOffsets[i] = numberOfBufferedInputs++;
+      inputIts.push_back( InputIteratorType( input, outputRegionForThread ) );
+      }
+    }
+
+  std::vector< double > inputBuffer( numberOfBufferedInputs * BlockSize );
+  std::vector< double > stack( m_StackDepth * BlockSize );
+
+  OutputIteratorType outIt( this->GetOutput(), outputRegionForThread );
+
+  while ( !outIt.IsAtEnd() )
+    {
+    for ( SizeValueType start = 0; start < size0; start += BlockSize )
+      {
+      const SizeValueType n = std::min( size0 - start, static_cast<SizeValueType>( BlockSize ) );
+
+      for ( unsigned int k = 0; k < numberOfBufferedInputs; ++k )
+        {
+        double *buffer = &inputBuffer[k * BlockSize];
+        InputIteratorType &it = inputIts[k];
+        for ( SizeValueType i = 0; i < n; ++i, ++it )
+          {
+          buffer[i] = static_cast<double>( it.Get() );
+          }
+        }
+
+      double *top = &stack[0];
+      for ( size_t p = 0; p < m_Program.size(); ++p )
+        {
+        const InstructionType &instruction = m_Program[p];
+        switch ( instruction.GetNumberOfOperands() )
+          {
+          case 0:
+            if ( p != 0 )
+              {
+              top += BlockSize;
+              }
+            if ( instruction.OpCode == InstructionType::Input )
+              {
+              const double *buffer = &inputBuffer[inputOffsets[instruction.Index] * BlockSize];
+              std::copy( buffer, buffer + n, top );
+              }
+            else
+              {
+              std::fill( top, top + n, instruction.Value );
+              }
+            break;
+          case 1:
+            EvaluateUnary( instruction.OpCode, top, n );
+            break;
+          default:
+            top -= BlockSize;
+            EvaluateBinary( instruction.OpCode, top, top + BlockSize, n );
+          }
+        }
+
+      for ( SizeValueType i = 0; i < n; ++i, ++outIt )
+        {
+        outIt.Set( ConvertToOutput( stack[i] ) );
+        }
+      }
+
+    for ( unsigned int k = 0; k < numberOfBufferedInputs; ++k )
+      {
+      inputIts[k].NextLine();
+      }
+    outIt.NextLine();
+    progress.CompletedPixel();
+    }
+}
+
+} // end namespace itk
+
+#endif
@@ -29,7 +29,12 @@ namespace itk {
   namespace simple {
 
     /** \class HashImageFilter
-     * \brief Compute the sha1 or md5 hash of an image
+     * \brief Compute the sha1, md5 or xxh64 hash of an image
+     *
+     * The XXH64 hash function is a fast non-cryptographic tree hash,
+     * computed in parallel over blocks of the image buffer. It is
+     * intended for deduplication and cache keys, and does not depend
+     * on the number of threads.
      *
      * \sa itk::simple::Hash for the procedural interface
      */
@@ -48,7 +53,7 @@ namespace itk {
 
       HashImageFilter();
 
-      enum HashFunction { SHA1, MD5 };
+      enum HashFunction { SHA1, MD5, XXH64 };
       SITK_RETURN_SELF_TYPE_HEADER SetHashFunction ( HashFunction hashFunction );
       HashFunction GetHashFunction () const;
 
@@ -0,0 +1,185 @@
+/*=========================================================================
+*
+*  Copyright Insight Software Consortium
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*         http://www.apache.org/licenses/LICENSE-2.0.txt
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*=========================================================================*/
+#ifndef sitkImageExpression_h
+#define sitkImageExpression_h
+
+#include "sitkBasicFilters.h"
+#include "sitkImage.h"
+
+#include <vector>
+#include <string>
+
+namespace itk {
+namespace simple {
+
+class ImageExpressionFilter;
+
+/** \class ImageExpression
+ * \brief A lazily evaluated pixel-wise expression of images and
+ * constants.
+ *
+ * Combining images with the Image operators runs one filter per
+ * operator, each making a full pass over memory and allocating a
+ * temporary image. An ImageExpression only records the operations,
+ * the whole expression is then computed in a single multi-threaded
+ * pass over the pixels when Evaluate is called:
+ *
+ * \code
+ * Image result = ( ( ImageExpression(a) - b ) * c + 5 ).Evaluate();
+ * \endcode
+ *
+ * All images of an expression must have the same scalar pixel type,
+ * dimension and physical space. The result has the pixel type of the
+ * images. Intermediate values are computed in double precision, so
+ * unlike chained Image operators no intermediate rounding or integer
+ * overflow occurs. For integer pixel types the final value is
+ * rounded to the nearest integer and clamped to the range of the
+ * type. Comparisons evaluate to 1 when true and 0 otherwise.
+ *
+ * The images are shallow copies, so an expression is cheap to build
+ * and later modifications of an image do not affect an expression
+ * already referencing it.
+ *
+ * \sa itk::simple::ImageExpressionFilter
+ */
+class SITKBasicFilters_EXPORT ImageExpression
+{
+public:
+  typedef ImageExpression Self;
+
+  /** The pixel-wise operations of an expression. */
+  enum Operation {
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Minimum,
+    Maximum,
+    Equal,
+    NotEqual,
+    Less,
+    LessEqual,
+    Greater,
+    GreaterEqual,
+    UnaryMinus,
+    Abs,
+    Sqrt,
+    Exp,
+    Log
+  };
+
+  /** Construct an expression of a single image or constant. */
+  explicit ImageExpression( const Image &image );
+  explicit ImageExpression( double constant );
+
+  /** Construct an expression applying an unary or binary
+   * operation to existing expressions.
+   *
+   * An exception is thrown if the number of operands does not match
+   * the operation.
+   * @{
+   */
+  static ImageExpression Apply( Operation operation, const ImageExpression &operand );
+  static ImageExpression Apply( Operation operation, const ImageExpression &operand1, const ImageExpression &operand2 );
+  /**@}*/
+
+  /** Compute the expression in a single pass over the pixels. */
+  Image Evaluate( void ) const;
+
+  /** The number of distinct images referenced by the expression. */
+  unsigned int GetNumberOfImages( void ) const;
+
+  /** Returns true if the operation takes one operand, false if two. */
+  static bool IsUnary( Operation operation );
+
+  /** Print the expression in infix notation, images are named by
+   * their index. */
+  std::string ToString( void ) const;
+
+private:
+  friend class ImageExpressionFilter;
+
+  // The expression is stored as a program in postfix order.
+  struct Instruction
+  {
+    enum Kind { ImageOperand, ConstantOperand, OperationNode };
+    Kind         m_Kind;
+    Operation    m_Operation;
+    unsigned int m_ImageIndex;
+    double       m_Constant;
+  };
+
+  ImageExpression( void ) {}
+
+  // Append the program of other, remapping its image indexes to
+  // the images of this expression.
+  void AppendProgram( const ImageExpression &other );
+
+  std::vector<Instruction> m_Program;
+  std::vector<Image>       m_Images;
+};
+
+
+#ifndef SWIG
+
+/** \brief Operators and functions building lazy expressions.
+ *
+ * At least one operand must be an ImageExpression, the other may be
+ * an ImageExpression, an Image or a constant.
+ * @{
+ */
+#define sitkImageExpressionBinaryMacro( name, operation )                   \
+  inline ImageExpression name( const ImageExpression &e1, const ImageExpression &e2 ) \
+    { return ImageExpression::Apply( ImageExpression::operation, e1, e2 ); } \
+  inline ImageExpression name( const ImageExpression &e, const Image &img ) \
+    { return ImageExpression::Apply( ImageExpression::operation, e, ImageExpression( img ) ); } \
+  inline ImageExpression name( const Image &img, const ImageExpression &e ) \
+    { return ImageExpression::Apply( ImageExpression::operation, ImageExpression( img ), e ); } \
+  inline ImageExpression name( const ImageExpression &e, double s )       \
+    { return ImageExpression::Apply( ImageExpression::operation, e, ImageExpression( s ) ); } \
+  inline ImageExpression name( double s, const ImageExpression &e )       \
+    { return ImageExpression::Apply( ImageExpression::operation, ImageExpression( s ), e ); }
+
+sitkImageExpressionBinaryMacro( operator+, Add )
+sitkImageExpressionBinaryMacro( operator-, Subtract )
+sitkImageExpressionBinaryMacro( operator*, Multiply )
+sitkImageExpressionBinaryMacro( operator/, Divide )
+sitkImageExpressionBinaryMacro( operator==, Equal )
+sitkImageExpressionBinaryMacro( operator!=, NotEqual )
+sitkImageExpressionBinaryMacro( operator<, Less )
+sitkImageExpressionBinaryMacro( operator<=, LessEqual )
+sitkImageExpressionBinaryMacro( operator>, Greater )
+sitkImageExpressionBinaryMacro( operator>=, GreaterEqual )
+sitkImageExpressionBinaryMacro( Minimum, Minimum )
+sitkImageExpressionBinaryMacro( Maximum, Maximum )
+
+#undef sitkImageExpressionBinaryMacro
+
+inline ImageExpression operator-( const ImageExpression &e ) { return ImageExpression::Apply( ImageExpression::UnaryMinus, e ); }
+inline ImageExpression Abs( const ImageExpression &e ) { return ImageExpression::Apply( ImageExpression::Abs, e ); }
+inline ImageExpression Sqrt( const ImageExpression &e ) { return ImageExpression::Apply( ImageExpression::Sqrt, e ); }
+inline ImageExpression Exp( const ImageExpression &e ) { return ImageExpression::Apply( ImageExpression::Exp, e ); }
+inline ImageExpression Log( const ImageExpression &e ) { return ImageExpression::Apply( ImageExpression::Log, e ); }
+/**@}*/
+
+#endif
+
+}
+}
+
+#endif
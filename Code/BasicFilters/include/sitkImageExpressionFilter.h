@@ -0,0 +1,76 @@
+/*=========================================================================
+*
+*  Copyright Insight Software Consortium
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*         http://www.apache.org/licenses/LICENSE-2.0.txt
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*=========================================================================*/
+#ifndef sitkImageExpressionFilter_h
+#define sitkImageExpressionFilter_h
+
+#include "sitkMacro.h"
+#include "sitkMemberFunctionFactory.h"
+#include "sitkImage.h"
+#include "sitkBasicFilters.h"
+#include "sitkProcessObject.h"
+#include "sitkImageExpression.h"
+
+namespace itk {
+  namespace simple {
+
+    /** \class ImageExpressionFilter
+     * \brief Evaluate an ImageExpression in a single multi-threaded
+     * pass over the pixels.
+     *
+     * The filter checks that all images of the expression have the
+     * same pixel type and dimension, then runs the whole expression
+     * with itk::ImageExpressionImageFilter. The number of threads,
+     * stream divisions, debugging and commands of the ProcessObject
+     * apply.
+     *
+     * \sa itk::simple::ImageExpression
+     */
+    class SITKBasicFilters_EXPORT ImageExpressionFilter
+      : public ProcessObject {
+    public:
+      typedef ImageExpressionFilter Self;
+
+      // function pointer type
+      typedef Image (Self::*MemberFunctionType)( const ImageExpression& );
+
+      // this filter works with scalar itk::Image types
+      typedef BasicPixelIDTypeList PixelIDTypeList;
+
+      ImageExpressionFilter();
+
+      /** Name of this class */
+      std::string GetName() const { return std::string ( "ImageExpression"); }
+
+      // Print ourselves out
+      std::string ToString() const;
+
+      Image Execute ( const ImageExpression& );
+
+    private:
+
+      template <class TImageType> Image ExecuteInternal ( const ImageExpression& expression );
+
+      // friend to get access to executeInternal member
+      friend struct detail::MemberFunctionAddressor<MemberFunctionType>;
+
+      nsstd::auto_ptr<detail::MemberFunctionFactory<MemberFunctionType> > m_MemberFactory;
+    };
+
+  }
+}
+#endif
@@ -26,6 +26,8 @@
 #include <itkComposeImageFilter.h>
 #include <itkLabelImageToLabelMapFilter.h>
 #include <itkLabelMapToLabelImageFilter.h>
+#include <itkStreamingImageFilter.h>
+#include <itkNumericTraitsVariableLengthVectorPixel.h>
 
 namespace itk
 {
@@ -51,10 +53,11 @@ CastImageFilter::ExecuteInternalCast( const Image& inImage )
   filter->SetInput ( image );
 
   this->PreUpdate( filter.GetPointer() );
+  AcquiredThreadsReleaser releaseThreads( this );
 
-  filter->Update();
+  typename OutputImageType::Pointer itkOutImage = this->UpdateOutput( filter.GetPointer(), filter->GetOutput() );
 
-  return Image( filter->GetOutput() );
+  return Image( itkOutImage.GetPointer() );
 }
 
 
@@ -72,6 +75,7 @@ Image CastImageFilter::ExecuteInternalToVector( const Image& inImage )
   filter->SetInput ( image );
 
   this->PreUpdate( filter.GetPointer() );
+  AcquiredThreadsReleaser releaseThreads( this );
 
   typedef itk::CastImageFilter< typename FilterType::OutputImageType, OutputImageType > CastFilterType;
   typename CastFilterType::Pointer caster = CastFilterType::New();
@@ -85,9 +89,9 @@ Image CastImageFilter::ExecuteInternalToVector( const Image& inImage )
      std::cout << caster;
      }
 
-  caster->Update();
+  typename OutputImageType::Pointer itkOutImage = this->UpdateOutput( caster.GetPointer(), caster->GetOutput() );
 
-  return Image( caster->GetOutput() );
+  return Image( itkOutImage.GetPointer() );
 }
 
 
@@ -105,6 +109,7 @@ Image CastImageFilter::ExecuteInternalToLabel( const Image& inImage )
   filter->SetInput ( image );
 
   this->PreUpdate( filter.GetPointer() );
+  AcquiredThreadsReleaser releaseThreads( this );
 
   filter->Update();
 
@@ -127,6 +132,7 @@ Image CastImageFilter::ExecuteInternalLabelToImage( const Image& inImage )
   filter->SetInput ( image );
 
   this->PreUpdate( filter.GetPointer() );
+  AcquiredThreadsReleaser releaseThreads( this );
 
   filter->Update();
 
@@ -54,6 +54,9 @@ namespace itk {
         case MD5:
           out << "MD5";
           break;
+        case XXH64:
+          out << "XXH64";
+          break;
         }
       out << std::endl;
       out << ProcessObject::ToString();
@@ -106,7 +109,6 @@ namespace itk {
       typedef itk::HashImageFilter<InputImageType> HashFilterType;
       typename HashFilterType::Pointer hasher = HashFilterType::New();
       hasher->SetInput( image );
-      hasher->InPlaceOff(); // pointless copy of data needed
 
       switch ( this->GetHashFunction() )
         {
@@ -116,9 +118,13 @@ namespace itk {
         case MD5:
           hasher->SetHashFunction( HashFilterType::MD5 );
           break;
+        case XXH64:
+          hasher->SetHashFunction( HashFilterType::XXH64 );
+          break;
         }
 
       this->PreUpdate( hasher.GetPointer() );
+      AcquiredThreadsReleaser releaseThreads( this );
 
       hasher->Update();
 
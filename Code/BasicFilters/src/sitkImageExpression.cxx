@@ -0,0 +1,217 @@
+/*=========================================================================
+*
+*  Copyright Insight Software Consortium
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*         http://www.apache.org/licenses/LICENSE-2.0.txt
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*=========================================================================*/
+#include "sitkImageExpression.h"
+#include "sitkImageExpressionFilter.h"
+
+#include <sstream>
+
+namespace itk {
+  namespace simple {
+
+    namespace
+    {
+    const char *OperationName( ImageExpression::Operation operation )
+    {
+      switch ( operation )
+        {
+        case ImageExpression::Add: return " + ";
+        case ImageExpression::Subtract: return " - ";
+        case ImageExpression::Multiply: return " * ";
+        case ImageExpression::Divide: return " / ";
+        case ImageExpression::Minimum: return "Minimum";
+        case ImageExpression::Maximum: return "Maximum";
+        case ImageExpression::Equal: return " == ";
+        case ImageExpression::NotEqual: return " != ";
+        case ImageExpression::Less: return " < ";
+        case ImageExpression::LessEqual: return " <= ";
+        case ImageExpression::Greater: return " > ";
+        case ImageExpression::GreaterEqual: return " >= ";
+        case ImageExpression::UnaryMinus: return "-";
+        case ImageExpression::Abs: return "Abs";
+        case ImageExpression::Sqrt: return "Sqrt";
+        case ImageExpression::Exp: return "Exp";
+        case ImageExpression::Log: return "Log";
+        }
+      return "?";
+    }
+    }
+
+    ImageExpression::ImageExpression( const Image &image )
+    {
+      Instruction instruction;
+      instruction.m_Kind = Instruction::ImageOperand;
+      instruction.m_Operation = Add;
+      instruction.m_ImageIndex = 0;
+      instruction.m_Constant = 0.0;
+
+      this->m_Images.push_back( image );
+      this->m_Program.push_back( instruction );
+    }
+
+    ImageExpression::ImageExpression( double constant )
+    {
+      Instruction instruction;
+      instruction.m_Kind = Instruction::ConstantOperand;
+      instruction.m_Operation = Add;
+      instruction.m_ImageIndex = 0;
+      instruction.m_Constant = constant;
+
+      this->m_Program.push_back( instruction );
+    }
+
+    bool ImageExpression::IsUnary( Operation operation )
+    {
+      return operation >= UnaryMinus;
+    }
+
+    ImageExpression ImageExpression::Apply( Operation operation, const ImageExpression &operand )
+    {
+      if ( !IsUnary( operation ) )
+        {
+        sitkExceptionMacro( "An unary operation is required with one operand." );
+        }
+
+      ImageExpression result( operand );
+
+      Instruction instruction;
+      instruction.m_Kind = Instruction::OperationNode;
+      instruction.m_Operation = operation;
+      instruction.m_ImageIndex = 0;
+      instruction.m_Constant = 0.0;
+      result.m_Program.push_back( instruction );
+
+      return result;
+    }
+
+    ImageExpression ImageExpression::Apply( Operation operation, const ImageExpression &operand1, const ImageExpression &operand2 )
+    {
+      if ( IsUnary( operation ) )
+        {
+        sitkExceptionMacro( "A binary operation is required with two operands." );
+        }
+
+      ImageExpression result( operand1 );
+      result.AppendProgram( operand2 );
+
+      Instruction instruction;
+      instruction.m_Kind = Instruction::OperationNode;
+      instruction.m_Operation = operation;
+      instruction.m_ImageIndex = 0;
+      instruction.m_Constant = 0.0;
+      result.m_Program.push_back( instruction );
+
+      return result;
+    }
+
+    void ImageExpression::AppendProgram( const ImageExpression &other )
+    {
+      // An image referenced by both expressions, is only an input
+      // once. The const GetITKBase is used, the non-const one makes
+      // the image unique and so never compares equal.
+      std::vector<unsigned int> imageIndexes( other.m_Images.size() );
+      for ( unsigned int i = 0; i < other.m_Images.size(); ++i )
+        {
+        unsigned int j = 0;
+        while ( j < this->m_Images.size() &&
+                static_cast<const Image &>( this->m_Images[j] ).GetITKBase() != other.m_Images[i].GetITKBase() )
+          {
+          ++j;
+          }
+        if ( j == this->m_Images.size() )
+          {
+          this->m_Images.push_back( other.m_Images[i] );
+          }
+        imageIndexes[i] = j;
+        }
+
+      for ( size_t i = 0; i < other.m_Program.size(); ++i )
+        {
+        Instruction instruction = other.m_Program[i];
+        if ( instruction.m_Kind == Instruction::ImageOperand )
+          {
+          instruction.m_ImageIndex = imageIndexes[instruction.m_ImageIndex];
+          }
+        this->m_Program.push_back( instruction );
+        }
+    }
+
+    Image ImageExpression::Evaluate( void ) const
+    {
+      return ImageExpressionFilter().Execute( *this );
+    }
+
+    unsigned int ImageExpression::GetNumberOfImages( void ) const
+    {
+      return static_cast<unsigned int>( this->m_Images.size() );
+    }
+
+    std::string ImageExpression::ToString( void ) const
+    {
+      std::vector<std::string> stack;
+
+      for ( size_t i = 0; i < this->m_Program.size(); ++i )
+        {
+        const Instruction &instruction = this->m_Program[i];
+        std::ostringstream out;
+
+        switch ( instruction.m_Kind )
+          {
+          case Instruction::ImageOperand:
+            out << "image" << instruction.m_ImageIndex;
+            break;
+          case Instruction::ConstantOperand:
+            out << instruction.m_Constant;
+            break;
+          case Instruction::OperationNode:
+            if ( IsUnary( instruction.m_Operation ) )
+              {
+              const std::string operand = stack.back();
+              stack.pop_back();
+              if ( instruction.m_Operation == UnaryMinus )
+                {
+                out << "-" << operand;
+                }
+              else
+                {
+                out << OperationName( instruction.m_Operation ) << "(" << operand << ")";
+                }
+              }
+            else
+              {
+              const std::string operand2 = stack.back();
+              stack.pop_back();
+              const std::string operand1 = stack.back();
+              stack.pop_back();
+              if ( instruction.m_Operation == Minimum || instruction.m_Operation == Maximum )
+                {
+                out << OperationName( instruction.m_Operation ) << "(" << operand1 << ", " << operand2 << ")";
+                }
+              else
+                {
+                out << "(" << operand1 << OperationName( instruction.m_Operation ) << operand2 << ")";
+                }
+              }
+            break;
+          }
+        stack.push_back( out.str() );
+        }
+
+      return stack.empty() ? std::string() : stack.back();
+    }
+  }
+}
@@ -0,0 +1,136 @@
+/*=========================================================================
+*
+*  Copyright Insight Software Consortium
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*         http://www.apache.org/licenses/LICENSE-2.0.txt
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*=========================================================================*/
+#include "sitkImageExpressionFilter.h"
+#include "itkImageExpressionImageFilter.h"
+#include "itkStreamingImageFilter.h"
+
+namespace itk {
+  namespace simple {
+
+    namespace
+    {
+    itk::ImageExpressionInstruction::OpCodeType ToITKOpCode( ImageExpression::Operation operation )
+    {
+      typedef itk::ImageExpressionInstruction I;
+      switch ( operation )
+        {
+        case ImageExpression::Add: return I::Add;
+        case ImageExpression::Subtract: return I::Subtract;
+        case ImageExpression::Multiply: return I::Multiply;
+        case ImageExpression::Divide: return I::Divide;
+        case ImageExpression::Minimum: return I::Minimum;
+        case ImageExpression::Maximum: return I::Maximum;
+        case ImageExpression::Equal: return I::Equal;
+        case ImageExpression::NotEqual: return I::NotEqual;
+        case ImageExpression::Less: return I::Less;
+        case ImageExpression::LessEqual: return I::LessEqual;
+        case ImageExpression::Greater: return I::Greater;
+        case ImageExpression::GreaterEqual: return I::GreaterEqual;
+        case ImageExpression::UnaryMinus: return I::UnaryMinus;
+        case ImageExpression::Abs: return I::Abs;
+        case ImageExpression::Sqrt: return I::Sqrt;
+        case ImageExpression::Exp: return I::Exp;
+        case ImageExpression::Log: return I::Log;
+        }
+      sitkExceptionMacro( "Unknown ImageExpression operation " << operation );
+    }
+    }
+
+    ImageExpressionFilter::ImageExpressionFilter ()
+    {
+      this->m_MemberFactory.reset( new detail::MemberFunctionFactory<MemberFunctionType>( this ) );
+
+      this->m_MemberFactory->RegisterMemberFunctions< PixelIDTypeList, 3 > ();
+      this->m_MemberFactory->RegisterMemberFunctions< PixelIDTypeList, 2 > ();
+    }
+
+    std::string ImageExpressionFilter::ToString() const
+    {
+      std::ostringstream out;
+      out << "itk::simple::ImageExpressionFilter" << std::endl;
+      out << ProcessObject::ToString();
+      return out.str();
+    }
+
+    Image ImageExpressionFilter::Execute ( const ImageExpression& expression )
+    {
+      if ( expression.m_Images.empty() )
+        {
+        sitkExceptionMacro( "The ImageExpression does not reference an image." );
+        }
+
+      const Image &image1 = expression.m_Images[0];
+      PixelIDValueEnum type = image1.GetPixelID();
+      unsigned int dimension = image1.GetDimension();
+
+      for ( unsigned int i = 1; i < expression.m_Images.size(); ++i )
+        {
+        if ( type != expression.m_Images[i].GetPixelIDValue() || dimension != expression.m_Images[i].GetDimension() )
+          {
+          sitkExceptionMacro ( "Image" << i+1 << " of the ImageExpression doesn't match type or dimension!" );
+          }
+        }
+
+      return this->m_MemberFactory->GetMemberFunction( type, dimension )( expression );
+    }
+
+    template <class TImageType>
+    Image ImageExpressionFilter::ExecuteInternal ( const ImageExpression& expression )
+    {
+      typedef TImageType     InputImageType;
+      typedef InputImageType OutputImageType;
+
+      typedef itk::ImageExpressionImageFilter<InputImageType, OutputImageType> FilterType;
+      typename FilterType::Pointer filter = FilterType::New();
+
+      for ( unsigned int i = 0; i < expression.m_Images.size(); ++i )
+        {
+        typename InputImageType::ConstPointer image = this->CastImageToITK<InputImageType>( expression.m_Images[i] );
+        filter->SetInput( i, image.GetPointer() );
+        }
+
+      typename FilterType::ProgramType program;
+      program.reserve( expression.m_Program.size() );
+      for ( size_t i = 0; i < expression.m_Program.size(); ++i )
+        {
+        const ImageExpression::Instruction &instruction = expression.m_Program[i];
+        switch ( instruction.m_Kind )
+          {
+          case ImageExpression::Instruction::ImageOperand:
+            program.push_back( itk::ImageExpressionInstruction( itk::ImageExpressionInstruction::Input, instruction.m_ImageIndex ) );
+            break;
+          case ImageExpression::Instruction::ConstantOperand:
+            program.push_back( itk::ImageExpressionInstruction( itk::ImageExpressionInstruction::Constant, 0, instruction.m_Constant ) );
+            break;
+          case ImageExpression::Instruction::OperationNode:
+            program.push_back( itk::ImageExpressionInstruction( ToITKOpCode( instruction.m_Operation ) ) );
+            break;
+          }
+        }
+      filter->SetProgram( program );
+
+      this->PreUpdate( filter.GetPointer() );
+      AcquiredThreadsReleaser releaseThreads( this );
+
+      typename OutputImageType::Pointer itkOutImage = this->UpdateOutput( filter.GetPointer(), filter->GetOutput() );
+      this->FixNonZeroIndex( itkOutImage.GetPointer() );
+      return Image( this->CastITKToImage( itkOutImage.GetPointer() ) );
+    }
+
+  }
+}
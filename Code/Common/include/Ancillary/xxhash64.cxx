@@ -0,0 +1,146 @@
+/*=========================================================================
+*
+*  Copyright Insight Software Consortium
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*         http://www.apache.org/licenses/LICENSE-2.0.txt
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*=========================================================================*/
+#include "xxhash64.h"
+
+namespace
+{
+
+const uint64_t Prime1 = 11400714785074694791ULL;
+const uint64_t Prime2 = 14029467366897019727ULL;
+const uint64_t Prime3 =  1609587929392839161ULL;
+const uint64_t Prime4 =  9650029242287828579ULL;
+const uint64_t Prime5 =  2870177450012600261ULL;
+
+inline uint64_t RotateLeft( uint64_t x, unsigned int r )
+{
+  return ( x << r ) | ( x >> ( 64 - r ) );
+}
+
+// byte wise little endian reads, independent of the alignment and
+// the endianness of the platform
+inline uint64_t Read64( const unsigned char *p )
+{
+  return static_cast<uint64_t>( p[0] )
+    | ( static_cast<uint64_t>( p[1] ) << 8 )
+    | ( static_cast<uint64_t>( p[2] ) << 16 )
+    | ( static_cast<uint64_t>( p[3] ) << 24 )
+    | ( static_cast<uint64_t>( p[4] ) << 32 )
+    | ( static_cast<uint64_t>( p[5] ) << 40 )
+    | ( static_cast<uint64_t>( p[6] ) << 48 )
+    | ( static_cast<uint64_t>( p[7] ) << 56 );
+}
+
+inline uint64_t Read32( const unsigned char *p )
+{
+  return static_cast<uint64_t>( p[0] )
+    | ( static_cast<uint64_t>( p[1] ) << 8 )
+    | ( static_cast<uint64_t>( p[2] ) << 16 )
+    | ( static_cast<uint64_t>( p[3] ) << 24 );
+}
+
+inline uint64_t Round( uint64_t accumulator, uint64_t input )
+{
+  accumulator += input * Prime2;
+  accumulator = RotateLeft( accumulator, 31 );
+  return accumulator * Prime1;
+}
+
+inline uint64_t MergeRound( uint64_t accumulator, uint64_t value )
+{
+  accumulator ^= Round( 0, value );
+  return accumulator * Prime1 + Prime4;
+}
+
+}
+
+uint64_t XXH64::Hash( const void *input, size_t length, uint64_t seed )
+{
+  const unsigned char *p = static_cast<const unsigned char *>( input );
+  const unsigned char * const end = p + length;
+
+  uint64_t h64;
+
+  if ( length >= 32 )
+    {
+    const unsigned char * const limit = end - 32;
+    uint64_t v1 = seed + Prime1 + Prime2;
+    uint64_t v2 = seed + Prime2;
+    uint64_t v3 = seed;
+    uint64_t v4 = seed - Prime1;
+
+    do
+      {
+      v1 = Round( v1, Read64( p ) );
+      v2 = Round( v2, Read64( p + 8 ) );
+      v3 = Round( v3, Read64( p + 16 ) );
+      v4 = Round( v4, Read64( p + 24 ) );
+      p += 32;
+      }
+    while ( p <= limit );
+
+    h64 = RotateLeft( v1, 1 ) + RotateLeft( v2, 7 ) + RotateLeft( v3, 12 ) + RotateLeft( v4, 18 );
+    h64 = MergeRound( h64, v1 );
+    h64 = MergeRound( h64, v2 );
+    h64 = MergeRound( h64, v3 );
+    h64 = MergeRound( h64, v4 );
+    }
+  else
+    {
+    h64 = seed + Prime5;
+    }
+
+  h64 += static_cast<uint64_t>( length );
+
+  while ( p + 8 <= end )
+    {
+    h64 ^= Round( 0, Read64( p ) );
+    h64 = RotateLeft( h64, 27 ) * Prime1 + Prime4;
+    p += 8;
+    }
+
+  if ( p + 4 <= end )
+    {
+    h64 ^= Read32( p ) * Prime1;
+    h64 = RotateLeft( h64, 23 ) * Prime2 + Prime3;
+    p += 4;
+    }
+
+  while ( p < end )
+    {
+    h64 ^= static_cast<uint64_t>( *p ) * Prime5;
+    h64 = RotateLeft( h64, 11 ) * Prime1;
+    ++p;
+    }
+
+  // final avalanche
+  h64 ^= h64 >> 33;
+  h64 *= Prime2;
+  h64 ^= h64 >> 29;
+  h64 *= Prime3;
+  h64 ^= h64 >> 32;
+
+  return h64;
+}
+
+void XXH64::Encode( uint64_t value, unsigned char output[8] )
+{
+  for ( unsigned int i = 0; i < 8; ++i )
+    {
+    output[i] = static_cast<unsigned char>( value >> ( 8 * i ) );
+    }
+}
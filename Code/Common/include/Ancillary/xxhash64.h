@@ -0,0 +1,50 @@
+/*=========================================================================
+*
+*  Copyright Insight Software Consortium
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*         http://www.apache.org/licenses/LICENSE-2.0.txt
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*=========================================================================*/
+#ifndef XXHASH64_H
+#define XXHASH64_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// included for import export macros
+#include "sitkCommon.h"
+
+/**
+ * @brief An implementation of the XXH64 non-cryptographic hash
+ * function, following the specification of the xxHash algorithm by
+ * Yann Collet.
+ *
+ * The input is read as little endian data, so the hash of a byte
+ * sequence is the same on all platforms.
+ */
+class SITKCommon_EXPORT XXH64
+{
+public:
+
+  /**
+   * @brief Compute the XXH64 hash of length bytes of input.
+   */
+  static uint64_t Hash( const void *input, size_t length, uint64_t seed = 0 );
+
+  /**
+   * @brief Write the value as 8 little endian bytes into output.
+   */
+  static void Encode( uint64_t value, unsigned char output[8] );
+};
+
+#endif
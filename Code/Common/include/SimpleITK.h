@@ -58,6 +58,10 @@
 #include "sitkRandomSeed.h"
 
 #include "sitkProcessObject.h"
+#include "sitkPipeline.h"
+#include "sitkExecutionProfiler.h"
+#include "sitkThreadPool.h"
+#include "sitkTaskGraph.h"
 #include "sitkImageFilter.h"
 #include "sitkCommand.h"
 #include "sitkFunctionCommand.h"
@@ -71,6 +75,8 @@
 
 
 #include "sitkHashImageFilter.h"
+#include "sitkImageExpression.h"
+#include "sitkImageExpressionFilter.h"
 #include "sitkJoinSeriesImageFilter.h"
 #include "sitkComposeImageFilter.h"
 #include "sitkPixelIDTypeLists.h"
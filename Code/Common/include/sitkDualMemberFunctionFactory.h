@@ -21,6 +21,7 @@
 #include "sitkDetail.h"
 #include "sitkMemberFunctionFactoryBase.h"
 
+#include <vector>
 
 
 namespace itk
@@ -56,7 +57,11 @@ namespace detail
  *
  *  An instance of a MemberFunctionFactory is bound to a specific
  *  instance of an object, so that the returned function object does
- *  not need to have the calling object specified.
+ *  not need to have the calling object specified. As with the
+ *  MemberFunctionFactory, the registered member function pointers are
+ *  stored in tables shared by all factories of the same type, one
+ *  for each combination of pixel type lists, dimension and addressor
+ *  registered.
  *
  * \warning Use this class with caution because it can instantiate a
  * combinatorial number of methods.
@@ -76,16 +81,18 @@ public:
   typedef TMemberFunctionPointer                                           MemberFunctionType;
   typedef typename ::detail::FunctionTraits<MemberFunctionType>::ClassType ObjectType;
   typedef typename Superclass::FunctionObjectType                          FunctionObjectType;
+  typedef typename Superclass::KeyType                                     KeyType;
+  typedef MemberFunctionTable<MemberFunctionType, KeyType>                 TableType;
 
   /** \brief Constructor which permanently binds the constructed
    * object to pObject */
   DualMemberFunctionFactory( ObjectType *pObject );
 
-  /** \brief Registers a specific member function.
+  /** \brief Registers a specific member function into a table.
    *
    * Registers a member function templated over TImageType1 and TImageType2 */
   template< typename TImageType1, typename TImageType2 >
-  void Register( MemberFunctionType pfunc,  TImageType1*, TImageType2*  );
+  static void Register( TableType &table, MemberFunctionType pfunc,  TImageType1*, TImageType2*  );
 
   /** \brief Registers the member functions for all combinations of
    * TPixelIDTypeList1 and PixelIDTypeList2
@@ -170,8 +177,24 @@ public:
 
 protected:
 
+  /** Returns the table of member function pointers for the
+   * registration of the pixel type lists, VImageDimension and
+   * TAddressor shared by all factories of this type. The table is
+   * filled on the first call. */
+  template < typename TPixelIDTypeList1,
+             typename TPixelIDTypeList2,
+             unsigned int VImageDimension,
+             typename TAddressor >
+  static const TableType &GetTable( void );
+
+  /** Returns the latest registered member function, or NULL. */
+  const MemberFunctionType *FindMemberFunction( const KeyType &key, unsigned int imageDimension  ) const;
+
   ObjectType *m_ObjectPointer;
 
+  // the tables registered with this factory in order of registration
+  std::vector<const TableType *> m_Tables;
+
 };
 
 } // end namespace detail
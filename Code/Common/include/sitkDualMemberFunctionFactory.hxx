@@ -23,6 +23,8 @@
 #include "sitkPixelIDTokens.h"
 #include "sitkExceptionObject.h"
 
+#include <algorithm>
+
 namespace itk
 {
 namespace simple
@@ -42,8 +44,10 @@ namespace detail
 template < typename TMemberFunctionFactory, unsigned int VImageDimension, typename TAddressor >
 struct DualMemberFunctionInstantiater
 {
-  DualMemberFunctionInstantiater( TMemberFunctionFactory &factory )
-    : m_Factory( factory )
+  typedef typename TMemberFunctionFactory::TableType TableType;
+
+  DualMemberFunctionInstantiater( TableType &table )
+    : m_Table( table )
     {}
   template <class TPixelIDType1, class TPixelIDType2>
   typename EnableIf< IsInstantiated<TPixelIDType1,VImageDimension>::Value &&
@@ -57,7 +61,7 @@ struct DualMemberFunctionInstantiater
       typedef TAddressor                                                             AddressorType;
 
       AddressorType addressor;
-      m_Factory.Register(addressor.CLANG_TEMPLATE operator()<ImageType1, ImageType2>(), (ImageType1*)(NULL), (ImageType2*)(NULL) );
+      TMemberFunctionFactory::Register(m_Table, addressor.CLANG_TEMPLATE operator()<ImageType1, ImageType2>(), (ImageType1*)(NULL), (ImageType2*)(NULL) );
 
     }
 
@@ -73,7 +77,7 @@ struct DualMemberFunctionInstantiater
 
 private:
 
-  TMemberFunctionFactory &m_Factory;
+  TableType &m_Table;
 };
 
 template <typename TMemberFunctionPointer>
@@ -88,7 +92,7 @@ template <typename TMemberFunctionPointer>
 template< typename TImageType1, typename TImageType2 >
 void
 DualMemberFunctionFactory< TMemberFunctionPointer >
-::Register( MemberFunctionType pfunc,  TImageType1*, TImageType2*  )
+::Register( TableType &table, MemberFunctionType pfunc,  TImageType1*, TImageType2*  )
 {
   PixelIDValueType pixelID1 = ImageTypeToPixelIDValue<TImageType1>::Result;
   PixelIDValueType pixelID2 = ImageTypeToPixelIDValue<TImageType2>::Result;
@@ -114,10 +118,10 @@ DualMemberFunctionFactory< TMemberFunctionPointer >
     switch( int(TImageType1::ImageDimension) )
       {
       case 3:
-        Superclass::m_PFunction3[ key ] = Superclass::BindObject( pfunc, m_ObjectPointer );
+        table.m_PFunction3[ key ] = pfunc;
         break;
       case 2:
-        Superclass::m_PFunction2[ key ] = Superclass::BindObject( pfunc, m_ObjectPointer );
+        table.m_PFunction2[ key ] = pfunc;
         break;
       default:
         break;
@@ -125,17 +129,65 @@ DualMemberFunctionFactory< TMemberFunctionPointer >
     }
 }
 
+template <typename TMemberFunctionPointer>
+template < typename TPixelIDTypeList1, typename TPixelIDTypeList2, unsigned int VImageDimension, typename TAddressor >
+const typename DualMemberFunctionFactory< TMemberFunctionPointer >::TableType &
+DualMemberFunctionFactory< TMemberFunctionPointer >
+::GetTable( void )
+{
+  // Local statics are not initialized thread safely by all supported
+  // compilers, the lock serializes the construction and filling.
+  MemberFunctionTableLock lock;
+
+  static TableType table;
+  static bool      filled = false;
+
+  if ( !filled )
+    {
+    typedef DualMemberFunctionInstantiater< Self, VImageDimension, TAddressor > InstantiaterType;
+
+    // initialize function array with pointer
+    typelist::DualVisit<TPixelIDTypeList1, TPixelIDTypeList2> visitEachComboInLists;
+    visitEachComboInLists( InstantiaterType( table ) );
+    filled = true;
+    }
+  return table;
+}
+
 template <typename TMemberFunctionPointer>
 template < typename TPixelIDTypeList1, typename TPixelIDTypeList2, unsigned int VImageDimension, typename TAddressor >
 void
 DualMemberFunctionFactory< TMemberFunctionPointer >
 ::RegisterMemberFunctions( void )
 {
-  typedef DualMemberFunctionInstantiater< Self, VImageDimension, TAddressor > InstantiaterType;
+  const TableType *table = &GetTable<TPixelIDTypeList1, TPixelIDTypeList2, VImageDimension, TAddressor>();
+
+  // a repeated registration moves the table to the latest position
+  typename std::vector<const TableType *>::iterator iter = std::find( m_Tables.begin(), m_Tables.end(), table );
+  if ( iter != m_Tables.end() )
+    {
+    m_Tables.erase( iter );
+    }
+  m_Tables.push_back( table );
+}
 
-  // initialize function array with pointer
-  typelist::DualVisit<TPixelIDTypeList1, TPixelIDTypeList2> visitEachComboInLists;
-  visitEachComboInLists( InstantiaterType( *this ) );
+template <typename TMemberFunctionPointer>
+const typename DualMemberFunctionFactory< TMemberFunctionPointer >::MemberFunctionType *
+DualMemberFunctionFactory< TMemberFunctionPointer >
+::FindMemberFunction( const KeyType &key, unsigned int imageDimension  ) const
+{
+  // later registrations override the earlier ones
+  for ( typename std::vector<const TableType *>::const_reverse_iterator iter = m_Tables.rbegin();
+        iter != m_Tables.rend();
+        ++iter )
+    {
+    const MemberFunctionType *pfunc = (*iter)->Find( key, imageDimension );
+    if ( pfunc )
+      {
+      return pfunc;
+      }
+    }
+  return NULL;
 }
 
 
@@ -147,19 +199,10 @@ DualMemberFunctionFactory< TMemberFunctionPointer >
   try
     {
 
-    typename Superclass::KeyType key(pixelID1, pixelID2);
+    KeyType key(pixelID1, pixelID2);
 
-    switch ( imageDimension )
-      {
-      case 3:
-        // check if tr1::function has been set in map
-        return Superclass::m_PFunction3.find( key ) != Superclass::m_PFunction3.end();
-      case 2:
-        // check if tr1::function has been set in map
-        return Superclass::m_PFunction2.find( key ) != Superclass::m_PFunction2.end();
-      default:
-        return false;
-      }
+    // check if a member function has been registered
+    return this->FindMemberFunction( key, imageDimension ) != NULL;
     }
   // we do not throw exceptions
   catch(...)
@@ -188,11 +231,14 @@ DualMemberFunctionFactory< TMemberFunctionPointer >
   switch ( imageDimension )
     {
     case 3:
-      // check if tr1::function has been set
-      if ( Superclass::m_PFunction3.find( key ) != Superclass::m_PFunction3.end() )
+      // check if a member function has been registered
+      {
+      const MemberFunctionType *pfunc = this->FindMemberFunction( key, imageDimension );
+      if ( pfunc )
         {
-        return Superclass::m_PFunction3[ key ];
+        return Superclass::BindObject( *pfunc, m_ObjectPointer );
         }
+      }
 
       // todo updated exceptions here
       sitkExceptionMacro ( << "Pixel type: "
@@ -202,11 +248,14 @@ DualMemberFunctionFactory< TMemberFunctionPointer >
 
       break;
     case 2:
-      // check if tr1::function has been set
-      if ( Superclass::m_PFunction2.find( key ) != Superclass::m_PFunction2.end() )
+      // check if a member function has been registered
+      {
+      const MemberFunctionType *pfunc = this->FindMemberFunction( key, imageDimension );
+      if ( pfunc )
         {
-        return Superclass::m_PFunction2[ key ];
+        return Superclass::BindObject( *pfunc, m_ObjectPointer );
         }
+      }
 
       sitkExceptionMacro ( << "Pixel type: "
                            << GetPixelIDValueAsString(pixelID1)
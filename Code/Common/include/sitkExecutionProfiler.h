@@ -0,0 +1,120 @@
+/*=========================================================================
+*
+*  Copyright Insight Software Consortium
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*         http://www.apache.org/licenses/LICENSE-2.0.txt
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*=========================================================================*/
+#ifndef sitkExecutionProfiler_h
+#define sitkExecutionProfiler_h
+
+#include "sitkCommon.h"
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace itk
+{
+
+namespace simple
+{
+
+  /** \class ExecutionProfiler
+   * \brief Aggregate the execution profile of all filters by name.
+   *
+   * Each ProcessObject records the wall time, CPU time, number of
+   * threads, output bytes and peak resident memory increase of its
+   * last Execute. When the global profiler is enabled, these
+   * measurements are also accumulated per filter name, so a report
+   * of where the time of a whole program goes can be produced
+   * without an external profiler:
+   *
+   * \code
+   * ExecutionProfiler::Enable();
+   * // ... execute filters ...
+   * std::cout << ExecutionProfiler::GetReport( ExecutionProfiler::CSV );
+   * \endcode
+   *
+   * The profiler is disabled by default. Enabling and accumulation
+   * are thread safe. The CPU time is the processor time of the whole
+   * process during an execution, so it includes the other filters
+   * executed concurrently.
+   */
+  class SITKCommon_EXPORT ExecutionProfiler
+  {
+  public:
+
+    enum ReportFormat { CSV, JSON };
+
+    /** Enable or disable the accumulation of profiles.
+     * @{
+     */
+    static void Enable();
+    static void Disable();
+    static void SetEnabled( bool flag );
+    static bool IsEnabled();
+    /**@}*/
+
+    /** Remove all accumulated profiles. */
+    static void Reset();
+
+    /** The names of the profiled filters, in order of their first
+     * execution. */
+    static std::vector<std::string> GetNames();
+
+    /** Accumulated measurements of the filter name. Zero is
+     * returned for a name which was not profiled.
+     * @{
+     */
+    static unsigned int GetNumberOfExecutions( const std::string &name );
+    static double GetWallTime( const std::string &name );
+    static double GetCPUTime( const std::string &name );
+    static uint64_t GetOutputBytes( const std::string &name );
+    /**@}*/
+
+    /** A report of the accumulated profiles, with one record per
+     * filter name of the number of executions, total wall and CPU
+     * time in seconds, maximum number of threads, total output bytes
+     * and maximum peak resident memory increase in bytes. */
+    static std::string GetReport( ReportFormat format = CSV );
+
+    /** Write the report to a file. An exception is thrown if the file
+     * can not be written. */
+    static void WriteReport( const std::string &fileName, ReportFormat format = CSV );
+
+#ifndef SWIG
+    // Accumulate a measurement of an execution of the filter name,
+    // done by ProcessObject when enabled.
+    static void AddExecution( const std::string &name );
+    static void AddTimes( const std::string &name,
+                          double wallTime,
+                          double cpuTime,
+                          unsigned int numberOfThreads,
+                          uint64_t peakResidentMemoryDelta );
+    static void AddOutputBytes( const std::string &name, uint64_t bytes );
+
+    // Current process wide clocks, in seconds, and the peak resident
+    // memory in bytes, 0 if not available on the platform. The CPU
+    // time is of all threads of the process, not only the calling
+    // thread, so that the ITK worker threads are accounted.
+    static double GetCurrentWallTime();
+    static double GetCurrentCPUTime();
+    static uint64_t GetCurrentPeakResidentMemory();
+#endif
+  };
+
+}
+}
+
+#endif
@@ -23,6 +23,7 @@
 #include "sitkDetail.h"
 #include "sitkPixelIDTokens.h"
 #include "sitkEnableIf.h"
+#include "sitkInterpolator.h"
 
 #include "nsstd/type_traits.h"
 #include "nsstd/auto_ptr.h"
@@ -338,6 +339,77 @@ namespace simple
 
     /** @} */
 
+    /** \brief Get the values of many pixels at once
+     *
+     * The values of the pixels at the provided zero based indexes
+     * are converted to double, with one dispatch for all of the
+     * indexes. The indexes are a flat array with GetDimension()
+     * elements for each index, and the values are a flat array with
+     * GetNumberOfComponentsPerPixel() elements for each index. If an
+     * index is out of bounds an exception will be thrown.
+     *
+     * The raw pointer overloads are wrapped for Java, with the
+     * uint32Array and doubleArray classes, and for C#. Python uses
+     * the NumPy functions GetPixelsAsArray and SetPixelsFromArray.
+     *
+     * Complex and label pixel types are not supported.
+     * @{
+     */
+#if !defined(SWIG) || defined(SWIGJAVA) || defined(SWIGCSHARP)
+    void GetPixelsAsDouble( const uint32_t *indexes, size_t numberOfIndexes, double *values ) const;
+#endif
+    std::vector<double> GetPixelsAsDouble( const std::vector<uint32_t> &indexes ) const;
+    /** @} */
+
+    /** \brief Set the values of many pixels at once
+     *
+     * The values are converted to the image's pixel type and set at
+     * the provided zero based indexes, with one dispatch for all of
+     * the indexes. The layout of the indexes and values follows
+     * GetPixelsAsDouble. If an index is out of bounds an exception
+     * will be thrown before any pixel is set.
+     *
+     * Complex and label pixel types are not supported.
+     * @{
+     */
+#if !defined(SWIG) || defined(SWIGJAVA) || defined(SWIGCSHARP)
+    void SetPixelsAsDouble( const uint32_t *indexes, size_t numberOfIndexes, const double *values );
+#endif
+    void SetPixelsAsDouble( const std::vector<uint32_t> &indexes, const std::vector<double> &values );
+    /** @} */
+
+    /** \brief Interpolate the image at many points at once
+     *
+     * The image is interpolated at continuous indexes, or at points
+     * in physical space, with one dispatch for all of the
+     * points. The points are a flat array with GetDimension()
+     * elements for each point, and the values are a flat array with
+     * GetNumberOfComponentsPerPixel() elements for each point. Points
+     * outside of the image have the defaultValue.
+     *
+     * Only the sitkNearestNeighbor and sitkLinear interpolators are
+     * supported. Complex and label pixel types are not supported.
+     *
+     * As for GetPixelsAsDouble, Python uses the NumPy functions
+     * EvaluateAtContinuousIndexesAsArray and
+     * EvaluateAtPhysicalPointsAsArray instead of the raw pointer
+     * overloads.
+     * @{
+     */
+#if !defined(SWIG) || defined(SWIGJAVA) || defined(SWIGCSHARP)
+    void EvaluateAtContinuousIndexes( const double *indexes, size_t numberOfIndexes, double *values,
+                                      InterpolatorEnum interp = sitkLinear, double defaultValue = 0.0 ) const;
+    void EvaluateAtPhysicalPoints( const double *points, size_t numberOfPoints, double *values,
+                                   InterpolatorEnum interp = sitkLinear, double defaultValue = 0.0 ) const;
+#endif
+    std::vector<double> EvaluateAtContinuousIndexes( const std::vector<double> &indexes,
+                                                     InterpolatorEnum interp = sitkLinear,
+                                                     double defaultValue = 0.0 ) const;
+    std::vector<double> EvaluateAtPhysicalPoints( const std::vector<double> &points,
+                                                  InterpolatorEnum interp = sitkLinear,
+                                                  double defaultValue = 0.0 ) const;
+    /** @} */
+
    /** \brief Get a pointer to the image buffer
      * \warning this is dangerous
      *
@@ -390,9 +462,20 @@ namespace simple
      * The Image class by default performs lazy coping and
      * assignment. This method make sure that coping actually happens
      * to the itk::Image pointed to is only pointed to by this object.
+     *
+     * The pixel buffer is also copied if it is shared with another
+     * image, which differs only by meta-data.
      */
     void MakeUnique( void );
 
+    /** \brief Returns true if no other image shares this image's
+     * itk::Image or pixel buffer.
+     *
+     * When an image is unique, its pixel buffer may be modified
+     * in-place without the change being visible to other images.
+     */
+    bool IsUnique( void ) const;
+
   protected:
 
     /** \brief Methods called by the constructor to allocate and initialize
@@ -426,6 +509,19 @@ namespace simple
 
   private:
 
+    // gives concurrent tasks their own copies of the meta-data
+    friend class TaskGraph;
+
+    /** \brief Make the meta-data of the image unique.
+     *
+     * When the image is shared, a new itk::Image object is created
+     * with copies of the origin, spacing, direction and meta-data
+     * dictionary, while the pixel buffer continues to be
+     * shared. Changes to the meta-data are then not visible to
+     * other images, without the cost of copying the pixels.
+     */
+    void MakeUniqueMetaData( void );
+
    /** Method called by certain constructors to convert ITK images
      * into simpleITK ones.
      *
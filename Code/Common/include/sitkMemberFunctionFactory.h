@@ -22,6 +22,8 @@
 #include "sitkMemberFunctionFactoryBase.h"
 #include "sitkPixelIDValues.h"
 
+#include <vector>
+
 namespace itk
 {
 namespace simple
@@ -50,6 +52,14 @@ namespace detail {
  *  An instance of a MemberFunctionFactory is bound to a specific
  *  instance of an object, so that the returned function object does
  *  not need to have the calling object specified.
+ *
+ *  The registered member function pointers are stored in tables
+ *  shared by all factories of the same TMemberFunctionPointer
+ *  type. There is one table for each combination of pixel type list,
+ *  dimension and addressor registered, filled once when the first
+ *  factory registers it. A factory looks up the tables it registered,
+ *  the latest registration taking precedence, and only the object
+ *  pointer is bound when a function object is requested.
  */
 template <typename TMemberFunctionPointer>
 class MemberFunctionFactory
@@ -64,18 +74,19 @@ public:
   typedef TMemberFunctionPointer                                           MemberFunctionType;
   typedef typename ::detail::FunctionTraits<MemberFunctionType>::ClassType ObjectType;
   typedef typename Superclass::FunctionObjectType                          FunctionObjectType;
+  typedef MemberFunctionTable<MemberFunctionType, int>                     TableType;
 
   /** \brief Constructor which permanently binds the constructed
   * object to pObject */
   MemberFunctionFactory( ObjectType *pObject );
 
-  /** \brief Registers a specific member function.
+  /** \brief Registers a specific member function into a table.
    *
    * Registers a member function which will be dispatched to the
-   * TImageType  type
+   * TImageType type.
    */
   template< typename TImageType >
-  void Register( MemberFunctionType pfunc,  TImageType*  );
+  static void Register( TableType &table, MemberFunctionType pfunc,  TImageType*  );
 
   /** \brief Registers all member functions in TPixelIDTypeList and
    * simple::InstantiatedPixelIDTypeList over itk::Image<Pixel,
@@ -152,8 +163,23 @@ public:
 
 protected:
 
+  /** Returns the table of member function pointers for the
+   * registration of TPixelIDTypeList, VImageDimension and TAddressor
+   * shared by all factories of this type. The table is filled on the
+   * first call. */
+  template < typename TPixelIDTypeList,
+             unsigned int VImageDimension,
+             typename TAddressor >
+  static const TableType &GetTable( void );
+
+  /** Returns the latest registered member function, or NULL. */
+  const MemberFunctionType *FindMemberFunction( PixelIDValueType pixelID, unsigned int imageDimension  ) const;
+
   ObjectType *m_ObjectPointer;
 
+  // the tables registered with this factory in order of registration
+  std::vector<const TableType *> m_Tables;
+
 };
 
 } // end namespace detail
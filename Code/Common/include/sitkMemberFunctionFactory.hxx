@@ -19,6 +19,8 @@
 #define sitkMemberFunctionFactory_hxx
 
 #include <cassert>
+#include <algorithm>
+#include <vector>
 
 #include "sitkMemberFunctionFactory.h"
 #include "sitkDetail.h"
@@ -39,12 +41,14 @@ namespace detail {
 //
 // This predicate calls the provided AddressorType on
 // each valid ImageType defined from the pixel type id, and the
-// provided dimension
+// provided dimension, and registers the result in the table
 template < typename TMemberFunctionFactory, unsigned int VImageDimension, typename TAddressor >
 struct MemberFunctionInstantiater
 {
-  MemberFunctionInstantiater( TMemberFunctionFactory &factory )
-    : m_Factory( factory )
+  typedef typename TMemberFunctionFactory::TableType TableType;
+
+  MemberFunctionInstantiater( TableType &table )
+    : m_Table( table )
     {}
 
   template <class TPixelIDType>
@@ -56,7 +60,7 @@ struct MemberFunctionInstantiater
       typedef TAddressor                                                            AddressorType;
 
       AddressorType addressor;
-      m_Factory.Register(addressor.CLANG_TEMPLATE operator()<ImageType>(), (ImageType*)(NULL));
+      TMemberFunctionFactory::Register(m_Table, addressor.CLANG_TEMPLATE operator()<ImageType>(), (ImageType*)(NULL));
 
     }
 
@@ -70,7 +74,7 @@ struct MemberFunctionInstantiater
 
 private:
 
-  TMemberFunctionFactory &m_Factory;
+  TableType &m_Table;
 };
 
 template <typename TMemberFunctionPointer>
@@ -84,7 +88,9 @@ MemberFunctionFactory<TMemberFunctionPointer>
 template <typename TMemberFunctionPointer>
 template<typename TImageType >
 void MemberFunctionFactory<TMemberFunctionPointer>
-::Register( typename MemberFunctionFactory::MemberFunctionType pfunc,  TImageType*  )
+::Register( typename MemberFunctionFactory::TableType &table,
+            typename MemberFunctionFactory::MemberFunctionType pfunc,
+            TImageType*  )
 {
   PixelIDValueType pixelID = ImageTypeToPixelIDValue<TImageType>::Result;
 
@@ -99,13 +105,13 @@ void MemberFunctionFactory<TMemberFunctionPointer>
     switch( int(TImageType::ImageDimension) )
       {
       case 4:
-        Superclass::m_PFunction4[ pixelID ] = Superclass::BindObject( pfunc, m_ObjectPointer );
+        table.m_PFunction4[ pixelID ] = pfunc;
         break;
       case 3:
-        Superclass::m_PFunction3[ pixelID ] = Superclass::BindObject( pfunc, m_ObjectPointer );
+        table.m_PFunction3[ pixelID ] = pfunc;
         break;
       case 2:
-        Superclass::m_PFunction2[ pixelID ] = Superclass::BindObject( pfunc, m_ObjectPointer );
+        table.m_PFunction2[ pixelID ] = pfunc;
         break;
       default:
         break;
@@ -113,6 +119,33 @@ void MemberFunctionFactory<TMemberFunctionPointer>
     }
 }
 
+template <typename TMemberFunctionPointer>
+template <typename TPixelIDTypeList,
+          unsigned int VImageDimension,
+          typename TAddressor>
+const typename MemberFunctionFactory<TMemberFunctionPointer>::TableType &
+MemberFunctionFactory<TMemberFunctionPointer>
+::GetTable( void )
+{
+  // Local statics are not initialized thread safely by all supported
+  // compilers, the lock serializes the construction and filling.
+  MemberFunctionTableLock lock;
+
+  static TableType table;
+  static bool      filled = false;
+
+  if ( !filled )
+    {
+    typedef MemberFunctionInstantiater< MemberFunctionFactory, VImageDimension, TAddressor > InstantiaterType;
+
+    // visit each type in the list, and register if instantiated
+    typelist::Visit<TPixelIDTypeList> visitEachType;
+    visitEachType( InstantiaterType( table ) );
+    filled = true;
+    }
+  return table;
+}
+
 template <typename TMemberFunctionPointer>
 template <typename TPixelIDTypeList,
           unsigned int VImageDimension,
@@ -120,11 +153,34 @@ template <typename TPixelIDTypeList,
 void MemberFunctionFactory<TMemberFunctionPointer>
 ::RegisterMemberFunctions( void )
 {
-  typedef MemberFunctionInstantiater< MemberFunctionFactory, VImageDimension,TAddressor > InstantiaterType;
+  const TableType *table = &GetTable<TPixelIDTypeList, VImageDimension, TAddressor>();
 
-  // visit each type in the list, and register if instantiated
-  typelist::Visit<TPixelIDTypeList> visitEachType;
-  visitEachType( InstantiaterType( *this ) );
+  // a repeated registration moves the table to the latest position
+  typename std::vector<const TableType *>::iterator iter = std::find( m_Tables.begin(), m_Tables.end(), table );
+  if ( iter != m_Tables.end() )
+    {
+    m_Tables.erase( iter );
+    }
+  m_Tables.push_back( table );
+}
+
+template <typename TMemberFunctionPointer>
+const typename MemberFunctionFactory<TMemberFunctionPointer>::MemberFunctionType *
+MemberFunctionFactory<TMemberFunctionPointer>
+::FindMemberFunction( PixelIDValueType pixelID, unsigned int imageDimension  ) const
+{
+  // later registrations override the earlier ones
+  for ( typename std::vector<const TableType *>::const_reverse_iterator iter = m_Tables.rbegin();
+        iter != m_Tables.rend();
+        ++iter )
+    {
+    const MemberFunctionType *pfunc = (*iter)->Find( pixelID, imageDimension );
+    if ( pfunc )
+      {
+      return pfunc;
+      }
+    }
+  return NULL;
 }
 
 
@@ -136,20 +192,8 @@ MemberFunctionFactory< TMemberFunctionPointer >
 
   try
     {
-    switch ( imageDimension )
-      {
-      case 4:
-        // check if tr1::function has been set in map
-        return Superclass::m_PFunction4.find( pixelID ) != Superclass::m_PFunction4.end();
-      case 3:
-        // check if tr1::function has been set in map
-        return Superclass::m_PFunction3.find( pixelID ) != Superclass::m_PFunction3.end();
-      case 2:
-        // check if tr1::function has been set in map
-        return Superclass::m_PFunction2.find( pixelID ) != Superclass::m_PFunction2.end();
-      default:
-        return false;
-      }
+    // check if a member function has been registered
+    return this->FindMemberFunction( pixelID, imageDimension ) != NULL;
     }
   // we do not throw exceptions
   catch(...)
@@ -172,11 +216,14 @@ MemberFunctionFactory<TMemberFunctionPointer>
   switch ( imageDimension )
     {
     case 4:
-      // check if tr1::function has been set
-      if ( Superclass::m_PFunction4.find( pixelID ) != Superclass::m_PFunction4.end() )
+      // check if a member function has been registered
+      {
+      const MemberFunctionType *pfunc = this->FindMemberFunction( pixelID, imageDimension );
+      if ( pfunc )
         {
-        return Superclass::m_PFunction4[ pixelID ];
+        return Superclass::BindObject( *pfunc, m_ObjectPointer );
         }
+      }
 
       sitkExceptionMacro ( << "Pixel type: "
                            << GetPixelIDValueAsString(pixelID)
@@ -184,11 +231,14 @@ MemberFunctionFactory<TMemberFunctionPointer>
                            << typeid(ObjectType).name()
                            << " or SimpleITK compiled with SimpleITK_4D_IMAGES set to OFF." );
     case 3:
-      // check if tr1::function has been set
-      if ( Superclass::m_PFunction3.find( pixelID ) != Superclass::m_PFunction3.end() )
+      // check if a member function has been registered
+      {
+      const MemberFunctionType *pfunc = this->FindMemberFunction( pixelID, imageDimension );
+      if ( pfunc )
         {
-        return Superclass::m_PFunction3[ pixelID ];
+        return Superclass::BindObject( *pfunc, m_ObjectPointer );
         }
+      }
 
       sitkExceptionMacro ( << "Pixel type: "
                            << GetPixelIDValueAsString(pixelID)
@@ -197,11 +247,14 @@ MemberFunctionFactory<TMemberFunctionPointer>
 
       break;
     case 2:
-      // check if tr1::function has been set
-      if (  Superclass::m_PFunction2.find( pixelID ) != Superclass::m_PFunction2.end() )
+      // check if a member function has been registered
+      {
+      const MemberFunctionType *pfunc = this->FindMemberFunction( pixelID, imageDimension );
+      if ( pfunc )
         {
-        return Superclass::m_PFunction2[ pixelID ];
+        return Superclass::BindObject( *pfunc, m_ObjectPointer );
         }
+      }
 
         sitkExceptionMacro ( << "Pixel type: "
                              << GetPixelIDValueAsString(pixelID)
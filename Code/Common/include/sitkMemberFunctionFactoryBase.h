@@ -25,6 +25,7 @@
 #include "sitkPixelIDTypes.h"
 #include "sitkPixelIDTypeLists.h"
 #include "sitkMacro.h"
+#include "sitkCommon.h"
 #include "sitkNonCopyable.h"
 
 #include "Ancillary/TypeList.h"
@@ -61,6 +62,82 @@ private:
 };
 #endif
 
+
+/** \class MemberFunctionTable
+ * \brief The registered pointers to member functions for each image
+ * dimension.
+ *
+ * The table holds plain pointers to member functions, which are not
+ * bound to an object. A table is filled once for each combination of
+ * member function pointer type, pixel type lists, dimension and
+ * addressor registered, and then shared by all factories which
+ * register the same combination. The object is bound when a function
+ * object is requested from the factory.
+ */
+template< typename TMemberFunctionPointer, typename TKey >
+struct MemberFunctionTable
+  : protected NonCopyable
+{
+#if defined SITK_HAS_UNORDERED_MAP
+  typedef nsstd::unordered_map< TKey, TMemberFunctionPointer, hash<TKey> > MapType;
+#else
+  typedef std::map<TKey, TMemberFunctionPointer> MapType;
+#endif
+
+  MemberFunctionTable( void )
+#if defined SITK_HAS_UNORDERED_MAP
+    :  m_PFunction4( typelist::Length<InstantiatedPixelIDTypeList>::Result ),
+       m_PFunction3( typelist::Length<InstantiatedPixelIDTypeList>::Result ),
+       m_PFunction2( typelist::Length<InstantiatedPixelIDTypeList>::Result )
+#endif
+    { }
+
+  /** Returns the registered member function, or NULL. */
+  const TMemberFunctionPointer *Find( const TKey &key, unsigned int imageDimension ) const
+    {
+      const MapType *pfunctions;
+      switch ( imageDimension )
+        {
+        case 4:
+          pfunctions = &m_PFunction4;
+          break;
+        case 3:
+          pfunctions = &m_PFunction3;
+          break;
+        case 2:
+          pfunctions = &m_PFunction2;
+          break;
+        default:
+          return NULL;
+        }
+      typename MapType::const_iterator iter = pfunctions->find( key );
+      return ( iter != pfunctions->end() ) ? &iter->second : NULL;
+    }
+
+  // maps of Keys to pointers to member functions
+  MapType m_PFunction4;
+  MapType m_PFunction3;
+  MapType m_PFunction2;
+};
+
+
+/** \class MemberFunctionTableLock
+ * \brief Holds the lock serializing the filling of the shared member
+ * function tables for its lifetime.
+ *
+ * Function local statics are not initialized thread safely by all
+ * supported compilers, so the tables are created and filled with this
+ * lock held.
+ */
+class SITKCommon_EXPORT MemberFunctionTableLock
+  : protected NonCopyable
+{
+public:
+  MemberFunctionTableLock( void );
+  ~MemberFunctionTableLock( void );
+};
+
+
 template< typename TMemberFunctionPointer,
           typename TKey,
           unsigned int TArity = ::detail::FunctionTraits<TMemberFunctionPointer>::arity>
@@ -84,14 +161,6 @@ protected:
   typedef typename ::detail::FunctionTraits<MemberFunctionType>::ResultType    MemberFunctionResultType;
 
 
-  MemberFunctionFactoryBase( void )
-#if defined SITK_HAS_UNORDERED_MAP
-    :  m_PFunction4( typelist::Length<InstantiatedPixelIDTypeList>::Result ),
-       m_PFunction3( typelist::Length<InstantiatedPixelIDTypeList>::Result ),
-       m_PFunction2( typelist::Length<InstantiatedPixelIDTypeList>::Result )
-#endif
-    { }
-
 public:
 
   /**  the pointer MemberFunctionType redefined ad a tr1::function
@@ -115,18 +184,6 @@ protected:
       // specify the other arguments, and can't just bind the first
       return nsstd::bind( pfunc,objectPointer );
     }
-
-  // maps of Keys to pointers to member functions
-#if defined SITK_HAS_UNORDERED_MAP
-  nsstd::unordered_map< TKey, FunctionObjectType, hash<TKey> > m_PFunction4;
-  nsstd::unordered_map< TKey, FunctionObjectType, hash<TKey> > m_PFunction3;
-  nsstd::unordered_map< TKey, FunctionObjectType, hash<TKey> > m_PFunction2;
-#else
-  std::map<TKey, FunctionObjectType> m_PFunction4;
-  std::map<TKey, FunctionObjectType> m_PFunction3;
-  std::map<TKey, FunctionObjectType> m_PFunction2;
-#endif
-
 };
 
 
@@ -148,14 +205,6 @@ protected:
   typedef typename ::detail::FunctionTraits<MemberFunctionType>::Argument0Type MemberFunctionArgumentType;
 
 
-  MemberFunctionFactoryBase( void )
-#if defined SITK_HAS_UNORDERED_MAP
-    :  m_PFunction4( typelist::Length<InstantiatedPixelIDTypeList>::Result ),
-       m_PFunction3( typelist::Length<InstantiatedPixelIDTypeList>::Result ),
-       m_PFunction2( typelist::Length<InstantiatedPixelIDTypeList>::Result )
-#endif
-    { }
-
 public:
 
   /**  the pointer MemberFunctionType redefined ad a tr1::function
@@ -182,19 +231,6 @@ protected:
       return nsstd::bind( pfunc,objectPointer, _1 );
     }
 
-
-  // maps of Keys to pointers to member functions
-#if defined SITK_HAS_UNORDERED_MAP
-  nsstd::unordered_map< TKey, FunctionObjectType, hash<TKey> > m_PFunction4;
-  nsstd::unordered_map< TKey, FunctionObjectType, hash<TKey> > m_PFunction3;
-  nsstd::unordered_map< TKey, FunctionObjectType, hash<TKey> > m_PFunction2;
-#else
-  std::map<TKey, FunctionObjectType> m_PFunction4;
-  std::map<TKey, FunctionObjectType> m_PFunction3;
-  std::map<TKey, FunctionObjectType> m_PFunction2;
-#endif
-
-
 };
 
 
@@ -211,14 +247,6 @@ protected:
   typedef typename ::detail::FunctionTraits<MemberFunctionType>::ClassType     ObjectType;
 
 
-  MemberFunctionFactoryBase( void )
-#if defined SITK_HAS_UNORDERED_MAP
-    :  m_PFunction4( typelist::Length<InstantiatedPixelIDTypeList>::Result ),
-       m_PFunction3( typelist::Length<InstantiatedPixelIDTypeList>::Result ),
-       m_PFunction2( typelist::Length<InstantiatedPixelIDTypeList>::Result )
-#endif
-    { }
-
 public:
 
   /**  the pointer MemberFunctionType redefined ad a tr1::function
@@ -246,19 +274,6 @@ protected:
       return nsstd::bind( pfunc, objectPointer, _1, _2 );
     }
 
-
-  // maps of Keys to pointers to member functions
-#if defined SITK_HAS_UNORDERED_MAP
-  nsstd::unordered_map< TKey, FunctionObjectType, hash<TKey> > m_PFunction4;
-  nsstd::unordered_map< TKey, FunctionObjectType, hash<TKey> > m_PFunction3;
-  nsstd::unordered_map< TKey, FunctionObjectType, hash<TKey> > m_PFunction2;
-#else
-  std::map<TKey, FunctionObjectType> m_PFunction4;
-  std::map<TKey, FunctionObjectType> m_PFunction3;
-  std::map<TKey, FunctionObjectType> m_PFunction2;
-#endif
-
-
 };
 
 
@@ -276,14 +291,6 @@ protected:
   typedef typename ::detail::FunctionTraits<MemberFunctionType>::ClassType     ObjectType;
 
 
-  MemberFunctionFactoryBase( void )
-#if defined SITK_HAS_UNORDERED_MAP
-    :  m_PFunction4( typelist::Length<InstantiatedPixelIDTypeList>::Result ),
-       m_PFunction3( typelist::Length<InstantiatedPixelIDTypeList>::Result ),
-       m_PFunction2( typelist::Length<InstantiatedPixelIDTypeList>::Result )
-#endif
-    { }
-
 public:
 
   /**  the pointer MemberFunctionType redefined ad a tr1::function
@@ -310,18 +317,6 @@ protected:
       return nsstd::bind( pfunc, objectPointer, _1, _2, _3 );
     }
 
-
-  // maps of Keys to pointers to member functions
-#if defined SITK_HAS_UNORDERED_MAP
-  nsstd::unordered_map< TKey, FunctionObjectType, hash<TKey> > m_PFunction4;
-  nsstd::unordered_map< TKey, FunctionObjectType, hash<TKey> > m_PFunction3;
-  nsstd::unordered_map< TKey, FunctionObjectType, hash<TKey> > m_PFunction2;
-#else
-  std::map<TKey, FunctionObjectType> m_PFunction4;
-  std::map<TKey, FunctionObjectType> m_PFunction3;
-  std::map<TKey, FunctionObjectType> m_PFunction2;
-#endif
-
 };
 
 
@@ -340,14 +335,6 @@ protected:
   typedef typename ::detail::FunctionTraits<MemberFunctionType>::ClassType     ObjectType;
 
 
-  MemberFunctionFactoryBase( void )
-#if defined SITK_HAS_UNORDERED_MAP
-    :  m_PFunction4( typelist::Length<InstantiatedPixelIDTypeList>::Result ),
-       m_PFunction3( typelist::Length<InstantiatedPixelIDTypeList>::Result ),
-       m_PFunction2( typelist::Length<InstantiatedPixelIDTypeList>::Result )
-#endif
-    { }
-
 public:
 
   /**  the pointer MemberFunctionType redefined ad a tr1::function
@@ -374,18 +361,6 @@ protected:
       return nsstd::bind( pfunc, objectPointer, _1, _2, _3, _4 );
     }
 
-
-  // maps of Keys to pointers to member functions
-#if defined SITK_HAS_UNORDERED_MAP
-  nsstd::unordered_map< TKey, FunctionObjectType, hash<TKey> > m_PFunction4;
-  nsstd::unordered_map< TKey, FunctionObjectType, hash<TKey> > m_PFunction3;
-  nsstd::unordered_map< TKey, FunctionObjectType, hash<TKey> > m_PFunction2;
-#else
-  std::map<TKey, FunctionObjectType> m_PFunction4;
-  std::map<TKey, FunctionObjectType> m_PFunction3;
-  std::map<TKey, FunctionObjectType> m_PFunction2;
-#endif
-
 };
 
 template< typename TMemberFunctionPointer, typename TKey>
@@ -404,14 +379,6 @@ protected:
   typedef typename ::detail::FunctionTraits<MemberFunctionType>::ClassType     ObjectType;
 
 
-  MemberFunctionFactoryBase( void )
-#if defined SITK_HAS_UNORDERED_MAP
-    :  m_PFunction4( typelist::Length<InstantiatedPixelIDTypeList>::Result ),
-       m_PFunction3( typelist::Length<InstantiatedPixelIDTypeList>::Result ),
-       m_PFunction2( typelist::Length<InstantiatedPixelIDTypeList>::Result )
-#endif
-    { }
-
 public:
 
   /**  the pointer MemberFunctionType redefined ad a tr1::function
@@ -438,18 +405,6 @@ protected:
       return nsstd::bind( pfunc, objectPointer, _1, _2, _3, _4, _5 );
     }
 
-
-  // maps of Keys to pointers to member functions
-#if defined SITK_HAS_UNORDERED_MAP
-  nsstd::unordered_map< TKey, FunctionObjectType, hash<TKey> > m_PFunction4;
-  nsstd::unordered_map< TKey, FunctionObjectType, hash<TKey> > m_PFunction3;
-  nsstd::unordered_map< TKey, FunctionObjectType, hash<TKey> > m_PFunction2;
-#else
-  std::map<TKey, FunctionObjectType> m_PFunction4;
-  std::map<TKey, FunctionObjectType> m_PFunction3;
-  std::map<TKey, FunctionObjectType> m_PFunction2;
-#endif
-
 };
 
 } // end namespace detail
@@ -0,0 +1,159 @@
+/*=========================================================================
+*
+*  Copyright Insight Software Consortium
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*         http://www.apache.org/licenses/LICENSE-2.0.txt
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*=========================================================================*/
+#ifndef sitkPipeline_h
+#define sitkPipeline_h
+
+#include "sitkMacro.h"
+#include "sitkMemberFunctionFactory.h"
+#include "sitkImage.h"
+#include "sitkProcessObject.h"
+
+#include <vector>
+
+namespace itk {
+  namespace simple {
+
+    /** \class Pipeline
+     * \brief Chain filters into a single ITK pipeline, updated once.
+     *
+     * Each SimpleITK filter normally runs its ITK filter to
+     * completion, so a chain of filters allocates every intermediate
+     * image in full. While a Pipeline is recording, the update of the
+     * ITK filters is deferred: the images returned by the filters
+     * are connected to the ITK filters which produce them, and the
+     * ITK filters are kept by the pipeline. Calling Execute with the
+     * last image runs the whole chain with a single Update, optionally
+     * split into the number of stream divisions or by the maximum
+     * memory of the Pipeline, so that only a piece of each
+     * intermediate image is in memory at once.
+     *
+     * \code
+     * Pipeline pipeline;
+     * pipeline.SetNumberOfStreamDivisions( 8 );
+     * pipeline.StartRecording();
+     * Image img = SmoothingRecursiveGaussian( input, 2.0 );
+     * img = Abs( img );
+     * img = pipeline.Execute( Sqrt( img ) );
+     * \endcode
+     *
+     * The images returned while recording are placeholders without a
+     * buffer, to be used as the input of other filters or passed to
+     * Execute. Accessing the pixels of a placeholder before the
+     * Pipeline is executed updates the recorded filters it depends
+     * on at once. Once the Pipeline has been executed or cleared,
+     * the placeholders not accessed before can not be computed
+     * anymore, and accessing their pixels throws an exception. Filters
+     * which compute measurements, produce a label map or an image with
+     * a non-zero starting index are updated immediately as usual. The
+     * commands added to a filter are not invoked for a deferred
+     * update, commands added to the Pipeline are.
+     *
+     * Only one Pipeline can record at a time. Only the filters
+     * executed by the thread which started the recording are
+     * deferred, filters executed concurrently by other threads are
+     * updated immediately.
+     */
+    class SITKCommon_EXPORT Pipeline
+      : public ProcessObject
+    {
+    public:
+      typedef Pipeline Self;
+
+      // function pointer type
+      typedef Image (Self::*MemberFunctionType)( const Image& );
+
+      // this filter works with all itk::Image and itk::VectorImage types.
+      typedef typelist::Append<
+        typelist::Append< BasicPixelIDTypeList, ComplexPixelIDTypeList>::Type,
+        VectorPixelIDTypeList >::Type PixelIDTypeList;
+
+      Pipeline();
+
+      /** Stop recording and release all filters not executed. */
+      virtual ~Pipeline();
+
+      /** Name of this class */
+      std::string GetName() const { return std::string ( "Pipeline"); }
+
+      // Print ourselves out
+      std::string ToString() const;
+
+      /** The number of pieces and the maximum bytes of the output
+       * computed at once by Execute.
+       * \sa ProcessObject::SetNumberOfStreamDivisions
+       * \sa ProcessObject::SetMaximumMemory
+       * @{ */
+      SITK_RETURN_SELF_TYPE_HEADER SetNumberOfStreamDivisions( unsigned int n )
+        {
+          ProcessObject::SetNumberOfStreamDivisions( n );
+          return *this;
+        }
+      SITK_RETURN_SELF_TYPE_HEADER SetMaximumMemory( uint64_t bytes )
+        {
+          ProcessObject::SetMaximumMemory( bytes );
+          return *this;
+        }
+      /** @} */
+
+      /** Begin deferring the update of the filters executed by the
+       * calling thread. An exception is thrown if another Pipeline,
+       * or this Pipeline on another thread, is already recording. */
+      void StartRecording();
+
+      /** Stop deferring updates, the recorded filters are kept until
+       * Execute or Clear is called. */
+      void StopRecording();
+
+      bool IsRecording() const;
+
+      /** The number of ITK filters whose update was deferred. */
+      unsigned int GetNumberOfRecordedFilters() const;
+
+      /** Release the recorded filters without executing them. */
+      void Clear();
+
+      /** Stop recording, and compute the image by updating the
+       * recorded filters which it depends on. The recorded filters are
+       * released afterwards. */
+      Image Execute( const Image &image );
+
+    private:
+
+      template <class TImageType> Image ExecuteInternal ( const Image& image );
+
+      // friend to get access to executeInternal member
+      friend struct detail::MemberFunctionAddressor<MemberFunctionType>;
+
+      // ProcessObject hands over the ITK filters while recording
+      friend class ProcessObject;
+
+      // TaskGraph checks no pipeline is recording
+      friend class TaskGraph;
+
+      /** The Pipeline recording on the calling thread, or NULL. */
+      static Pipeline *GetRecordingPipeline();
+      void AddProcess( itk::ProcessObject *p );
+
+      std::vector<itk::ProcessObject *> m_Processes;
+
+      nsstd::auto_ptr<detail::MemberFunctionFactory<MemberFunctionType> > m_MemberFactory;
+    };
+
+  }
+}
+#endif
@@ -32,6 +32,9 @@ namespace itk {
 #ifndef SWIG
 
   template< typename T, unsigned int NVectorDimension > class Vector;
+  template< typename TLabelObject > class LabelMap;
+  template< typename TInputImage, typename TOutputImage > class StreamingImageFilter;
+  template< typename T > class NumericTraits;
 
   class ProcessObject;
   class Command;
@@ -150,6 +153,44 @@ namespace itk {
       virtual unsigned int GetNumberOfThreads() const;
       /**@}*/
 
+      /** \brief Compute the output image in pieces to bound memory.
+       *
+       * When the number of stream divisions is greater than 1, the
+       * output of the ITK filter is computed one piece after another
+       * with an itk::StreamingImageFilter, and the pieces are
+       * assembled into the returned image. The filter then only
+       * holds the buffers needed for one piece, in addition to the
+       * inputs and the output. Filters which can not stream compute
+       * their whole output once, producing the same result. The
+       * commands observe the whole streamed update, so the start, end
+       * and progress events occur once, and Abort stops after the
+       * current piece.
+       *
+       * Objects which do not compute an output image in pieces, such
+       * as ImageRegistrationMethod, ImportImageFilter and the image
+       * series reader and writer, throw an exception from Execute
+       * when streaming is requested.
+       *
+       * The default of 1 computes the whole output at once.
+       * @{
+       */
+      SITK_RETURN_SELF_TYPE_HEADER SetNumberOfStreamDivisions(unsigned int n);
+      unsigned int GetNumberOfStreamDivisions() const;
+      /**@}*/
+
+      /** \brief Limit the bytes of output computed at once.
+       *
+       * If not 0, the number of stream divisions is increased so
+       * that each piece of the output is at most this many bytes. The
+       * memory used by the ITK filter to compute a piece is
+       * approximately proportional to the size of the piece. The
+       * default of 0 imposes no limit.
+       * @{
+       */
+      SITK_RETURN_SELF_TYPE_HEADER SetMaximumMemory(uint64_t bytes);
+      uint64_t GetMaximumMemory() const;
+      /**@}*/
+
       /** \brief Add a Command Object to observer the event.
        *
        * The Command object's Execute method will be invoked when the
@@ -217,6 +258,28 @@ namespace itk {
        */
       virtual void Abort();
 
+      /** \brief Measurements of the last execution.
+       *
+       * The wall and processor time in seconds spent updating the ITK
+       * filter, the number of threads it was run with, the bytes of
+       * the output image and the increase of the peak resident memory
+       * of the process in bytes. The processor time is the process
+       * CPU time of all threads, including the ITK worker threads and
+       * any other thread running concurrently, not a per thread
+       * measure. When the output is computed in pieces, the times of
+       * all pieces are summed.
+       *
+       * These measurements are recorded by every Execute, the
+       * ExecutionProfiler optionally accumulates them per filter name.
+       * @{
+       */
+      virtual double GetExecutionWallTime() const;
+      virtual double GetExecutionCPUTime() const;
+      virtual unsigned int GetExecutionNumberOfThreads() const;
+      virtual uint64_t GetExecutionOutputBytes() const;
+      virtual uint64_t GetExecutionPeakResidentMemoryDelta() const;
+      /**@}*/
+
     protected:
 
       #ifndef SWIG
@@ -242,6 +305,69 @@ namespace itk {
       // connect commands.
       virtual void PreUpdate( itk::ProcessObject *p );
 
+      // Return the threads acquired from the ThreadPool by PreUpdate.
+      void ReleaseAcquiredThreads();
+
+      // Releases the threads acquired by PreUpdate when the execution
+      // returns or throws, as the ITK filter may be kept afterwards
+      // for its measurements.
+      class AcquiredThreadsReleaser
+      {
+      public:
+        explicit AcquiredThreadsReleaser( ProcessObject *p ) : m_ProcessObject(p) {}
+        ~AcquiredThreadsReleaser() { m_ProcessObject->ReleaseAcquiredThreads(); }
+      private:
+        AcquiredThreadsReleaser( const AcquiredThreadsReleaser & ); // purposely not implemented
+        void operator=( const AcquiredThreadsReleaser & ); // purposely not implemented
+        ProcessObject *m_ProcessObject;
+      };
+      friend class AcquiredThreadsReleaser;
+
+      // Returns true if a Pipeline is currently recording filters.
+      static bool IsPipelineRecording();
+
+      // Returns true if the output of the filter may be computed in
+      // pieces, by stream divisions or a recording Pipeline. An input
+      // without a source can not be reused in-place then.
+      bool IsStreamed() const;
+
+      // Throws an exception when stream divisions or a maximum memory
+      // are set, for the objects which can not compute their output
+      // in pieces.
+      void CheckStreamingNotRequested() const;
+
+      // The number of stream divisions to compute an output of the
+      // number of pixels and bytes per pixel.
+      unsigned int ComputeNumberOfStreamDivisions( uint64_t numberOfPixels, unsigned int pixelSize ) const;
+
+      // Hand the ITK filter p over to the recording Pipeline, or to
+      // this object while collecting updates. The commands of this
+      // object are removed from p, as this object may be deleted
+      // before the pipeline is executed.
+      virtual void RetainInPipeline( itk::ProcessObject *p );
+
+      // While collecting updates, the update of the ITK filters is
+      // deferred as by a recording Pipeline, and the filters are
+      // retained by this object, so that the outputs of several
+      // executions can be updated concurrently afterwards. The
+      // commands observe a single process for the collection and the
+      // update, and the start event is invoked.
+      void StartCollectingUpdates();
+
+      typedef void (*CollectedUpdateFunctionType)( unsigned int index, void *data );
+
+      // Stop collecting updates, and call function for each index
+      // below n on up to the number of threads of this object. The
+      // threads are divided among the collected ITK filters, and the
+      // execution is measured as a whole. The progress is the fraction
+      // of the indexes updated, and no index is started once the
+      // execution is aborted. An exception is thrown with the first
+      // error of function. The collected filters are released.
+      void UpdateCollected( unsigned int n, CollectedUpdateFunctionType function, void *data );
+
+      // Stop collecting updates, and release the collected filters.
+      void ReleaseCollected();
+
       // overridable method to add a command, the return value is
       // placed in the m_ITKTag of the EventCommand object.
       virtual unsigned long AddITKObserver(const itk::EventObject &, itk::Command *);
@@ -259,6 +385,19 @@ namespace itk {
       // overidable callback when the active process has completed
       virtual void OnActiveProcessDelete( );
 
+      // callbacks on the start and end events of the active process
+      // to measure the execution.
+      virtual void OnActiveProcessStart( );
+      virtual void OnActiveProcessEnd( );
+
+      // Record the bytes of the output image of the execution.
+      void RecordOutputBytes( uint64_t bytes );
+
+      // Move the commands of this object to observe p instead of the
+      // active process, which becomes p. Returns the previous active
+      // process.
+      itk::ProcessObject *SwapActiveProcess( itk::ProcessObject *p );
+
       friend class itk::simple::Command;
       // method call by command when it's deleted, maintains internal
       // references between command and process objects.
@@ -285,6 +424,177 @@ namespace itk {
         return Image(img);
       }
 
+      // When a Pipeline is recording, or this object collects
+      // updates, the update of the ITK filter p is deferred. The output img is prepared to be wrapped as an
+      // Image, which is connected to the filter, and the filter is
+      // retained by the pipeline. Accessing the pixels of the Image
+      // updates the filter through the source of img. Returns false
+      // and does nothing, if the filter must be updated now.
+      template< class TImageType >
+        bool DeferUpdate( itk::ProcessObject *p, TImageType *img )
+      {
+        if ( !this->m_CollectingUpdates && !Self::IsPipelineRecording() )
+          {
+          return false;
+          }
+
+        p->UpdateOutputInformation();
+
+        typename TImageType::RegionType r = img->GetLargestPossibleRegion();
+        for( unsigned int i = 0; i < TImageType::ImageDimension; ++i )
+          {
+          if ( r.GetIndex()[i] != 0 )
+            {
+            return false;
+            }
+          }
+
+        // The buffer is allocated when the pipeline is executed, and
+        // released once the down stream filters have used it.
+        img->SetBufferedRegion( r );
+        img->ReleaseDataFlagOn();
+
+        this->RetainInPipeline( p );
+        return true;
+      }
+
+      // Update the ITK filter p which produces img. When streaming is
+      // requested, the output is computed in pieces and the assembled
+      // image, disconnected from p, is returned. The commands observe
+      // the streamer during its update, so that their events occur
+      // once for the whole output.
+      template< class TImageType >
+        typename TImageType::Pointer UpdateOutput( itk::ProcessObject *p, TImageType *img )
+      {
+        typedef typename itk::NumericTraits<typename TImageType::PixelType>::ValueType ValueType;
+        typename TImageType::Pointer out = img;
+
+        unsigned int divisions = 1;
+        if ( this->m_NumberOfStreamDivisions > 1 || this->m_MaximumMemory != 0 )
+          {
+          p->UpdateOutputInformation();
+          divisions = this->ComputeNumberOfStreamDivisions( img->GetLargestPossibleRegion().GetNumberOfPixels(),
+                                                            img->GetNumberOfComponentsPerPixel() * sizeof( ValueType ) );
+          }
+
+        if ( divisions <= 1 )
+          {
+          p->Update();
+          }
+        else
+          {
+          typedef itk::StreamingImageFilter<TImageType, TImageType> StreamerType;
+          typename StreamerType::Pointer streamer = StreamerType::New();
+          streamer->SetInput( img );
+          streamer->SetNumberOfStreamDivisions( divisions );
+
+          // the piece of the output of p is freed after being copied
+          img->ReleaseDataFlagOn();
+
+          itk::ProcessObject *active = this->SwapActiveProcess( streamer );
+          try
+            {
+            streamer->Update();
+            }
+          catch (...)
+            {
+            this->SwapActiveProcess( active );
+            throw;
+            }
+          this->SwapActiveProcess( active );
+
+          out = streamer->GetOutput();
+          out->DisconnectPipeline();
+          }
+
+        this->RecordOutputBytes( static_cast<uint64_t>( out->GetBufferedRegion().GetNumberOfPixels() )
+                                 * out->GetNumberOfComponentsPerPixel() * sizeof( ValueType ) );
+        return out;
+      }
+
+      // Copy the scalar image into a component of the interleaved
+      // buffer of a VectorImage with the same buffered region.
+      template< class TImageType, class TVectorImageType >
+        static void CopyToVectorImageComponent( const TImageType *img, unsigned int component, TVectorImageType *vectorImage )
+      {
+        if ( img->GetBufferedRegion() != vectorImage->GetBufferedRegion() )
+          {
+          sitkExceptionMacro( "The component image and the vector image have different regions!" );
+          }
+
+        const unsigned int numberOfComponents = vectorImage->GetNumberOfComponentsPerPixel();
+        const size_t numberOfPixels = img->GetBufferedRegion().GetNumberOfPixels();
+        const typename TImageType::PixelType *in = img->GetBufferPointer();
+        typename TVectorImageType::InternalPixelType *out = vectorImage->GetBufferPointer() + component;
+
+        for ( size_t i = 0; i < numberOfPixels; ++i, out += numberOfComponents )
+          {
+          *out = in[i];
+          }
+      }
+
+      // The filtered components of a VectorImage, with the output
+      // they are written into.
+      template< class TImageType, class TVectorImageType >
+        struct VectorImageComponents
+      {
+        std::vector<TImageType *> m_Components;
+        TVectorImageType         *m_Output;
+      };
+
+      // A CollectedUpdateFunctionType updating the component of a
+      // VectorImageComponents, writing it into the output and
+      // releasing its buffer. Components already written are NULL.
+      template< class TImageType, class TVectorImageType >
+        static void UpdateVectorImageComponent( unsigned int component, void *data )
+      {
+        VectorImageComponents<TImageType, TVectorImageType> *components =
+          static_cast< VectorImageComponents<TImageType, TVectorImageType> * >( data );
+
+        TImageType *img = components->m_Components[component];
+        if ( !img )
+          {
+          return;
+          }
+        if ( img->GetSource() )
+          {
+          img->Update();
+          }
+        CopyToVectorImageComponent( img, component, components->m_Output );
+        img->ReleaseData();
+      }
+
+      // Simple ITK must use a zero based index
+      template< class TImageType>
+      static void FixNonZeroIndex( TImageType * img )
+      {
+        assert( img != NULL );
+
+        typename TImageType::RegionType r = img->GetLargestPossibleRegion();
+        typename TImageType::IndexType idx = r.GetIndex();
+
+        for( unsigned int i = 0; i < TImageType::ImageDimension; ++i )
+          {
+
+          if ( idx[i] != 0 )
+            {
+            // if any of the indcies are non-zero, then just fix it
+            typename TImageType::PointType o;
+            img->TransformIndexToPhysicalPoint( idx, o );
+            img->SetOrigin( o );
+
+            idx.Fill( 0 );
+            r.SetIndex( idx );
+
+            // Need to set the buffered region to match largest
+            img->SetRegions( r );
+
+            return;
+            }
+          }
+
+      }
+
 #ifndef SWIG
       template< class TPixelType, unsigned int VImageDimension, unsigned int  VLength,
                 template<typename, unsigned int> class TVector >
@@ -310,6 +620,28 @@ namespace itk {
 
         return Image(out.GetPointer());
       }
+
+      // The images of vectors are converted, and label maps are not
+      // streamed, so their update is never deferred.
+      template< class TPixelType, unsigned int VImageDimension, unsigned int  VLength,
+                template<typename, unsigned int> class TVector >
+        bool DeferUpdate( itk::ProcessObject *, itk::Image< TVector< TPixelType, VLength >, VImageDimension> * )
+      {
+        return false;
+      }
+
+      template< class TLabelObject >
+        bool DeferUpdate( itk::ProcessObject *, itk::LabelMap< TLabelObject > * )
+      {
+        return false;
+      }
+
+      template< class TLabelObject >
+        typename itk::LabelMap< TLabelObject >::Pointer UpdateOutput( itk::ProcessObject *p, itk::LabelMap< TLabelObject > *img )
+      {
+        p->Update();
+        return img;
+      }
 #endif
 
       /**
@@ -347,10 +679,35 @@ namespace itk {
       bool m_Debug;
       unsigned int m_NumberOfThreads;
 
+      unsigned int m_NumberOfStreamDivisions;
+      uint64_t m_MaximumMemory;
+
+      // measurements of the last execution
+      double m_ExecutionWallTime;
+      double m_ExecutionCPUTime;
+      unsigned int m_ExecutionNumberOfThreads;
+      uint64_t m_ExecutionOutputBytes;
+      uint64_t m_ExecutionPeakResidentMemoryDelta;
+      bool m_ExecutionProfiled;
+
+      // clocks at the start event, and peak memory before execution
+      double m_StartWallTime;
+      double m_StartCPUTime;
+      uint64_t m_StartPeakResidentMemory;
+
+      // threads reserved from the pool for the active process
+      unsigned int m_NumberOfAcquiredThreads;
+
       std::list<EventCommand> m_Commands;
 
       itk::ProcessObject *m_ActiveProcess;
 
+      // the ITK filters whose update is deferred while collecting,
+      // and the process observed by the commands meanwhile
+      bool m_CollectingUpdates;
+      std::vector<itk::ProcessObject *> m_CollectedProcesses;
+      itk::ProcessObject *m_CollectedUpdateProcess;
+
       //
       float m_ProgressMeasurement;
     };
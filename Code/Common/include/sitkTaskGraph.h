@@ -0,0 +1,257 @@
+/*=========================================================================
+*
+*  Copyright Insight Software Consortium
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*         http://www.apache.org/licenses/LICENSE-2.0.txt
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*=========================================================================*/
+#ifndef sitkTaskGraph_h
+#define sitkTaskGraph_h
+
+#include "sitkCommon.h"
+#include "sitkImage.h"
+#include "sitkProcessObject.h"
+#include "sitkNonCopyable.h"
+#include "nsstd/functional.h"
+
+#include <string>
+#include <vector>
+
+namespace itk
+{
+
+namespace simple
+{
+
+  class TaskGraph;
+
+  /** \class ImageFuture
+   * \brief The image a task of a TaskGraph will produce.
+   *
+   * A future refers to a task of the graph which created it, and is
+   * only valid while the graph exists.
+   */
+  class SITKCommon_EXPORT ImageFuture
+  {
+  public:
+    ImageFuture();
+
+    /** Returns true if the future refers to a task. */
+    bool IsValid() const;
+
+    /** Returns true if the task has executed, successfully or not. */
+    bool IsReady() const;
+
+    /** The image produced by the task. The graph is executed if the
+     * task has not executed yet. If the task, or a task it depends
+     * on, failed an exception is thrown with the error of the task.
+     * Called from a task of the executing graph, an exception is
+     * thrown if the task has not executed yet instead of waiting. */
+    Image Get() const;
+
+  private:
+    friend class TaskGraph;
+    ImageFuture( TaskGraph *graph, unsigned int task );
+
+    TaskGraph   *m_Graph;
+    unsigned int m_Task;
+  };
+
+
+#ifndef SWIG
+  namespace detail
+  {
+  // Execute a filter on the images of the dependencies of a task.
+  template <class TFilter>
+  struct ExecuteFilterTask1
+  {
+    ExecuteFilterTask1( TFilter &filter ) : m_Filter( &filter ) {}
+    Image operator()( const std::vector<Image> &inputs ) const
+      { return m_Filter->Execute( inputs[0] ); }
+    TFilter *m_Filter;
+  };
+
+  template <class TFilter>
+  struct ExecuteFilterTask2
+  {
+    ExecuteFilterTask2( TFilter &filter ) : m_Filter( &filter ) {}
+    Image operator()( const std::vector<Image> &inputs ) const
+      { return m_Filter->Execute( inputs[0], inputs[1] ); }
+    TFilter *m_Filter;
+  };
+
+  template <class TFilter>
+  struct ExecuteFilterTask3
+  {
+    ExecuteFilterTask3( TFilter &filter ) : m_Filter( &filter ) {}
+    Image operator()( const std::vector<Image> &inputs ) const
+      { return m_Filter->Execute( inputs[0], inputs[1], inputs[2] ); }
+    TFilter *m_Filter;
+  };
+  }
+#endif
+
+  /** \class TaskGraph
+   * \brief Execute independent filters concurrently.
+   *
+   * Filter executions are submitted with the futures of the images
+   * they depend on, and return the future of their output image. When
+   * the graph is executed, the tasks whose dependencies are complete
+   * are run in parallel, so independent branches of a computation
+   * proceed concurrently:
+   *
+   * \code
+   * TaskGraph graph;
+   * ImageFuture input = graph.AddImage( image );
+   * ImageFuture gradient = graph.Submit( gradientMagnitudeFilter, input );
+   * ImageFuture mask = graph.Submit( otsuFilter, input );
+   * ImageFuture masked = graph.Submit( maskFilter, gradient, mask );
+   * graph.Execute();
+   * Image result = masked.Get();
+   * \endcode
+   *
+   * At most GetNumberOfThreads tasks execute at the same time, with
+   * ThreadPool::ShareThreadsOn the threads of the filters executing
+   * concurrently are also limited to the threads of the pool.
+   *
+   * Each task is given its own copies of its input images, which share
+   * the pixel buffers but not the ITK image objects, so that
+   * concurrent filters reading the same image do not interfere
+   * through the pipeline state of the image. Process objects are not
+   * thread safe, tasks of the same filter object are not executed at
+   * the same time. Submitted filter objects must exist until the graph
+   * is executed, and must not be used otherwise meanwhile. Tasks and
+   * images can not be added while the graph is executing.
+   *
+   * The TaskGraph is only available in C++, tasks are submitted with
+   * the filter types as template parameters.
+   */
+  class SITKCommon_EXPORT TaskGraph
+    : protected NonCopyable
+  {
+  public:
+    typedef TaskGraph Self;
+
+    TaskGraph();
+    virtual ~TaskGraph();
+
+    /** Name of this class */
+    std::string GetName() const { return std::string ( "TaskGraph"); }
+
+    // Print ourselves out
+    std::string ToString() const;
+
+    /** The maximum number of tasks executed at the same time. The
+     * default is 0, for the number of threads of the ThreadPool or
+     * else the global default number of threads of process objects.
+     * @{
+     */
+    void SetNumberOfThreads( unsigned int n );
+    unsigned int GetNumberOfThreads() const;
+    /**@}*/
+
+    /** Add an image available to the tasks. */
+    ImageFuture AddImage( const Image &image );
+
+#ifndef SWIG
+    typedef nsstd::function<Image ( const std::vector<Image> & )> TaskFunction;
+
+    /** Submit the execution of a filter on the images of the futures.
+     * The filter's Execute method with the same number of images is
+     * called.
+     * @{
+     */
+    template <class TFilter>
+    ImageFuture Submit( TFilter &filter, const ImageFuture &input )
+      {
+        std::vector<ImageFuture> dependencies( 1, input );
+        return this->Submit( filter, TaskFunction( detail::ExecuteFilterTask1<TFilter>( filter ) ), dependencies );
+      }
+    template <class TFilter>
+    ImageFuture Submit( TFilter &filter, const ImageFuture &input1, const ImageFuture &input2 )
+      {
+        std::vector<ImageFuture> dependencies( 1, input1 );
+        dependencies.push_back( input2 );
+        return this->Submit( filter, TaskFunction( detail::ExecuteFilterTask2<TFilter>( filter ) ), dependencies );
+      }
+    template <class TFilter>
+    ImageFuture Submit( TFilter &filter, const ImageFuture &input1, const ImageFuture &input2, const ImageFuture &input3 )
+      {
+        std::vector<ImageFuture> dependencies( 1, input1 );
+        dependencies.push_back( input2 );
+        dependencies.push_back( input3 );
+        return this->Submit( filter, TaskFunction( detail::ExecuteFilterTask3<TFilter>( filter ) ), dependencies );
+      }
+    /**@}*/
+
+    /** Submit a function computing an image from the images of the
+     * dependencies, with the filter it executes. */
+    ImageFuture Submit( ProcessObject &filter,
+                        const TaskFunction &function,
+                        const std::vector<ImageFuture> &dependencies );
+#endif
+
+    /** The number of tasks, including added images. */
+    unsigned int GetNumberOfTasks() const;
+
+    /** Execute all tasks not executed yet, returning when they are
+     * complete. Failures of tasks are reported by their futures. An
+     * exception is thrown if a Pipeline is recording. */
+    void Execute();
+
+    /** Remove all tasks, invalidating their futures. */
+    void Clear();
+
+  private:
+    friend class ImageFuture;
+
+    enum TaskState { Pending, Running, Succeeded, Failed };
+
+    struct Task
+    {
+      Task() : m_Filter( NULL ), m_State( Pending ) {}
+
+      ProcessObject            *m_Filter;
+      TaskFunction              m_Function;
+      std::vector<unsigned int> m_Dependencies;
+      TaskState                 m_State;
+      Image                     m_Image;
+      std::string               m_Error;
+    };
+
+    void CheckFuture( const ImageFuture &future ) const;
+
+    bool IsExecuting() const;
+    void CheckNotExecuting() const;
+
+    // Run tasks until none is pending, on each thread.
+    friend struct TaskGraphThreader;
+    void ExecuteTasks();
+
+    // Must be called holding the lock. Tasks with a failed
+    // dependency are marked failed. Returns true and the task if a
+    // task is ready to execute.
+    bool FindReadyTask( unsigned int &task );
+
+    std::vector<Task> m_Tasks;
+    unsigned int      m_NumberOfThreads;
+
+    // synchronization of the threads executing the tasks
+    struct Synchronization;
+    Synchronization  *m_Synchronization;
+  };
+
+}
+}
+
+#endif
@@ -0,0 +1,119 @@
+/*=========================================================================
+*
+*  Copyright Insight Software Consortium
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*         http://www.apache.org/licenses/LICENSE-2.0.txt
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*=========================================================================*/
+#ifndef sitkThreadPool_h
+#define sitkThreadPool_h
+
+#include "sitkCommon.h"
+
+#include <vector>
+
+namespace itk
+{
+
+namespace simple
+{
+
+  /** \class ThreadPool
+   * \brief Controls of the threads shared by all SimpleITK filters.
+   *
+   * By default each ITK filter creates and joins its threads on every
+   * update. When the pool is enabled the multi-threaders of all
+   * filters, readers, writers and the registration method instead
+   * hand their work to ITK's process wide pool of persistent
+   * threads, which removes the cost of creating threads when many
+   * small images are processed.
+   *
+   * The number of threads of the pool bounds the threads used by the
+   * filters executing at the same time. When sharing is enabled, a
+   * filter starting while others execute is given at most the threads
+   * of the pool not in use, and at least one, instead of its own
+   * number of threads, so that independent filters executing
+   * concurrently from several threads do not oversubscribe the
+   * processors:
+   *
+   * \code
+   * ThreadPool::Enable();
+   * ThreadPool::SetNumberOfThreads( 8 );
+   * ThreadPool::ShareThreadsOn();
+   * \endcode
+   *
+   * The pool is disabled, and threads are not shared, by default.
+   */
+  class SITKCommon_EXPORT ThreadPool
+  {
+  public:
+
+    /** Use the persistent pool for the threads of ITK filters
+     * created afterwards.
+     * @{
+     */
+    static void Enable();
+    static void Disable();
+    static void SetEnabled( bool flag );
+    static bool IsEnabled();
+    /**@}*/
+
+    /** The number of threads of the pool. When the pool is enabled,
+     * the threads are started by this method. The default is 0, for
+     * the global default number of threads of process objects.
+     * @{
+     */
+    static void SetNumberOfThreads( unsigned int n );
+    static unsigned int GetNumberOfThreads();
+    /**@}*/
+
+    /** Limit the threads of filters executing concurrently to the
+     * number of threads of the pool.
+     * @{
+     */
+    static void SetShareThreads( bool flag );
+    static bool GetShareThreads();
+    static void ShareThreadsOn() { SetShareThreads( true ); }
+    static void ShareThreadsOff() { SetShareThreads( false ); }
+    /**@}*/
+
+    /** The number of threads given to the filters currently
+     * executing. */
+    static unsigned int GetNumberOfThreadsInUse();
+
+    /** Pin the threads of the pool to the given processors. Threads
+     * inherit the affinity of the thread creating them, so this must
+     * be called from the main thread before the threads of the pool
+     * are started, and also applies to the calling thread. Returns
+     * false if the affinity can not be set, which is always the case
+     * on platforms other than Linux. An empty list removes the
+     * restriction.
+     * @{
+     */
+    static bool SetProcessorAffinity( const std::vector<unsigned int> &processors );
+    static std::vector<unsigned int> GetProcessorAffinity();
+    /**@}*/
+
+#ifndef SWIG
+    // Reserve threads for the execution of a filter requesting the
+    // number of threads, returns the number of threads to use. Done
+    // by ProcessObject.
+    static unsigned int AcquireThreads( unsigned int requested );
+    static void ReleaseThreads( unsigned int n );
+#endif
+  };
+
+}
+}
+
+#endif
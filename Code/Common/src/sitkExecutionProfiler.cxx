@@ -0,0 +1,318 @@
+/*=========================================================================
+*
+*  Copyright Insight Software Consortium
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*         http://www.apache.org/licenses/LICENSE-2.0.txt
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*=========================================================================*/
+#include "sitkExecutionProfiler.h"
+#include "sitkMacro.h"
+
+#include "itkRealTimeClock.h"
+#include "itkSimpleFastMutexLock.h"
+#include "itkMutexLockHolder.h"
+
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#elif defined(_WIN32)
+#include "itkWindows.h"
+#endif
+
+namespace itk
+{
+namespace simple
+{
+
+namespace
+{
+
+struct Profile
+{
+  Profile()
+    : m_NumberOfExecutions(0),
+      m_WallTime(0.0),
+      m_CPUTime(0.0),
+      m_NumberOfThreads(0),
+      m_OutputBytes(0),
+      m_PeakResidentMemoryDelta(0)
+    {}
+
+  unsigned int m_NumberOfExecutions;
+  double       m_WallTime;
+  double       m_CPUTime;
+  unsigned int m_NumberOfThreads;
+  uint64_t     m_OutputBytes;
+  uint64_t     m_PeakResidentMemoryDelta;
+};
+
+typedef itk::MutexLockHolder<itk::SimpleFastMutexLock> LockHolder;
+
+// the enabled flag is read by concurrently executing filters
+static itk::SimpleFastMutexLock EnabledLock;
+static bool GlobalProfilerEnabled = false;
+
+static itk::SimpleFastMutexLock ProfilesLock;
+
+// profiles by name, and the names in order of first execution
+static std::map<std::string, Profile> Profiles;
+static std::vector<std::string> ProfileNames;
+
+// Must be called holding the lock.
+Profile &GetProfile( const std::string &name )
+{
+  std::map<std::string, Profile>::iterator i = Profiles.find( name );
+  if ( i == Profiles.end() )
+    {
+    ProfileNames.push_back( name );
+    i = Profiles.insert( std::make_pair( name, Profile() ) ).first;
+    }
+  return i->second;
+}
+
+Profile FindProfile( const std::string &name )
+{
+  LockHolder lock( ProfilesLock );
+  std::map<std::string, Profile>::const_iterator i = Profiles.find( name );
+  return ( i == Profiles.end() ) ? Profile() : i->second;
+}
+
+// Quote a name as a JSON string, names are expected to be plain
+// identifiers but are escaped for safety.
+std::string JSONQuote( const std::string &s )
+{
+  std::string out = "\"";
+  for ( size_t i = 0; i < s.size(); ++i )
+    {
+    if ( s[i] == '"' || s[i] == '\\' )
+      {
+      out += '\\';
+      }
+    out += s[i];
+    }
+  return out + "\"";
+}
+
+}
+
+
+void ExecutionProfiler::Enable()
+{
+  ExecutionProfiler::SetEnabled( true );
+}
+
+void ExecutionProfiler::Disable()
+{
+  ExecutionProfiler::SetEnabled( false );
+}
+
+void ExecutionProfiler::SetEnabled( bool flag )
+{
+  LockHolder lock( EnabledLock );
+  GlobalProfilerEnabled = flag;
+}
+
+bool ExecutionProfiler::IsEnabled()
+{
+  LockHolder lock( EnabledLock );
+  return GlobalProfilerEnabled;
+}
+
+void ExecutionProfiler::Reset()
+{
+  LockHolder lock( ProfilesLock );
+  Profiles.clear();
+  ProfileNames.clear();
+}
+
+std::vector<std::string> ExecutionProfiler::GetNames()
+{
+  LockHolder lock( ProfilesLock );
+  return ProfileNames;
+}
+
+unsigned int ExecutionProfiler::GetNumberOfExecutions( const std::string &name )
+{
+  return FindProfile( name ).m_NumberOfExecutions;
+}
+
+double ExecutionProfiler::GetWallTime( const std::string &name )
+{
+  return FindProfile( name ).m_WallTime;
+}
+
+double ExecutionProfiler::GetCPUTime( const std::string &name )
+{
+  return FindProfile( name ).m_CPUTime;
+}
+
+uint64_t ExecutionProfiler::GetOutputBytes( const std::string &name )
+{
+  return FindProfile( name ).m_OutputBytes;
+}
+
+std::string ExecutionProfiler::GetReport( ReportFormat format )
+{
+  LockHolder lock( ProfilesLock );
+
+  std::ostringstream out;
+  out.precision( 9 );
+
+  if ( format == CSV )
+    {
+    out << "Name,NumberOfExecutions,WallTime,CPUTime,NumberOfThreads,OutputBytes,PeakResidentMemoryDelta" << std::endl;
+    }
+  else
+    {
+    out << "[";
+    }
+
+  for ( size_t i = 0; i < ProfileNames.size(); ++i )
+    {
+    const Profile &p = Profiles[ProfileNames[i]];
+    if ( format == CSV )
+      {
+      out << ProfileNames[i] << ","
+          << p.m_NumberOfExecutions << ","
+          << p.m_WallTime << ","
+          << p.m_CPUTime << ","
+          << p.m_NumberOfThreads << ","
+          << p.m_OutputBytes << ","
+          << p.m_PeakResidentMemoryDelta << std::endl;
+      }
+    else
+      {
+      out << ( i ? "," : "" ) << std::endl
+          << "  { \"Name\": " << JSONQuote( ProfileNames[i] )
+          << ", \"NumberOfExecutions\": " << p.m_NumberOfExecutions
+          << ", \"WallTime\": " << p.m_WallTime
+          << ", \"CPUTime\": " << p.m_CPUTime
+          << ", \"NumberOfThreads\": " << p.m_NumberOfThreads
+          << ", \"OutputBytes\": " << p.m_OutputBytes
+          << ", \"PeakResidentMemoryDelta\": " << p.m_PeakResidentMemoryDelta
+          << " }";
+      }
+    }
+
+  if ( format == JSON )
+    {
+    out << std::endl << "]" << std::endl;
+    }
+
+  return out.str();
+}
+
+void ExecutionProfiler::WriteReport( const std::string &fileName, ReportFormat format )
+{
+  std::ofstream file( fileName.c_str() );
+  if ( !file )
+    {
+    sitkExceptionMacro( "Unable to open \"" << fileName << "\" for writing!" );
+    }
+  file << ExecutionProfiler::GetReport( format );
+  if ( !file )
+    {
+    sitkExceptionMacro( "Error writing report to \"" << fileName << "\"!" );
+    }
+}
+
+void ExecutionProfiler::AddExecution( const std::string &name )
+{
+  LockHolder lock( ProfilesLock );
+  ++GetProfile( name ).m_NumberOfExecutions;
+}
+
+void ExecutionProfiler::AddTimes( const std::string &name,
+                                  double wallTime,
+                                  double cpuTime,
+                                  unsigned int numberOfThreads,
+                                  uint64_t peakResidentMemoryDelta )
+{
+  LockHolder lock( ProfilesLock );
+  Profile &p = GetProfile( name );
+  p.m_WallTime += wallTime;
+  p.m_CPUTime += cpuTime;
+  p.m_NumberOfThreads = std::max( p.m_NumberOfThreads, numberOfThreads );
+  p.m_PeakResidentMemoryDelta = std::max( p.m_PeakResidentMemoryDelta, peakResidentMemoryDelta );
+}
+
+void ExecutionProfiler::AddOutputBytes( const std::string &name, uint64_t bytes )
+{
+  LockHolder lock( ProfilesLock );
+  GetProfile( name ).m_OutputBytes += bytes;
+}
+
+double ExecutionProfiler::GetCurrentWallTime()
+{
+  static itk::RealTimeClock::Pointer clock = itk::RealTimeClock::New();
+  return clock->GetTimeInSeconds();
+}
+
+double ExecutionProfiler::GetCurrentCPUTime()
+{
+  // The user and system processor time of all threads of the
+  // process. std::clock is not used because it is the wall time on
+  // Windows.
+#if defined(__unix__) || defined(__APPLE__)
+  struct rusage usage;
+  if ( getrusage( RUSAGE_SELF, &usage ) != 0 )
+    {
+    return 0.0;
+    }
+  return static_cast<double>( usage.ru_utime.tv_sec + usage.ru_stime.tv_sec )
+    + 1e-6 * static_cast<double>( usage.ru_utime.tv_usec + usage.ru_stime.tv_usec );
+#elif defined(_WIN32)
+  FILETIME creationTime, exitTime, kernelTime, userTime;
+  if ( !GetProcessTimes( GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime ) )
+    {
+    return 0.0;
+    }
+  ULARGE_INTEGER kernel, user;
+  kernel.LowPart = kernelTime.dwLowDateTime;
+  kernel.HighPart = kernelTime.dwHighDateTime;
+  user.LowPart = userTime.dwLowDateTime;
+  user.HighPart = userTime.dwHighDateTime;
+  // reported in 100 nanosecond units
+  return 1e-7 * static_cast<double>( kernel.QuadPart + user.QuadPart );
+#else
+  return static_cast<double>( std::clock() ) / CLOCKS_PER_SEC;
+#endif
+}
+
+uint64_t ExecutionProfiler::GetCurrentPeakResidentMemory()
+{
+#if defined(__unix__) || defined(__APPLE__)
+  struct rusage usage;
+  if ( getrusage( RUSAGE_SELF, &usage ) != 0 )
+    {
+    return 0;
+    }
+#if defined(__APPLE__)
+  // reported in bytes
+  return static_cast<uint64_t>( usage.ru_maxrss );
+#else
+  // reported in kilobytes
+  return static_cast<uint64_t>( usage.ru_maxrss ) * 1024u;
+#endif
+#else
+  return 0;
+#endif
+}
+
+} // end namespace simple
+} // end namespace itk
@@ -178,7 +178,7 @@ namespace itk
     void Image::SetOrigin( const std::vector<double> &orgn )
     {
        assert( m_PimpleImage );
-      this->MakeUnique();
+      this->MakeUniqueMetaData();
       this->m_PimpleImage->SetOrigin(orgn);
     }
 
@@ -193,7 +193,7 @@ namespace itk
     void Image::SetSpacing( const std::vector<double> &spc )
     {
       assert( m_PimpleImage );
-      this->MakeUnique();
+      this->MakeUniqueMetaData();
       this->m_PimpleImage->SetSpacing(spc);
     }
 
@@ -208,7 +208,7 @@ namespace itk
     void Image::SetDirection( const std::vector< double > &direction )
     {
       assert( m_PimpleImage );
-      this->MakeUnique();
+      this->MakeUniqueMetaData();
       this->m_PimpleImage->SetDirection( direction );
     }
 
@@ -265,7 +265,7 @@ namespace itk
     void Image::SetMetaData( const std::string &key, const std::string &value)
     {
       assert( m_PimpleImage );
-      this->MakeUnique();
+      this->MakeUniqueMetaData();
       itk::MetaDataDictionary &mdd = this->m_PimpleImage->GetDataBase()->GetMetaDataDictionary();
       itk::EncapsulateMetaData<std::string>(mdd, key, value);
     }
@@ -273,8 +273,8 @@ namespace itk
     bool Image::EraseMetaData( const std::string &key )
     {
       assert( m_PimpleImage );
+      this->MakeUniqueMetaData();
       itk::MetaDataDictionary &mdd = this->m_PimpleImage->GetDataBase()->GetMetaDataDictionary();
-      this->MakeUnique();
       return mdd.Erase(key);
     }
 
@@ -721,10 +721,115 @@ namespace itk
       this->m_PimpleImage->SetPixelAsComplexFloat64( idx, v );
     }
 
+    void Image::GetPixelsAsDouble( const uint32_t *indexes, size_t numberOfIndexes, double *values ) const
+    {
+      assert( m_PimpleImage );
+      this->m_PimpleImage->GetPixelsAsDouble( indexes, numberOfIndexes, values );
+    }
+
+    std::vector<double> Image::GetPixelsAsDouble( const std::vector<uint32_t> &indexes ) const
+    {
+      assert( m_PimpleImage );
+      const unsigned int dimension = this->GetDimension();
+      if ( indexes.size() % dimension != 0 )
+        {
+        sitkExceptionMacro( "The length of the indexes, " << indexes.size()
+                            << ", is not a multiple of the image's dimension " << dimension << "." );
+        }
+      const size_t numberOfIndexes = indexes.size() / dimension;
+      std::vector<double> values( numberOfIndexes * this->GetNumberOfComponentsPerPixel() );
+      if ( numberOfIndexes )
+        {
+        this->m_PimpleImage->GetPixelsAsDouble( &indexes[0], numberOfIndexes, &values[0] );
+        }
+      return values;
+    }
+
+    void Image::SetPixelsAsDouble( const uint32_t *indexes, size_t numberOfIndexes, const double *values )
+    {
+      assert( m_PimpleImage );
+      this->MakeUnique();
+      this->m_PimpleImage->SetPixelsAsDouble( indexes, numberOfIndexes, values );
+    }
+
+    void Image::SetPixelsAsDouble( const std::vector<uint32_t> &indexes, const std::vector<double> &values )
+    {
+      assert( m_PimpleImage );
+      const unsigned int dimension = this->GetDimension();
+      const size_t numberOfIndexes = indexes.size() / dimension;
+      if ( indexes.size() % dimension != 0
+           || values.size() != numberOfIndexes * this->GetNumberOfComponentsPerPixel() )
+        {
+        sitkExceptionMacro( "Expected the " << indexes.size() << " index elements to be a multiple of the image's dimension "
+                            << dimension << ", with " << this->GetNumberOfComponentsPerPixel()
+                            << " values for each index, but got " << values.size() << " values." );
+        }
+      this->MakeUnique();
+      if ( numberOfIndexes )
+        {
+        this->m_PimpleImage->SetPixelsAsDouble( &indexes[0], numberOfIndexes, &values[0] );
+        }
+    }
+
+    void Image::EvaluateAtContinuousIndexes( const double *indexes, size_t numberOfIndexes, double *values,
+                                             InterpolatorEnum interp, double defaultValue ) const
+    {
+      assert( m_PimpleImage );
+      this->m_PimpleImage->EvaluateAtPoints( indexes, numberOfIndexes, false, interp, defaultValue, values );
+    }
+
+    void Image::EvaluateAtPhysicalPoints( const double *points, size_t numberOfPoints, double *values,
+                                          InterpolatorEnum interp, double defaultValue ) const
+    {
+      assert( m_PimpleImage );
+      this->m_PimpleImage->EvaluateAtPoints( points, numberOfPoints, true, interp, defaultValue, values );
+    }
+
+    std::vector<double> Image::EvaluateAtContinuousIndexes( const std::vector<double> &indexes,
+                                                            InterpolatorEnum interp,
+                                                            double defaultValue ) const
+    {
+      assert( m_PimpleImage );
+      const unsigned int dimension = this->GetDimension();
+      if ( indexes.size() % dimension != 0 )
+        {
+        sitkExceptionMacro( "The length of the indexes, " << indexes.size()
+                            << ", is not a multiple of the image's dimension " << dimension << "." );
+        }
+      const size_t numberOfIndexes = indexes.size() / dimension;
+      std::vector<double> values( numberOfIndexes * this->GetNumberOfComponentsPerPixel() );
+      if ( numberOfIndexes )
+        {
+        this->m_PimpleImage->EvaluateAtPoints( &indexes[0], numberOfIndexes, false, interp, defaultValue, &values[0] );
+        }
+      return values;
+    }
+
+    std::vector<double> Image::EvaluateAtPhysicalPoints( const std::vector<double> &points,
+                                                         InterpolatorEnum interp,
+                                                         double defaultValue ) const
+    {
+      assert( m_PimpleImage );
+      const unsigned int dimension = this->GetDimension();
+      if ( points.size() % dimension != 0 )
+        {
+        sitkExceptionMacro( "The length of the points, " << points.size()
+                            << ", is not a multiple of the image's dimension " << dimension << "." );
+        }
+      const size_t numberOfPoints = points.size() / dimension;
+      std::vector<double> values( numberOfPoints * this->GetNumberOfComponentsPerPixel() );
+      if ( numberOfPoints )
+        {
+        this->m_PimpleImage->EvaluateAtPoints( &points[0], numberOfPoints, true, interp, defaultValue, &values[0] );
+        }
+      return values;
+    }
+
 
     void Image::MakeUnique( void )
     {
-      if ( this->m_PimpleImage->GetReferenceCountOfImage() > 1 )
+      if ( this->m_PimpleImage->GetReferenceCountOfImage() > 1
+           || this->m_PimpleImage->GetReferenceCountOfPixelContainer() > 1 )
         {
         // note: care is take here to be exception safe with memory allocation
         nsstd::auto_ptr<PimpleImageBase> temp( this->m_PimpleImage->DeepCopy() );
@@ -733,5 +838,23 @@ namespace itk
         }
 
     }
+
+    bool Image::IsUnique( void ) const
+    {
+      assert( m_PimpleImage );
+      return this->m_PimpleImage->GetReferenceCountOfImage() == 1
+        && this->m_PimpleImage->GetReferenceCountOfPixelContainer() == 1;
+    }
+
+    void Image::MakeUniqueMetaData( void )
+    {
+      if ( this->m_PimpleImage->GetReferenceCountOfImage() > 1 )
+        {
+        // only the meta-data is copied, the pixel buffer is shared
+        nsstd::auto_ptr<PimpleImageBase> temp( this->m_PimpleImage->DeepCopyMetaData() );
+        delete this->m_PimpleImage;
+        this->m_PimpleImage = temp.release();
+        }
+    }
   } // end namespace simple
 } // end namespace itk
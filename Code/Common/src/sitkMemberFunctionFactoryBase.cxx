@@ -0,0 +1,47 @@
+/*=========================================================================
+*
+*  Copyright Insight Software Consortium
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*         http://www.apache.org/licenses/LICENSE-2.0.txt
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*=========================================================================*/
+#include "sitkMemberFunctionFactoryBase.h"
+
+#include "itkSimpleFastMutexLock.h"
+
+namespace itk
+{
+namespace simple
+{
+namespace detail
+{
+
+namespace
+{
+// a namespace scope static is initialized before the library is used
+static itk::SimpleFastMutexLock MemberFunctionTablesLock;
+}
+
+MemberFunctionTableLock::MemberFunctionTableLock( void )
+{
+  MemberFunctionTablesLock.Lock();
+}
+
+MemberFunctionTableLock::~MemberFunctionTableLock( void )
+{
+  MemberFunctionTablesLock.Unlock();
+}
+
+} // end namespace detail
+} // end namespace simple
+} // end namespace itk
@@ -21,6 +21,7 @@
 #include <vector>
 #include "sitkPixelIDTokens.h"
 #include "sitkTemplateFunctions.h"
+#include "sitkInterpolator.h"
 
 namespace itk
 {
@@ -49,6 +50,11 @@ namespace itk
 
     virtual PimpleImageBase *ShallowCopy(void) const = 0;
     virtual PimpleImageBase *DeepCopy(void) const = 0;
+
+    /** Create a new ITK image object with a copy of the meta-data
+     * (origin, spacing, direction and dictionary) which shares the
+     * pixel buffer with this image. */
+    virtual PimpleImageBase *DeepCopyMetaData(void) const = 0;
     virtual itk::DataObject* GetDataBase( void ) = 0;
     virtual const itk::DataObject* GetDataBase( void ) const = 0;
 
@@ -78,6 +84,10 @@ namespace itk
 
     virtual int GetReferenceCountOfImage() const = 0;
 
+    /** The number of references to the pixel buffer, which may be
+     * shared between images with different meta-data. */
+    virtual int GetReferenceCountOfPixelContainer() const = 0;
+
     virtual int8_t   GetPixelAsInt8( const std::vector<uint32_t> &idx) const = 0;
     virtual uint8_t  GetPixelAsUInt8( const std::vector<uint32_t> &idx) const = 0;
     virtual int16_t  GetPixelAsInt16( const std::vector<uint32_t> &idx ) const = 0;
@@ -129,6 +139,13 @@ namespace itk
     virtual void SetPixelAsComplexFloat64( const std::vector<uint32_t> &idx, const std::complex<double> v ) = 0;
 
 
+    virtual void GetPixelsAsDouble( const uint32_t *indexes, size_t numberOfIndexes, double *values ) const = 0;
+    virtual void SetPixelsAsDouble( const uint32_t *indexes, size_t numberOfIndexes, const double *values ) = 0;
+    /** Interpolate at continuous indexes, or physical points when
+     * arePhysicalPoints is true. */
+    virtual void EvaluateAtPoints( const double *points, size_t numberOfPoints, bool arePhysicalPoints,
+                                   InterpolatorEnum interp, double defaultValue, double *values ) const = 0;
+
     virtual int8_t   *GetBufferAsInt8( ) = 0;
     virtual uint8_t  *GetBufferAsUInt8( ) = 0;
     virtual int16_t  *GetBufferAsInt16( ) = 0;
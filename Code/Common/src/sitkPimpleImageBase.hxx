@@ -27,6 +27,10 @@
 #include "itkVectorImage.h"
 #include "itkLabelMap.h"
 #include "itkImageDuplicator.h"
+#include "itkContinuousIndex.h"
+
+#include <algorithm>
+#include <cmath>
 
 namespace itk
 {
@@ -44,6 +48,33 @@ namespace itk
   struct MakeDependentOn
     : public U {};
 
+  template <typename T>
+  struct IsComplex
+  {
+    static const bool Value = false;
+  };
+
+  template <typename T>
+  struct IsComplex< std::complex<T> >
+  {
+    static const bool Value = true;
+  };
+
+  /** True for image types with a pixel buffer of real components,
+   * which can be accessed as doubles.
+   */
+  template <typename TImageType, bool VIsLabel = IsLabel<TImageType>::Value>
+  struct HasRealComponents
+  {
+    static const bool Value = !IsComplex<typename TImageType::InternalPixelType>::Value;
+  };
+
+  template <typename TImageType>
+  struct HasRealComponents<TImageType, true>
+  {
+    static const bool Value = false;
+  };
+
   template <class TImageType>
   class PimpleImage
     : public PimpleImageBase
@@ -93,6 +124,8 @@ namespace itk
     typename DisableIf<IsLabel<UImageType>::Value, PimpleImageBase*>::Type
     DeepCopy( void ) const
       {
+        this->UpdateBuffer<UImageType>();
+
         typedef itk::ImageDuplicator< ImageType > ImageDuplicatorType;
         typename ImageDuplicatorType::Pointer dup = ImageDuplicatorType::New();
 
@@ -110,6 +143,30 @@ namespace itk
         return new Self( this->m_Image.GetPointer() );
       }
 
+    virtual PimpleImageBase *DeepCopyMetaData( void ) const { return this->DeepCopyMetaData<TImageType>(); }
+
+    template <typename UImageType>
+    typename DisableIf<IsLabel<UImageType>::Value, PimpleImageBase*>::Type
+    DeepCopyMetaData( void ) const
+      {
+        this->UpdateBuffer<UImageType>();
+
+        // The graft copies the image information and regions, and
+        // references the same pixel container.
+        ImagePointer output = ImageType::New();
+        output->Graft( this->m_Image.GetPointer() );
+        output->SetMetaDataDictionary( this->m_Image->GetMetaDataDictionary() );
+
+        return new Self( output.GetPointer() );
+      }
+    template <typename UImageType>
+    typename EnableIf<IsLabel<UImageType>::Value, PimpleImageBase*>::Type
+    DeepCopyMetaData( void ) const
+      {
+        // LabelMaps do not have a separate pixel buffer
+        return this->DeepCopy<UImageType>();
+      }
+
     virtual itk::DataObject* GetDataBase( void ) { return this->m_Image.GetPointer(); }
     virtual const itk::DataObject* GetDataBase( void ) const { return this->m_Image.GetPointer(); }
 
@@ -280,6 +337,8 @@ namespace itk
 
     std::string ToString( void ) const
       {
+        this->UpdateBuffer<TImageType>();
+
         std::ostringstream out;
         this->m_Image->Print ( out );
         return out.str();
@@ -290,6 +349,21 @@ namespace itk
         return this->m_Image->GetReferenceCount();
       }
 
+    virtual int GetReferenceCountOfPixelContainer() const { return this->GetReferenceCountOfPixelContainer<TImageType>(); }
+
+    template <typename UImageType>
+    typename DisableIf<IsLabel<UImageType>::Value, int>::Type
+    GetReferenceCountOfPixelContainer( void ) const
+      {
+        return this->m_Image->GetPixelContainer()->GetReferenceCount();
+      }
+    template <typename UImageType>
+    typename EnableIf<IsLabel<UImageType>::Value, int>::Type
+    GetReferenceCountOfPixelContainer( void ) const
+      {
+        return 1;
+      }
+
     virtual int8_t  GetPixelAsInt8( const std::vector<uint32_t> &idx) const
       {
         if ( IsLabel<ImageType>::Value )
@@ -630,6 +704,26 @@ namespace itk
         this->InternalSetPixel<BasicPixelID<std::complex<double> > >( idx, v );
       }
 
+    virtual void GetPixelsAsDouble( const uint32_t *indexes, size_t numberOfIndexes, double *values ) const
+      {
+        this->InternalGetPixels<TImageType>( indexes, numberOfIndexes, values );
+      }
+    virtual void SetPixelsAsDouble( const uint32_t *indexes, size_t numberOfIndexes, const double *values )
+      {
+        this->InternalSetPixels<TImageType>( indexes, numberOfIndexes, values );
+      }
+    virtual void EvaluateAtPoints( const double *points, size_t numberOfPoints, bool arePhysicalPoints,
+                                   InterpolatorEnum interp, double defaultValue, double *values ) const
+      {
+        if ( interp != sitkNearestNeighbor && interp != sitkLinear )
+          {
+          sitkExceptionMacro( "Only the sitkNearestNeighbor and sitkLinear interpolators are supported, not "
+                              << interp << "." );
+          }
+        this->InternalEvaluateAtPoints<TImageType>( points, numberOfPoints, arePhysicalPoints,
+                                                    interp, defaultValue, values );
+      }
+
 
   protected:
 
@@ -640,6 +734,8 @@ namespace itk
                       typename ImageType::PixelType >::Type
     InternalGetPixel( const std::vector<uint32_t> &idx ) const
       {
+        this->UpdateBuffer<TImageType>();
+
         const IndexType itkIdx = sitkSTLVectorToITK<IndexType>( idx );
         if ( ! this->m_Image->GetLargestPossibleRegion().IsInside( itkIdx ) )
           {
@@ -655,6 +751,8 @@ namespace itk
                       typename ImageType::PixelType >::Type
     InternalGetPixel( const std::vector<uint32_t> &idx ) const
       {
+        this->UpdateBuffer<TImageType>();
+
         const IndexType itkIdx = sitkSTLVectorToITK<IndexType>( idx );
         if ( ! this->m_Image->GetLargestPossibleRegion().IsInside( itkIdx ) )
           {
@@ -670,6 +768,8 @@ namespace itk
                       std::vector<typename MakeDependentOn<TPixelIDType, ImageType>::InternalPixelType> >::Type
     InternalGetPixel( const std::vector<uint32_t> &idx ) const
       {
+        this->UpdateBuffer<TImageType>();
+
         const IndexType itkIdx = sitkSTLVectorToITK<IndexType>( idx );
         if ( ! this->m_Image->GetLargestPossibleRegion().IsInside( itkIdx ) )
           {
@@ -700,6 +800,7 @@ namespace itk
                       typename ImageType::PixelType *>::Type
     InternalGetBuffer( void )
       {
+        this->UpdateBuffer<TImageType>();
         return this->m_Image->GetPixelContainer()->GetBufferPointer();
       }
 
@@ -720,6 +821,7 @@ namespace itk
                       typename MakeDependentOn<TPixelIDType, ImageType>::InternalPixelType * >::Type
     InternalGetBuffer( void )
       {
+        this->UpdateBuffer<TImageType>();
         return this->m_Image->GetPixelContainer()->GetBufferPointer();
       }
 
@@ -735,12 +837,238 @@ namespace itk
       }
 
 
+    // The batched pixel access methods work directly on the pixel
+    // buffer, of both itk::Image and itk::VectorImage types.
+    template <typename UImageType>
+    typename EnableIf<HasRealComponents<UImageType>::Value>::Type
+    InternalGetPixels( const uint32_t *indexes, size_t numberOfIndexes, double *values ) const
+      {
+        typedef typename UImageType::InternalPixelType InternalPixelType;
+        const unsigned int dimension = UImageType::ImageDimension;
+        const unsigned int numberOfComponents = this->GetNumberOfComponentsPerPixel();
+        this->UpdateBuffer<UImageType>();
+        const InternalPixelType *buffer = this->m_Image->GetPixelContainer()->GetBufferPointer();
+
+        for ( size_t n = 0; n < numberOfIndexes; ++n )
+          {
+          const InternalPixelType *px = buffer + this->ComputeBufferOffset( indexes + n*dimension )*numberOfComponents;
+          for ( unsigned int c = 0; c < numberOfComponents; ++c )
+            {
+            *values++ = static_cast<double>( px[c] );
+            }
+          }
+      }
+
+    template <typename UImageType>
+    typename EnableIf<HasRealComponents<UImageType>::Value>::Type
+    InternalSetPixels( const uint32_t *indexes, size_t numberOfIndexes, const double *values )
+      {
+        typedef typename UImageType::InternalPixelType InternalPixelType;
+        const unsigned int dimension = UImageType::ImageDimension;
+        const unsigned int numberOfComponents = this->GetNumberOfComponentsPerPixel();
+        this->UpdateBuffer<UImageType>();
+        InternalPixelType *buffer = this->m_Image->GetPixelContainer()->GetBufferPointer();
+
+        // check all of the indexes so that no pixel is set when one
+        // is out of bounds
+        for ( size_t n = 0; n < numberOfIndexes; ++n )
+          {
+          this->ComputeBufferOffset( indexes + n*dimension );
+          }
+
+        for ( size_t n = 0; n < numberOfIndexes; ++n )
+          {
+          InternalPixelType *px = buffer + this->ComputeBufferOffset( indexes + n*dimension )*numberOfComponents;
+          for ( unsigned int c = 0; c < numberOfComponents; ++c )
+            {
+            px[c] = static_cast<InternalPixelType>( *values++ );
+            }
+          }
+        this->m_Image->Modified();
+      }
+
+    template <typename UImageType>
+    typename EnableIf<HasRealComponents<UImageType>::Value>::Type
+    InternalEvaluateAtPoints( const double *points, size_t numberOfPoints, bool arePhysicalPoints,
+                              InterpolatorEnum interp, double defaultValue, double *values ) const
+      {
+        typedef typename UImageType::InternalPixelType InternalPixelType;
+        const unsigned int dimension = UImageType::ImageDimension;
+        const unsigned int numberOfComponents = this->GetNumberOfComponentsPerPixel();
+        this->UpdateBuffer<UImageType>();
+        const InternalPixelType *buffer = this->m_Image->GetPixelContainer()->GetBufferPointer();
+        const typename UImageType::SizeType &size = this->m_Image->GetBufferedRegion().GetSize();
+        const OffsetValueType *offsetTable = this->m_Image->GetOffsetTable();
+
+        std::vector<double> sum( numberOfComponents );
+
+        for ( size_t n = 0; n < numberOfPoints; ++n, values += numberOfComponents )
+          {
+          itk::ContinuousIndex<double, UImageType::ImageDimension> cidx;
+          if ( arePhysicalPoints )
+            {
+            typename UImageType::PointType pt;
+            std::copy( points + n*dimension, points + (n+1)*dimension, pt.Begin() );
+            this->m_Image->TransformPhysicalPointToContinuousIndex( pt, cidx );
+            }
+          else
+            {
+            std::copy( points + n*dimension, points + (n+1)*dimension, cidx.Begin() );
+            }
+
+          // the same convention as ImageFunction::IsInsideBuffer
+          bool isInside = true;
+          for ( unsigned int d = 0; d < dimension; ++d )
+            {
+            if ( !( cidx[d] >= -0.5 && cidx[d] < size[d] - 0.5 ) )
+              {
+              isInside = false;
+              }
+            }
+          if ( !isInside )
+            {
+            std::fill( values, values + numberOfComponents, defaultValue );
+            continue;
+            }
+
+          if ( interp == sitkNearestNeighbor )
+            {
+            OffsetValueType offset = 0;
+            for ( unsigned int d = 0; d < dimension; ++d )
+              {
+              OffsetValueType i = static_cast<OffsetValueType>( std::floor( cidx[d] + 0.5 ) );
+              i = std::min( std::max( i, OffsetValueType(0) ), static_cast<OffsetValueType>( size[d] ) - 1 );
+              offset += i*offsetTable[d];
+              }
+            const InternalPixelType *px = buffer + offset*numberOfComponents;
+            for ( unsigned int c = 0; c < numberOfComponents; ++c )
+              {
+              values[c] = static_cast<double>( px[c] );
+              }
+            continue;
+            }
+
+          // linear interpolation of the 2^dimension neighbors, which
+          // are clamped to the image at the border
+          OffsetValueType base[UImageType::ImageDimension];
+          double distance[UImageType::ImageDimension];
+          for ( unsigned int d = 0; d < dimension; ++d )
+            {
+            const double f = std::floor( cidx[d] );
+            base[d] = static_cast<OffsetValueType>( f );
+            distance[d] = cidx[d] - f;
+            }
+
+          std::fill( sum.begin(), sum.end(), 0.0 );
+          for ( unsigned int corner = 0; corner < (1u << dimension); ++corner )
+            {
+            double weight = 1.0;
+            OffsetValueType offset = 0;
+            for ( unsigned int d = 0; d < dimension; ++d )
+              {
+              const bool upper = ( corner >> d ) & 1u;
+              weight *= upper ? distance[d] : 1.0 - distance[d];
+              OffsetValueType i = base[d] + ( upper ? 1 : 0 );
+              i = std::min( std::max( i, OffsetValueType(0) ), static_cast<OffsetValueType>( size[d] ) - 1 );
+              offset += i*offsetTable[d];
+              }
+            if ( weight == 0.0 )
+              {
+              continue;
+              }
+            const InternalPixelType *px = buffer + offset*numberOfComponents;
+            for ( unsigned int c = 0; c < numberOfComponents; ++c )
+              {
+              sum[c] += weight*static_cast<double>( px[c] );
+              }
+            }
+          std::copy( sum.begin(), sum.end(), values );
+          }
+      }
+
+    template <typename UImageType>
+    typename DisableIf<HasRealComponents<UImageType>::Value>::Type
+    InternalGetPixels( const uint32_t *, size_t, double * ) const
+      {
+        sitkExceptionMacro( "Batched pixel access is not supported for images of type: "
+                            << GetPixelIDValueAsString( this->GetPixelID() ) );
+      }
+
+    template <typename UImageType>
+    typename DisableIf<HasRealComponents<UImageType>::Value>::Type
+    InternalSetPixels( const uint32_t *, size_t, const double * )
+      {
+        sitkExceptionMacro( "Batched pixel access is not supported for images of type: "
+                            << GetPixelIDValueAsString( this->GetPixelID() ) );
+      }
+
+    template <typename UImageType>
+    typename DisableIf<HasRealComponents<UImageType>::Value>::Type
+    InternalEvaluateAtPoints( const double *, size_t, bool, InterpolatorEnum, double, double * ) const
+      {
+        sitkExceptionMacro( "Batched pixel access is not supported for images of type: "
+                            << GetPixelIDValueAsString( this->GetPixelID() ) );
+      }
+
+    // The images returned by the filters while a Pipeline is
+    // recording have a buffered region but no buffer until their
+    // source is updated. Such an image is updated through its source
+    // and disconnected from it, so that the pipeline neither releases
+    // nor recomputes the buffer. Once the Pipeline has released the
+    // source, the image can not be computed anymore.
+    template <typename UImageType>
+    typename DisableIf<IsLabel<UImageType>::Value>::Type
+    UpdateBuffer( void ) const
+      {
+        if ( this->m_Image->GetBufferPointer() != SITK_NULLPTR
+             || this->m_Image->GetBufferedRegion().GetNumberOfPixels() == 0 )
+          {
+          return;
+          }
+
+        if ( !this->m_Image->GetSource() )
+          {
+          sitkExceptionMacro( "The image has no pixel buffer! It was returned by a filter while a Pipeline "
+                              "was recording, and the Pipeline has since been executed or cleared." );
+          }
+
+        this->m_Image->ReleaseDataFlagOff();
+        this->m_Image->UpdateLargestPossibleRegion();
+        this->m_Image->DisconnectPipeline();
+      }
+    template <typename UImageType>
+    typename EnableIf<IsLabel<UImageType>::Value>::Type
+    UpdateBuffer( void ) const
+      {
+        // LabelMaps are never deferred
+      }
+
+    // Compute the offset in pixels of a zero based index, with bounds
+    // checking.
+    OffsetValueType ComputeBufferOffset( const uint32_t *idx ) const
+      {
+        const typename ImageType::SizeType &size = this->m_Image->GetBufferedRegion().GetSize();
+        const OffsetValueType *offsetTable = this->m_Image->GetOffsetTable();
+        OffsetValueType offset = 0;
+        for ( unsigned int d = 0; d < ImageType::ImageDimension; ++d )
+          {
+          if ( idx[d] >= size[d] )
+            {
+            sitkExceptionMacro( "index out of bounds" );
+            }
+          offset += idx[d]*offsetTable[d];
+          }
+        return offset;
+      }
+
     template < typename TPixelIDType, typename TPixelType >
     typename EnableIf<nsstd::is_same<TPixelIDType, typename ImageTypeToPixelID<ImageType>::PixelIDType>::value
                       && !IsLabel<TPixelIDType>::Value
                       && !IsVector<TPixelIDType>::Value >::Type
     InternalSetPixel( const std::vector<uint32_t> &idx, const TPixelType v ) const
       {
+        this->UpdateBuffer<TImageType>();
+
         const IndexType itkIdx = sitkSTLVectorToITK<IndexType>( idx );
         if ( ! this->m_Image->GetLargestPossibleRegion().IsInside( itkIdx ) )
           {
@@ -755,6 +1083,8 @@ namespace itk
                       && !IsVector<TPixelIDType>::Value >::Type
     InternalSetPixel( const std::vector<uint32_t> &idx, const TPixelType v ) const
       {
+        this->UpdateBuffer<TImageType>();
+
         const IndexType itkIdx = sitkSTLVectorToITK<IndexType>( idx );
         if ( ! this->m_Image->GetLargestPossibleRegion().IsInside( itkIdx ) )
           {
@@ -769,6 +1099,8 @@ namespace itk
                       && IsVector<TPixelIDType>::Value >::Type
     InternalSetPixel( const std::vector<uint32_t> &idx, const std::vector<TPixelValueType> & v  ) const
       {
+        this->UpdateBuffer<TImageType>();
+
         const IndexType itkIdx = sitkSTLVectorToITK<IndexType>( idx );
         if ( ! this->m_Image->GetLargestPossibleRegion().IsInside( itkIdx ) )
           {
@@ -0,0 +1,229 @@
+/*=========================================================================
+*
+*  Copyright Insight Software Consortium
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*         http://www.apache.org/licenses/LICENSE-2.0.txt
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*=========================================================================*/
+#include "sitkPipeline.h"
+
+#include "itkProcessObject.h"
+#include "itkStreamingImageFilter.h"
+#include "itkVectorImage.h"
+#include "itkNumericTraits.h"
+#include "itkNumericTraitsVariableLengthVectorPixel.h"
+#include "itkSimpleFastMutexLock.h"
+#include "itkMutexLockHolder.h"
+#include "itkAtomicInt.h"
+
+#if defined(_WIN32)
+#include "itkWindows.h"
+#else
+#include <pthread.h>
+#endif
+
+#include <sstream>
+
+namespace itk {
+  namespace simple {
+
+    namespace
+    {
+#if defined(_WIN32)
+    typedef DWORD ThreadIdentifierType;
+
+    ThreadIdentifierType GetCurrentThreadIdentifier()
+    {
+      return ::GetCurrentThreadId();
+    }
+
+    bool IsSameThread( ThreadIdentifierType a, ThreadIdentifierType b )
+    {
+      return a == b;
+    }
+#else
+    typedef pthread_t ThreadIdentifierType;
+
+    ThreadIdentifierType GetCurrentThreadIdentifier()
+    {
+      return pthread_self();
+    }
+
+    bool IsSameThread( ThreadIdentifierType a, ThreadIdentifierType b )
+    {
+      return pthread_equal( a, b ) != 0;
+    }
+#endif
+
+    typedef itk::MutexLockHolder<itk::SimpleFastMutexLock> LockHolder;
+
+    static itk::SimpleFastMutexLock RecordingLock;
+
+    // the pipeline currently deferring the update of filters, and the
+    // thread which started the recording, only the filters executed by
+    // that thread are deferred.
+    static Pipeline *RecordingPipeline = NULL;
+    static ThreadIdentifierType RecordingThread;
+
+    // non-zero while a pipeline is recording, read without the lock
+    // so that filters executed without a Pipeline do not contend for
+    // it
+    static itk::AtomicInt<int> IsAnyPipelineRecording;
+    }
+
+    Pipeline::Pipeline ()
+    {
+      this->m_MemberFactory.reset( new detail::MemberFunctionFactory<MemberFunctionType>( this ) );
+
+      this->m_MemberFactory->RegisterMemberFunctions< PixelIDTypeList, 4 > ();
+      this->m_MemberFactory->RegisterMemberFunctions< PixelIDTypeList, 3 > ();
+      this->m_MemberFactory->RegisterMemberFunctions< PixelIDTypeList, 2 > ();
+    }
+
+    Pipeline::~Pipeline ()
+    {
+      this->StopRecording();
+      this->Clear();
+    }
+
+    std::string Pipeline::ToString() const
+    {
+      std::ostringstream out;
+      out << "itk::simple::Pipeline" << std::endl;
+      out << "  Recording: " << ( this->IsRecording() ? "true" : "false" ) << std::endl;
+      out << "  NumberOfRecordedFilters: " << this->m_Processes.size() << std::endl;
+      out << ProcessObject::ToString();
+      return out.str();
+    }
+
+    void Pipeline::StartRecording()
+    {
+      LockHolder lock( RecordingLock );
+      const ThreadIdentifierType currentThread = GetCurrentThreadIdentifier();
+      if ( RecordingPipeline != NULL &&
+           ( RecordingPipeline != this || !IsSameThread( RecordingThread, currentThread ) ) )
+        {
+        sitkExceptionMacro( "Another Pipeline is already recording!" );
+        }
+      RecordingPipeline = this;
+      RecordingThread = currentThread;
+      IsAnyPipelineRecording = 1;
+    }
+
+    void Pipeline::StopRecording()
+    {
+      LockHolder lock( RecordingLock );
+      if ( RecordingPipeline == this )
+        {
+        RecordingPipeline = NULL;
+        IsAnyPipelineRecording = 0;
+        }
+    }
+
+    bool Pipeline::IsRecording() const
+    {
+      LockHolder lock( RecordingLock );
+      return RecordingPipeline == this;
+    }
+
+    unsigned int Pipeline::GetNumberOfRecordedFilters() const
+    {
+      return static_cast<unsigned int>( this->m_Processes.size() );
+    }
+
+    void Pipeline::Clear()
+    {
+      for ( size_t i = 0; i < this->m_Processes.size(); ++i )
+        {
+        this->m_Processes[i]->UnRegister();
+        }
+      this->m_Processes.clear();
+    }
+
+    Pipeline *Pipeline::GetRecordingPipeline()
+    {
+      if ( !IsAnyPipelineRecording )
+        {
+        return NULL;
+        }
+
+      LockHolder lock( RecordingLock );
+      if ( RecordingPipeline != NULL && IsSameThread( RecordingThread, GetCurrentThreadIdentifier() ) )
+        {
+        return RecordingPipeline;
+        }
+      return NULL;
+    }
+
+    void Pipeline::AddProcess( itk::ProcessObject *p )
+    {
+      p->Register();
+      this->m_Processes.push_back( p );
+    }
+
+    Image Pipeline::Execute ( const Image& image )
+    {
+      this->StopRecording();
+
+      PixelIDValueEnum type = image.GetPixelID();
+      unsigned int dimension = image.GetDimension();
+
+      try
+        {
+        Image out = this->m_MemberFactory->GetMemberFunction( type, dimension )( image );
+        this->Clear();
+        return out;
+        }
+      catch (...)
+        {
+        this->Clear();
+        throw;
+        }
+    }
+
+    template <class TImageType>
+    Image Pipeline::ExecuteInternal ( const Image& inImage )
+    {
+      typedef TImageType InputImageType;
+      typedef TImageType OutputImageType;
+
+      typename InputImageType::ConstPointer image = this->CastImageToITK<InputImageType>( inImage );
+
+      typedef itk::StreamingImageFilter<InputImageType, OutputImageType> FilterType;
+      typename FilterType::Pointer filter = FilterType::New();
+
+      typedef typename itk::NumericTraits<typename InputImageType::PixelType>::ValueType ValueType;
+      const unsigned int pixelSize = image->GetNumberOfComponentsPerPixel() * sizeof( ValueType );
+      const unsigned int divisions =
+        this->ComputeNumberOfStreamDivisions( image->GetLargestPossibleRegion().GetNumberOfPixels(), pixelSize );
+
+      filter->SetInput( image );
+      filter->SetNumberOfStreamDivisions( divisions );
+
+      this->PreUpdate( filter.GetPointer() );
+      AcquiredThreadsReleaser releaseThreads( this );
+
+      filter->Update();
+
+      // disconnect the output from the recorded filters
+      typename OutputImageType::Pointer itkOutImage = filter->GetOutput();
+      itkOutImage->DisconnectPipeline();
+
+      this->RecordOutputBytes( static_cast<uint64_t>( itkOutImage->GetBufferedRegion().GetNumberOfPixels() ) * pixelSize );
+
+      this->FixNonZeroIndex( itkOutImage.GetPointer() );
+      return Image( this->CastITKToImage( itkOutImage.GetPointer() ) );
+    }
+
+  }
+}
@@ -17,10 +17,16 @@
 *=========================================================================*/
 #include "sitkProcessObject.h"
 #include "sitkCommand.h"
+#include "sitkPipeline.h"
+#include "sitkExecutionProfiler.h"
+#include "sitkThreadPool.h"
 
 #include "itkProcessObject.h"
 #include "itkCommand.h"
 #include "itkImageToImageFilter.h"
+#include "itkMultiThreader.h"
+#include "itkSimpleFastMutexLock.h"
+#include "itkMutexLockHolder.h"
 
 #include <iostream>
 #include <algorithm>
@@ -103,7 +109,21 @@ private:
 ProcessObject::ProcessObject ()
   : m_Debug(ProcessObject::GetGlobalDefaultDebug()),
     m_NumberOfThreads(ProcessObject::GetGlobalDefaultNumberOfThreads()),
+    m_NumberOfStreamDivisions(1),
+    m_MaximumMemory(0),
+    m_ExecutionWallTime(0.0),
+    m_ExecutionCPUTime(0.0),
+    m_ExecutionNumberOfThreads(0),
+    m_ExecutionOutputBytes(0),
+    m_ExecutionPeakResidentMemoryDelta(0),
+    m_ExecutionProfiled(false),
+    m_StartWallTime(0.0),
+    m_StartCPUTime(0.0),
+    m_StartPeakResidentMemory(0),
+    m_NumberOfAcquiredThreads(0),
     m_ActiveProcess(NULL),
+    m_CollectingUpdates(false),
+    m_CollectedUpdateProcess(NULL),
     m_ProgressMeasurement(0.0)
 {
 }
@@ -116,6 +136,10 @@ ProcessObject::~ProcessObject ()
 {
   // ensure to remove reference between sitk commands and process object
   Self::RemoveAllCommands();
+
+  this->ReleaseCollected();
+
+  this->ReleaseAcquiredThreads();
 }
 
 std::string ProcessObject::ToString() const
@@ -128,6 +152,12 @@ std::string ProcessObject::ToString() const
   out << "  NumberOfThreads: ";
   this->ToStringHelper(out, this->m_NumberOfThreads) << std::endl;
 
+  out << "  NumberOfStreamDivisions: ";
+  this->ToStringHelper(out, this->m_NumberOfStreamDivisions) << std::endl;
+
+  out << "  MaximumMemory: ";
+  this->ToStringHelper(out, this->m_MaximumMemory) << std::endl;
+
   out << "  Commands:" << (m_Commands.empty()?" (none)":"") << std::endl;
   for( std::list<EventCommand>::const_iterator i = m_Commands.begin();
        i != m_Commands.end();
@@ -289,6 +319,32 @@ unsigned int ProcessObject::GetNumberOfThreads() const
 }
 
 
+ProcessObject::Self& ProcessObject::SetNumberOfStreamDivisions(unsigned int n)
+{
+  m_NumberOfStreamDivisions = std::max( n, 1u );
+  return *this;
+}
+
+
+unsigned int ProcessObject::GetNumberOfStreamDivisions() const
+{
+  return m_NumberOfStreamDivisions;
+}
+
+
+ProcessObject::Self& ProcessObject::SetMaximumMemory(uint64_t bytes)
+{
+  m_MaximumMemory = bytes;
+  return *this;
+}
+
+
+uint64_t ProcessObject::GetMaximumMemory() const
+{
+  return m_MaximumMemory;
+}
+
+
 int ProcessObject::AddCommand(EventEnum event, Command &cmd)
 {
   // add to our list of event, command pairs
@@ -372,12 +428,61 @@ void ProcessObject::Abort()
 }
 
 
+double ProcessObject::GetExecutionWallTime() const
+{
+  return m_ExecutionWallTime;
+}
+
+
+double ProcessObject::GetExecutionCPUTime() const
+{
+  return m_ExecutionCPUTime;
+}
+
+
+unsigned int ProcessObject::GetExecutionNumberOfThreads() const
+{
+  return m_ExecutionNumberOfThreads;
+}
+
+
+uint64_t ProcessObject::GetExecutionOutputBytes() const
+{
+  return m_ExecutionOutputBytes;
+}
+
+
+uint64_t ProcessObject::GetExecutionPeakResidentMemoryDelta() const
+{
+  return m_ExecutionPeakResidentMemoryDelta;
+}
+
+
 void ProcessObject::PreUpdate(itk::ProcessObject *p)
 {
   assert(p);
 
-  // propagate number of threads
-  p->SetNumberOfThreads(this->GetNumberOfThreads());
+  // propagate number of threads, limited by the threads of the pool
+  // shared with other executions
+  this->ReleaseAcquiredThreads();
+  this->m_NumberOfAcquiredThreads = ThreadPool::AcquireThreads(this->GetNumberOfThreads());
+  p->SetNumberOfThreads(this->m_NumberOfAcquiredThreads);
+
+  if ( this->m_CollectingUpdates )
+    {
+    // the commands observe the process of the collected updates,
+    // which are measured as one execution
+    return;
+    }
+
+  // reset the measurements of the execution
+  this->m_ExecutionWallTime = 0.0;
+  this->m_ExecutionCPUTime = 0.0;
+  this->m_ExecutionNumberOfThreads = 0;
+  this->m_ExecutionOutputBytes = 0;
+  this->m_ExecutionPeakResidentMemoryDelta = 0;
+  this->m_ExecutionProfiled = false;
+  this->m_StartPeakResidentMemory = ExecutionProfiler::GetCurrentPeakResidentMemory();
 
   try
     {
@@ -388,6 +493,15 @@ void ProcessObject::PreUpdate(itk::ProcessObject *p)
     onDelete->SetCallbackFunction(this, &Self::OnActiveProcessDelete);
     p->AddObserver(itk::DeleteEvent(), onDelete);
 
+    // add commands measuring the execution
+    itk::SimpleMemberCommand<Self>::Pointer onStart = itk::SimpleMemberCommand<Self>::New();
+    onStart->SetCallbackFunction(this, &Self::OnActiveProcessStart);
+    p->AddObserver(itk::StartEvent(), onStart);
+
+    itk::SimpleMemberCommand<Self>::Pointer onEnd = itk::SimpleMemberCommand<Self>::New();
+    onEnd->SetCallbackFunction(this, &Self::OnActiveProcessEnd);
+    p->AddObserver(itk::EndEvent(), onEnd);
+
     // register commands
     for (std::list<EventCommand>::iterator i = m_Commands.begin();
          i != m_Commands.end();
@@ -399,6 +513,7 @@ void ProcessObject::PreUpdate(itk::ProcessObject *p)
     }
   catch (...)
     {
+    this->ReleaseAcquiredThreads();
     this->m_ActiveProcess = NULL;
     throw;
     }
@@ -411,6 +526,332 @@ void ProcessObject::PreUpdate(itk::ProcessObject *p)
 }
 
 
+void ProcessObject::ReleaseAcquiredThreads()
+{
+  ThreadPool::ReleaseThreads(this->m_NumberOfAcquiredThreads);
+  this->m_NumberOfAcquiredThreads = 0;
+}
+
+
+bool ProcessObject::IsPipelineRecording()
+{
+  return Pipeline::GetRecordingPipeline() != NULL;
+}
+
+
+bool ProcessObject::IsStreamed() const
+{
+  return this->m_NumberOfStreamDivisions > 1 || this->m_MaximumMemory != 0 || Self::IsPipelineRecording();
+}
+
+
+void ProcessObject::CheckStreamingNotRequested() const
+{
+  if ( this->m_NumberOfStreamDivisions > 1 || this->m_MaximumMemory != 0 )
+    {
+    sitkExceptionMacro( << this->GetName() << " can not compute its output in pieces, the NumberOfStreamDivisions "
+                        << "must be 1 and the MaximumMemory 0!" );
+    }
+}
+
+
+unsigned int ProcessObject::ComputeNumberOfStreamDivisions( uint64_t numberOfPixels, unsigned int pixelSize ) const
+{
+  uint64_t divisions = this->m_NumberOfStreamDivisions;
+
+  if ( this->m_MaximumMemory != 0 )
+    {
+    const uint64_t bytes = numberOfPixels * pixelSize;
+    divisions = std::max( divisions, ( bytes + this->m_MaximumMemory - 1 ) / this->m_MaximumMemory );
+    }
+
+  // more divisions than pixels can not be computed
+  divisions = std::min( divisions, std::max<uint64_t>( numberOfPixels, 1 ) );
+  return static_cast<unsigned int>( std::min<uint64_t>( divisions, std::numeric_limits<unsigned int>::max() ) );
+}
+
+
+void ProcessObject::RetainInPipeline(itk::ProcessObject *p)
+{
+  assert(p);
+
+  Pipeline *pipeline = NULL;
+  if ( !this->m_CollectingUpdates )
+    {
+    pipeline = Pipeline::GetRecordingPipeline();
+    if ( !pipeline )
+      {
+      sitkExceptionMacro("LogicError: No Pipeline is recording!");
+      }
+    }
+
+  // The ITK filter out lives this object, so the observers
+  // referencing this object must be removed.
+  p->RemoveAllObservers();
+
+  if ( pipeline )
+    {
+    this->OnActiveProcessDelete();
+    pipeline->AddProcess(p);
+    }
+  else
+    {
+    // the commands remain on the process of the collected updates
+    this->ReleaseAcquiredThreads();
+    p->Register();
+    this->m_CollectedProcesses.push_back(p);
+    }
+}
+
+
+namespace
+{
+
+// The process observed by the commands of a ProcessObject while its
+// updates are collected, it reports the progress of the collected
+// updates and holds the abort flag.
+class CollectedUpdateProcess
+  : public itk::ProcessObject
+{
+public:
+  typedef CollectedUpdateProcess         Self;
+  typedef itk::ProcessObject             Superclass;
+  typedef itk::SmartPointer<Self>        Pointer;
+  typedef itk::SmartPointer<const Self>  ConstPointer;
+
+  itkNewMacro(Self);
+  itkTypeMacro(CollectedUpdateProcess, ProcessObject);
+
+protected:
+  CollectedUpdateProcess() {}
+
+private:
+  CollectedUpdateProcess( const Self & ); // purposely not implemented
+  void operator=( const Self & ); // purposely not implemented
+};
+
+struct CollectedUpdate
+{
+  ProcessObject::CollectedUpdateFunctionType m_Function;
+  void                                      *m_Data;
+  unsigned int                               m_NumberOfIndexes;
+
+  itk::ProcessObject                              *m_Process;
+  const std::vector<itk::ProcessObject *>         *m_CollectedProcesses;
+
+  itk::SimpleFastMutexLock m_Lock;
+  unsigned int             m_NumberOfUpdatedIndexes;
+  std::string              m_Error;
+};
+
+// Update every numberOfThreads-th index starting at threadId. As in
+// the ITK filters, only the first thread invokes the progress events, so
+// that the commands are executed by the calling thread.
+void UpdateCollectedIndexes( CollectedUpdate *update, unsigned int threadId, unsigned int numberOfThreads )
+{
+  for ( unsigned int i = threadId; i < update->m_NumberOfIndexes; i += numberOfThreads )
+    {
+    if ( update->m_Process->GetAbortGenerateData() )
+      {
+      break;
+      }
+
+    std::string error;
+    try
+      {
+      update->m_Function( i, update->m_Data );
+      }
+    catch ( std::exception &e )
+      {
+      error = e.what();
+      }
+    catch ( ... )
+      {
+      error = "Unknown exception while updating.";
+      }
+
+    float progress;
+      {
+      itk::MutexLockHolder<itk::SimpleFastMutexLock> lock( update->m_Lock );
+      if ( !error.empty() )
+        {
+        if ( update->m_Error.empty() )
+          {
+          update->m_Error = error;
+          }
+        break;
+        }
+      progress = static_cast<float>( ++update->m_NumberOfUpdatedIndexes ) / update->m_NumberOfIndexes;
+      }
+
+    if ( threadId == 0 )
+      {
+      update->m_Process->UpdateProgress( progress );
+      if ( update->m_Process->GetAbortGenerateData() )
+        {
+        // stop the collected updates in progress
+        for ( size_t j = 0; j < update->m_CollectedProcesses->size(); ++j )
+          {
+          (*update->m_CollectedProcesses)[j]->AbortGenerateDataOn();
+          }
+        break;
+        }
+      }
+    }
+}
+
+ITK_THREAD_RETURN_TYPE CollectedUpdateCallback( void *arg )
+{
+  typedef itk::MultiThreader::ThreadInfoStruct ThreadInfoType;
+  ThreadInfoType *threadInfo = static_cast< ThreadInfoType * >( arg );
+  CollectedUpdate *update = static_cast< CollectedUpdate * >( threadInfo->UserData );
+
+  UpdateCollectedIndexes( update, threadInfo->ThreadID, threadInfo->NumberOfThreads );
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+}
+
+
+void ProcessObject::StartCollectingUpdates()
+{
+  this->ReleaseCollected();
+  this->m_CollectingUpdates = true;
+
+  // The commands observe the process standing for the collected
+  // updates until they are released, its deletion is handled as of
+  // any active process.
+  CollectedUpdateProcess::Pointer process = CollectedUpdateProcess::New();
+  this->SwapActiveProcess( process.GetPointer() );
+
+  itk::SimpleMemberCommand<Self>::Pointer onDelete = itk::SimpleMemberCommand<Self>::New();
+  onDelete->SetCallbackFunction(this, &Self::OnActiveProcessDelete);
+  process->AddObserver(itk::DeleteEvent(), onDelete);
+
+  process->Register();
+  this->m_CollectedUpdateProcess = process.GetPointer();
+
+  process->InvokeEvent( itk::StartEvent() );
+}
+
+
+void ProcessObject::UpdateCollected( unsigned int n, CollectedUpdateFunctionType function, void *data )
+{
+  assert( this->m_CollectedUpdateProcess );
+  this->m_CollectingUpdates = false;
+
+  itk::ProcessObject *process = this->m_CollectedUpdateProcess;
+
+  const uint64_t startPeakResidentMemory = ExecutionProfiler::GetCurrentPeakResidentMemory();
+  const unsigned int numberOfThreads = ThreadPool::AcquireThreads( this->GetNumberOfThreads() );
+  const unsigned int numberOfConcurrentUpdates = std::max( 1u, std::min( n, numberOfThreads ) );
+
+  // the threads are divided among the updates executing at once
+  for ( size_t i = 0; i < this->m_CollectedProcesses.size(); ++i )
+    {
+    this->m_CollectedProcesses[i]->SetNumberOfThreads( std::max( 1u, numberOfThreads / numberOfConcurrentUpdates ) );
+    }
+
+  CollectedUpdate update;
+  update.m_Function = function;
+  update.m_Data = data;
+  update.m_NumberOfIndexes = n;
+  update.m_Process = process;
+  update.m_CollectedProcesses = &this->m_CollectedProcesses;
+  update.m_NumberOfUpdatedIndexes = 0;
+
+  const double startWallTime = ExecutionProfiler::GetCurrentWallTime();
+  const double startCPUTime = ExecutionProfiler::GetCurrentCPUTime();
+
+  try
+    {
+    if ( numberOfConcurrentUpdates == 1 )
+      {
+      UpdateCollectedIndexes( &update, 0, 1 );
+      }
+    else
+      {
+      itk::MultiThreader::Pointer threader = itk::MultiThreader::New();
+      threader->SetNumberOfThreads( numberOfConcurrentUpdates );
+      threader->SetSingleMethod( CollectedUpdateCallback, &update );
+      threader->SingleMethodExecute();
+      }
+    }
+  catch (...)
+    {
+    ThreadPool::ReleaseThreads( numberOfThreads );
+    this->ReleaseCollected();
+    throw;
+    }
+
+  ThreadPool::ReleaseThreads( numberOfThreads );
+
+  try
+    {
+    if ( process->GetAbortGenerateData() )
+      {
+      // as an aborted ITK filter
+      process->InvokeEvent( itk::AbortEvent() );
+      itk::ProcessAborted e( __FILE__, __LINE__ );
+      e.SetDescription( "AbortGenerateData was set!" );
+      e.SetLocation( ITK_LOCATION );
+      throw e;
+      }
+
+    if ( !update.m_Error.empty() )
+      {
+      sitkExceptionMacro( << update.m_Error );
+      }
+
+    // the updates are measured as one execution
+    this->m_ExecutionWallTime = ExecutionProfiler::GetCurrentWallTime() - startWallTime;
+    this->m_ExecutionCPUTime = ExecutionProfiler::GetCurrentCPUTime() - startCPUTime;
+    this->m_ExecutionNumberOfThreads = numberOfThreads;
+    const uint64_t peak = ExecutionProfiler::GetCurrentPeakResidentMemory();
+    this->m_ExecutionPeakResidentMemoryDelta = ( peak > startPeakResidentMemory ) ? peak - startPeakResidentMemory : 0;
+
+    if ( ExecutionProfiler::IsEnabled() )
+      {
+      ExecutionProfiler::AddExecution( this->GetName() );
+      ExecutionProfiler::AddTimes( this->GetName(),
+                                   this->m_ExecutionWallTime,
+                                   this->m_ExecutionCPUTime,
+                                   this->m_ExecutionNumberOfThreads,
+                                   this->m_ExecutionPeakResidentMemoryDelta );
+      }
+
+    process->UpdateProgress( 1.0f );
+    process->InvokeEvent( itk::EndEvent() );
+    }
+  catch (...)
+    {
+    this->ReleaseCollected();
+    throw;
+    }
+
+  this->ReleaseCollected();
+}
+
+
+void ProcessObject::ReleaseCollected()
+{
+  this->m_CollectingUpdates = false;
+  for ( size_t i = 0; i < this->m_CollectedProcesses.size(); ++i )
+    {
+    this->m_CollectedProcesses[i]->UnRegister();
+    }
+  this->m_CollectedProcesses.clear();
+
+  if ( this->m_CollectedUpdateProcess )
+    {
+    // deleting the process detaches the commands
+    itk::ProcessObject *process = this->m_CollectedUpdateProcess;
+    this->m_CollectedUpdateProcess = NULL;
+    process->UnRegister();
+    }
+}
+
+
 unsigned long ProcessObject::AddITKObserver( const itk::EventObject &e,
                                              itk::Command *c)
 {
@@ -484,10 +925,86 @@ void ProcessObject::OnActiveProcessDelete( )
       i->m_ITKTag = std::numeric_limits<unsigned long>::max();
       }
 
+  this->ReleaseAcquiredThreads();
+
   this->m_ActiveProcess = NULL;
 }
 
 
+void ProcessObject::OnActiveProcessStart( )
+{
+  this->m_StartWallTime = ExecutionProfiler::GetCurrentWallTime();
+  this->m_StartCPUTime = ExecutionProfiler::GetCurrentCPUTime();
+}
+
+
+void ProcessObject::OnActiveProcessEnd( )
+{
+  // the start and end events occur for each piece of a streamed
+  // output, so the times are accumulated
+  const double wallTime = ExecutionProfiler::GetCurrentWallTime() - this->m_StartWallTime;
+  const double cpuTime = ExecutionProfiler::GetCurrentCPUTime() - this->m_StartCPUTime;
+  this->m_ExecutionWallTime += wallTime;
+  this->m_ExecutionCPUTime += cpuTime;
+
+  if ( this->m_ActiveProcess )
+    {
+    this->m_ExecutionNumberOfThreads = this->m_ActiveProcess->GetNumberOfThreads();
+    }
+
+  const uint64_t peak = ExecutionProfiler::GetCurrentPeakResidentMemory();
+  if ( peak > this->m_StartPeakResidentMemory )
+    {
+    this->m_ExecutionPeakResidentMemoryDelta = peak - this->m_StartPeakResidentMemory;
+    }
+
+  if ( ExecutionProfiler::IsEnabled() )
+    {
+    if ( !this->m_ExecutionProfiled )
+      {
+      ExecutionProfiler::AddExecution( this->GetName() );
+      this->m_ExecutionProfiled = true;
+      }
+    ExecutionProfiler::AddTimes( this->GetName(),
+                                 wallTime,
+                                 cpuTime,
+                                 this->m_ExecutionNumberOfThreads,
+                                 this->m_ExecutionPeakResidentMemoryDelta );
+    }
+}
+
+
+void ProcessObject::RecordOutputBytes( uint64_t bytes )
+{
+  this->m_ExecutionOutputBytes = bytes;
+  if ( ExecutionProfiler::IsEnabled() )
+    {
+    ExecutionProfiler::AddOutputBytes( this->GetName(), bytes );
+    }
+}
+
+
+itk::ProcessObject *ProcessObject::SwapActiveProcess( itk::ProcessObject *p )
+{
+  itk::ProcessObject *previous = this->m_ActiveProcess;
+
+  std::list<EventCommand>::iterator i;
+  for ( i = m_Commands.begin(); i != m_Commands.end() && this->m_ActiveProcess; ++i )
+    {
+    this->RemoveObserverFromActiveProcessObject(*i);
+    }
+
+  this->m_ActiveProcess = p;
+
+  for ( i = m_Commands.begin(); i != m_Commands.end() && this->m_ActiveProcess; ++i )
+    {
+    this->AddObserverToActiveProcessObject(*i);
+    }
+
+  return previous;
+}
+
+
 void ProcessObject::onCommandDelete(const itk::simple::Command *cmd) throw()
 {
   // remove command from m_Command book keeping list, and remove it
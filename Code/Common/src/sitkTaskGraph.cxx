@@ -0,0 +1,388 @@
+/*=========================================================================
+*
+*  Copyright Insight Software Consortium
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*         http://www.apache.org/licenses/LICENSE-2.0.txt
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*=========================================================================*/
+#include "sitkTaskGraph.h"
+#include "sitkPipeline.h"
+#include "sitkThreadPool.h"
+
+#include "itkMultiThreader.h"
+#include "itkSimpleMutexLock.h"
+#include "itkConditionVariable.h"
+#include "itkMutexLockHolder.h"
+
+#include <algorithm>
+#include <set>
+#include <sstream>
+
+namespace itk
+{
+namespace simple
+{
+
+typedef itk::MutexLockHolder<itk::SimpleMutexLock> LockHolder;
+
+struct TaskGraph::Synchronization
+{
+  Synchronization()
+    : m_Condition( itk::ConditionVariable::New() ),
+      m_NumberOfRunningTasks( 0 ),
+      m_Executing( false )
+    {}
+
+  itk::SimpleMutexLock          m_Lock;
+  itk::ConditionVariable::Pointer m_Condition;
+
+  // the filters of the running tasks
+  std::set<const ProcessObject *> m_BusyFilters;
+  unsigned int m_NumberOfRunningTasks;
+
+  // true while Execute runs the tasks
+  bool m_Executing;
+};
+
+struct TaskGraphThreader
+{
+  static ITK_THREAD_RETURN_TYPE ExecuteTasksCallback( void *arg )
+    {
+      typedef itk::MultiThreader::ThreadInfoStruct ThreadInfoType;
+      ThreadInfoType *threadInfo = static_cast< ThreadInfoType * >( arg );
+      static_cast<TaskGraph *>( threadInfo->UserData )->ExecuteTasks();
+      return ITK_THREAD_RETURN_VALUE;
+    }
+};
+
+
+ImageFuture::ImageFuture()
+  : m_Graph( NULL ),
+    m_Task( 0 )
+{
+}
+
+ImageFuture::ImageFuture( TaskGraph *graph, unsigned int task )
+  : m_Graph( graph ),
+    m_Task( task )
+{
+}
+
+bool ImageFuture::IsValid() const
+{
+  return this->m_Graph != NULL && this->m_Task < this->m_Graph->m_Tasks.size();
+}
+
+bool ImageFuture::IsReady() const
+{
+  if ( !this->IsValid() )
+    {
+    return false;
+    }
+  LockHolder lock( this->m_Graph->m_Synchronization->m_Lock );
+  const TaskGraph::TaskState state = this->m_Graph->m_Tasks[this->m_Task].m_State;
+  return state == TaskGraph::Succeeded || state == TaskGraph::Failed;
+}
+
+Image ImageFuture::Get() const
+{
+  if ( !this->IsValid() )
+    {
+    sitkExceptionMacro( "The future does not refer to a task!" );
+    }
+  if ( !this->IsReady() )
+    {
+    // Waiting for the task from inside a task of the same graph would
+    // never complete, the graph is executed by the calling tasks.
+    if ( this->m_Graph->IsExecuting() )
+      {
+      sitkExceptionMacro( "Task " << this->m_Task << " has not executed, its image can not be waited for while the TaskGraph is executing!" );
+      }
+    this->m_Graph->Execute();
+    }
+
+  LockHolder lock( this->m_Graph->m_Synchronization->m_Lock );
+  const TaskGraph::Task &task = this->m_Graph->m_Tasks[this->m_Task];
+  if ( task.m_State == TaskGraph::Failed )
+    {
+    sitkExceptionMacro( "Task " << this->m_Task << " failed: " << task.m_Error );
+    }
+  return task.m_Image;
+}
+
+
+TaskGraph::TaskGraph()
+  : m_NumberOfThreads( 0 ),
+    m_Synchronization( new Synchronization )
+{
+}
+
+TaskGraph::~TaskGraph()
+{
+  delete this->m_Synchronization;
+}
+
+std::string TaskGraph::ToString() const
+{
+  std::ostringstream out;
+  out << "itk::simple::TaskGraph" << std::endl;
+  out << "  NumberOfThreads: " << this->m_NumberOfThreads << std::endl;
+  out << "  NumberOfTasks: " << this->m_Tasks.size() << std::endl;
+  return out.str();
+}
+
+void TaskGraph::SetNumberOfThreads( unsigned int n )
+{
+  this->m_NumberOfThreads = n;
+}
+
+unsigned int TaskGraph::GetNumberOfThreads() const
+{
+  return this->m_NumberOfThreads;
+}
+
+ImageFuture TaskGraph::AddImage( const Image &image )
+{
+  this->CheckNotExecuting();
+
+  Task task;
+  task.m_State = Succeeded;
+  task.m_Image = image;
+  this->m_Tasks.push_back( task );
+  return ImageFuture( this, static_cast<unsigned int>( this->m_Tasks.size() - 1 ) );
+}
+
+ImageFuture TaskGraph::Submit( ProcessObject &filter,
+                               const TaskFunction &function,
+                               const std::vector<ImageFuture> &dependencies )
+{
+  this->CheckNotExecuting();
+
+  Task task;
+  task.m_Filter = &filter;
+  task.m_Function = function;
+  for ( size_t i = 0; i < dependencies.size(); ++i )
+    {
+    this->CheckFuture( dependencies[i] );
+    task.m_Dependencies.push_back( dependencies[i].m_Task );
+    }
+  this->m_Tasks.push_back( task );
+  return ImageFuture( this, static_cast<unsigned int>( this->m_Tasks.size() - 1 ) );
+}
+
+unsigned int TaskGraph::GetNumberOfTasks() const
+{
+  return static_cast<unsigned int>( this->m_Tasks.size() );
+}
+
+void TaskGraph::Clear()
+{
+  this->CheckNotExecuting();
+  this->m_Tasks.clear();
+}
+
+bool TaskGraph::IsExecuting() const
+{
+  LockHolder lock( this->m_Synchronization->m_Lock );
+  return this->m_Synchronization->m_Executing;
+}
+
+void TaskGraph::CheckNotExecuting() const
+{
+  if ( this->IsExecuting() )
+    {
+    sitkExceptionMacro( "The TaskGraph can not be modified while executing!" );
+    }
+}
+
+void TaskGraph::CheckFuture( const ImageFuture &future ) const
+{
+  if ( future.m_Graph != this || future.m_Task >= this->m_Tasks.size() )
+    {
+    sitkExceptionMacro( "The future does not refer to a task of this TaskGraph!" );
+    }
+}
+
+void TaskGraph::Execute()
+{
+  if ( Pipeline::GetRecordingPipeline() != NULL )
+    {
+    sitkExceptionMacro( "A TaskGraph can not be executed while a Pipeline is recording!" );
+    }
+
+  unsigned int numberOfPendingTasks = 0;
+  for ( size_t i = 0; i < this->m_Tasks.size(); ++i )
+    {
+    numberOfPendingTasks += ( this->m_Tasks[i].m_State == Pending );
+    }
+  if ( numberOfPendingTasks == 0 )
+    {
+    return;
+    }
+
+  unsigned int numberOfThreads = this->m_NumberOfThreads;
+  if ( numberOfThreads == 0 )
+    {
+    numberOfThreads = ThreadPool::GetNumberOfThreads();
+    }
+  if ( numberOfThreads == 0 )
+    {
+    numberOfThreads = ProcessObject::GetGlobalDefaultNumberOfThreads();
+    }
+  numberOfThreads = std::max( 1u, std::min( numberOfThreads, numberOfPendingTasks ) );
+
+  {
+  LockHolder lock( this->m_Synchronization->m_Lock );
+  if ( this->m_Synchronization->m_Executing )
+    {
+    sitkExceptionMacro( "The TaskGraph is already executing!" );
+    }
+  this->m_Synchronization->m_Executing = true;
+  this->m_Synchronization->m_BusyFilters.clear();
+  this->m_Synchronization->m_NumberOfRunningTasks = 0;
+  }
+
+  try
+    {
+    if ( numberOfThreads == 1 )
+      {
+      this->ExecuteTasks();
+      }
+    else
+      {
+      itk::MultiThreader::Pointer threader = itk::MultiThreader::New();
+      threader->SetNumberOfThreads( numberOfThreads );
+      threader->SetSingleMethod( TaskGraphThreader::ExecuteTasksCallback, this );
+      threader->SingleMethodExecute();
+      }
+    }
+  catch ( ... )
+    {
+    LockHolder lock( this->m_Synchronization->m_Lock );
+    this->m_Synchronization->m_Executing = false;
+    throw;
+    }
+
+  LockHolder lock( this->m_Synchronization->m_Lock );
+  this->m_Synchronization->m_Executing = false;
+}
+
+bool TaskGraph::FindReadyTask( unsigned int &readyTask )
+{
+  for ( size_t i = 0; i < this->m_Tasks.size(); ++i )
+    {
+    Task &task = this->m_Tasks[i];
+    if ( task.m_State != Pending )
+      {
+      continue;
+      }
+
+    bool ready = true;
+    for ( size_t j = 0; j < task.m_Dependencies.size(); ++j )
+      {
+      const Task &dependency = this->m_Tasks[task.m_Dependencies[j]];
+      if ( dependency.m_State == Failed )
+        {
+        task.m_State = Failed;
+        task.m_Error = "A dependency failed: " + dependency.m_Error;
+        ready = false;
+        break;
+        }
+      ready = ready && ( dependency.m_State == Succeeded );
+      }
+
+    if ( ready && !this->m_Synchronization->m_BusyFilters.count( task.m_Filter ) )
+      {
+      readyTask = static_cast<unsigned int>( i );
+      return true;
+      }
+    }
+  return false;
+}
+
+void TaskGraph::ExecuteTasks()
+{
+  Synchronization &sync = *this->m_Synchronization;
+
+  LockHolder lock( sync.m_Lock );
+  while ( true )
+    {
+    unsigned int t = 0;
+    if ( !this->FindReadyTask( t ) )
+      {
+      bool pending = false;
+      for ( size_t i = 0; i < this->m_Tasks.size() && !pending; ++i )
+        {
+        pending = ( this->m_Tasks[i].m_State == Pending );
+        }
+
+      // the pending tasks wait for running tasks, or depend on tasks
+      // which will not complete
+      if ( !pending || sync.m_NumberOfRunningTasks == 0 )
+        {
+        sync.m_Condition->Broadcast();
+        return;
+        }
+      sync.m_Condition->Wait( &sync.m_Lock );
+      continue;
+      }
+
+    Task &task = this->m_Tasks[t];
+    task.m_State = Running;
+    sync.m_BusyFilters.insert( task.m_Filter );
+    ++sync.m_NumberOfRunningTasks;
+
+    // Each task gets its own ITK images, sharing the pixel buffers,
+    // so that the pipelines of concurrent filters do not update the
+    // regions of the same image.
+    std::vector<Image> inputs;
+    for ( size_t j = 0; j < task.m_Dependencies.size(); ++j )
+      {
+      inputs.push_back( this->m_Tasks[task.m_Dependencies[j]].m_Image );
+      inputs.back().MakeUniqueMetaData();
+      }
+    TaskFunction function = task.m_Function;
+
+    sync.m_Lock.Unlock();
+
+    Image output;
+    std::string error;
+    try
+      {
+      output = function( inputs );
+      }
+    catch ( std::exception &e )
+      {
+      error = e.what();
+      }
+    catch ( ... )
+      {
+      error = "Unknown exception while executing task.";
+      }
+    inputs.clear();
+
+    sync.m_Lock.Lock();
+
+    Task &done = this->m_Tasks[t];
+    done.m_State = error.empty() ? Succeeded : Failed;
+    done.m_Error = error;
+    done.m_Image = output;
+    sync.m_BusyFilters.erase( done.m_Filter );
+    --sync.m_NumberOfRunningTasks;
+
+    sync.m_Condition->Broadcast();
+    }
+}
+
+} // end namespace simple
+} // end namespace itk
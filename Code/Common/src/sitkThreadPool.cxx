@@ -0,0 +1,199 @@
+/*=========================================================================
+*
+*  Copyright Insight Software Consortium
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*         http://www.apache.org/licenses/LICENSE-2.0.txt
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*=========================================================================*/
+#include "sitkThreadPool.h"
+#include "sitkProcessObject.h"
+
+#include "itkMultiThreader.h"
+#include "itkThreadPool.h"
+#include "itkSimpleFastMutexLock.h"
+#include "itkMutexLockHolder.h"
+
+#include <algorithm>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace itk
+{
+namespace simple
+{
+
+namespace
+{
+
+typedef itk::MutexLockHolder<itk::SimpleFastMutexLock> LockHolder;
+
+static itk::SimpleFastMutexLock ThreadsLock;
+
+static unsigned int PoolNumberOfThreads = 0;
+static unsigned int NumberOfThreadsStarted = 0;
+static unsigned int NumberOfThreadsInUse = 0;
+static bool ShareThreads = false;
+
+// Must be called holding the lock.
+unsigned int GetPoolSize()
+{
+  return PoolNumberOfThreads ? PoolNumberOfThreads : ProcessObject::GetGlobalDefaultNumberOfThreads();
+}
+
+// Must be called holding the lock.
+void StartThreads()
+{
+  const unsigned int n = GetPoolSize();
+  if ( n > NumberOfThreadsStarted )
+    {
+    itk::ThreadPool::GetInstance()->AddThreads( n - NumberOfThreadsStarted );
+    NumberOfThreadsStarted = n;
+    }
+}
+
+}
+
+
+void ThreadPool::Enable()
+{
+  ThreadPool::SetEnabled( true );
+}
+
+void ThreadPool::Disable()
+{
+  ThreadPool::SetEnabled( false );
+}
+
+void ThreadPool::SetEnabled( bool flag )
+{
+  itk::MultiThreader::SetGlobalDefaultUseThreadPool( flag );
+  if ( flag )
+    {
+    LockHolder lock( ThreadsLock );
+    StartThreads();
+    }
+}
+
+bool ThreadPool::IsEnabled()
+{
+  return itk::MultiThreader::GetGlobalDefaultUseThreadPool();
+}
+
+void ThreadPool::SetNumberOfThreads( unsigned int n )
+{
+  LockHolder lock( ThreadsLock );
+  PoolNumberOfThreads = n;
+  if ( itk::MultiThreader::GetGlobalDefaultUseThreadPool() )
+    {
+    StartThreads();
+    }
+}
+
+unsigned int ThreadPool::GetNumberOfThreads()
+{
+  LockHolder lock( ThreadsLock );
+  return PoolNumberOfThreads;
+}
+
+void ThreadPool::SetShareThreads( bool flag )
+{
+  LockHolder lock( ThreadsLock );
+  ShareThreads = flag;
+}
+
+bool ThreadPool::GetShareThreads()
+{
+  LockHolder lock( ThreadsLock );
+  return ShareThreads;
+}
+
+unsigned int ThreadPool::GetNumberOfThreadsInUse()
+{
+  LockHolder lock( ThreadsLock );
+  return NumberOfThreadsInUse;
+}
+
+bool ThreadPool::SetProcessorAffinity( const std::vector<unsigned int> &processors )
+{
+#if defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO( &set );
+  if ( processors.empty() )
+    {
+    for ( unsigned int i = 0; i < CPU_SETSIZE; ++i )
+      {
+      CPU_SET( i, &set );
+      }
+    }
+  for ( size_t i = 0; i < processors.size(); ++i )
+    {
+    if ( processors[i] >= CPU_SETSIZE )
+      {
+      return false;
+      }
+    CPU_SET( processors[i], &set );
+    }
+  return sched_setaffinity( 0, sizeof( set ), &set ) == 0;
+#else
+  (void)processors;
+  return false;
+#endif
+}
+
+std::vector<unsigned int> ThreadPool::GetProcessorAffinity()
+{
+  std::vector<unsigned int> processors;
+#if defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO( &set );
+  if ( sched_getaffinity( 0, sizeof( set ), &set ) == 0 )
+    {
+    for ( unsigned int i = 0; i < CPU_SETSIZE; ++i )
+      {
+      if ( CPU_ISSET( i, &set ) )
+        {
+        processors.push_back( i );
+        }
+      }
+    }
+#endif
+  return processors;
+}
+
+unsigned int ThreadPool::AcquireThreads( unsigned int requested )
+{
+  requested = std::max( requested, 1u );
+
+  LockHolder lock( ThreadsLock );
+  if ( ShareThreads )
+    {
+    // a filter always gets one thread to progress, even if the other
+    // executions use all the threads of the pool
+    const unsigned int size = GetPoolSize();
+    const unsigned int available = ( size > NumberOfThreadsInUse ) ? size - NumberOfThreadsInUse : 0u;
+    requested = std::max( std::min( requested, available ), 1u );
+    }
+  NumberOfThreadsInUse += requested;
+  return requested;
+}
+
+void ThreadPool::ReleaseThreads( unsigned int n )
+{
+  LockHolder lock( ThreadsLock );
+  NumberOfThreadsInUse -= std::min( n, NumberOfThreadsInUse );
+}
+
+} // end namespace simple
+} // end namespace itk
@@ -24,6 +24,10 @@
 #include "sitkMemberFunctionFactory.h"
 
 namespace itk {
+#ifndef SWIG
+  class MetaDataDictionary;
+#endif
+
   namespace simple {
 
     /** \class ImageFileReader
@@ -52,7 +56,100 @@ namespace itk {
 
       Image Execute();
 
+      /** \brief Set/Get the number of pieces the image is read in,
+       * and the maximum bytes of a piece.
+       *
+       * When the file's ImageIO supports streamed reading, the image
+       * is read in this number of pieces, or more so that no piece
+       * exceeds the maximum memory, which bounds the additional
+       * memory used by the ImageIO for conversion buffers. The whole
+       * image is returned. The default is 1 piece and no maximum.
+       * @{ */
+      SITK_RETURN_SELF_TYPE_HEADER SetNumberOfStreamDivisions( unsigned int n )
+        {
+          ProcessObject::SetNumberOfStreamDivisions( n );
+          return *this;
+        }
+      SITK_RETURN_SELF_TYPE_HEADER SetMaximumMemory( uint64_t bytes )
+        {
+          ProcessObject::SetMaximumMemory( bytes );
+          return *this;
+        }
+      /** @} */
+
+      /** \brief Read only the image information from the file.
+       *
+       * The header of the file is read to update the image
+       * information available from the "Get" methods below. The
+       * pixels are not read, nor is an image buffer allocated. The
+       * information is also updated when Execute is called.
+       */
+      void ReadImageInformation( void );
+
+      /** \brief Image information from the most recently read
+       * file.
+       *
+       * The pixel type is the type of the image in the file, which
+       * is the type returned by Execute when the OutputPixelType is
+       * sitkUnknown.
+       *
+       * These values are valid after ReadImageInformation or Execute
+       * has been called.
+       * @{
+       */
+      PixelIDValueEnum GetPixelID( void ) const;
+      PixelIDValueType GetPixelIDValue( void ) const;
+      unsigned int GetDimension( void ) const;
+      unsigned int GetNumberOfComponents( void ) const;
+      const std::vector<double> &GetOrigin( void ) const;
+      const std::vector<double> &GetSpacing( void ) const;
+      const std::vector<double> &GetDirection( void ) const;
+      const std::vector<unsigned int> &GetSize( void ) const;
+      /** @} */
+
+      /** \brief Access the meta-data dictionary of the most recently
+       * read file.
+       *
+       * These methods behave the same as the meta-data methods of the
+       * Image class, and are valid after ReadImageInformation or
+       * Execute has been called.
+       * @{
+       */
+      std::vector<std::string> GetMetaDataKeys( void ) const;
+      bool HasMetaDataKey( const std::string &key ) const;
+      std::string GetMetaData( const std::string &key ) const;
+      /** @} */
+
+      /** \brief Set/Get the size of the region to extract from the file.
+       *
+       * By default the extract size is empty, and the entire image is
+       * read. When specified, the length of the size must match the
+       * dimension of the image in the file, and only the region
+       * starting at the ExtractIndex with this size is returned by
+       * Execute. If the ImageIO and the file format support streaming,
+       * then only the needed portion of the file is read.
+       *
+       * The returned image has a zero starting index, and the origin
+       * is set to the physical location of the ExtractIndex.
+       * @{
+       */
+      SITK_RETURN_SELF_TYPE_HEADER SetExtractSize( const std::vector<unsigned int> &size );
+      const std::vector<unsigned int> &GetExtractSize( ) const;
+      /** @} */
+
+      /** \brief Set/Get the starting index of the region to extract
+       * from the file.
+       *
+       * An empty index is the same as an index of all zeros. The index
+       * is only used when the ExtractSize is specified.
+       * @{
+       */
+      SITK_RETURN_SELF_TYPE_HEADER SetExtractIndex( const std::vector<int> &index );
+      const std::vector<int> &GetExtractIndex( ) const;
+      /** @} */
+
       ImageFileReader();
+      virtual ~ImageFileReader();
 
     protected:
 
@@ -60,6 +157,9 @@ namespace itk {
 
     private:
 
+      // Update the image information members from the ImageIO
+      void UpdateImageInformationFromImageIO( itk::ImageIOBase *iobase );
+
       // function pointer type
       typedef Image (Self::*MemberFunctionType)( itk::ImageIOBase * );
 
@@ -68,6 +168,19 @@ namespace itk {
       nsstd::auto_ptr<detail::MemberFunctionFactory<MemberFunctionType> > m_MemberFactory;
 
       std::string m_FileName;
+
+      std::vector<unsigned int> m_ExtractSize;
+      std::vector<int> m_ExtractIndex;
+
+      // image information updated by ReadImageInformation
+      PixelIDValueEnum m_PixelType;
+      unsigned int m_Dimension;
+      unsigned int m_NumberOfComponents;
+      std::vector<double> m_Origin;
+      std::vector<double> m_Spacing;
+      std::vector<double> m_Direction;
+      std::vector<unsigned int> m_Size;
+      nsstd::auto_ptr<MetaDataDictionary> m_MetaDataDictionary;
     };
 
   /**
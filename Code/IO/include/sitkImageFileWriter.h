@@ -91,6 +91,44 @@ class SmartPointer;
       SITK_RETURN_SELF_TYPE_HEADER KeepOriginalImageUIDOff( void ) { return this->SetKeepOriginalImageUID(false); }
       /** @} */
 
+      /** \brief Set/Get the number of pieces the image is divided
+       * into when writing, and the maximum bytes of a piece.
+       *
+       * When the file's ImageIO supports streamed writing, such as
+       * MetaImage, the image is written in this number of pieces, or
+       * more so that no piece exceeds the maximum memory, which
+       * bounds the additional memory used by the ImageIO for
+       * conversion and compression buffers. Otherwise the whole image
+       * is written at once. The default is 1 piece and no maximum.
+       * @{ */
+      SITK_RETURN_SELF_TYPE_HEADER SetNumberOfStreamDivisions( unsigned int n )
+        {
+          ProcessObject::SetNumberOfStreamDivisions( n );
+          return *this;
+        }
+      SITK_RETURN_SELF_TYPE_HEADER SetMaximumMemory( uint64_t bytes )
+        {
+          ProcessObject::SetMaximumMemory( bytes );
+          return *this;
+        }
+      /** @} */
+
+      /** \brief Set/Get the index in the file where the image is
+       * pasted.
+       *
+       * By default the paste index is empty and the whole file is
+       * written. When specified, Execute writes the image into the
+       * region of an existing file starting at this index, without
+       * rewriting the rest of the file. The file must exist with the
+       * same number of dimensions and pixel type as the image, the
+       * image must fit inside the file, and the ImageIO must support
+       * streamed writing. The origin, spacing and direction of the
+       * file are not changed.
+       * @{ */
+      SITK_RETURN_SELF_TYPE_HEADER SetPasteIndex( const std::vector<int> &index );
+      const std::vector<int> &GetPasteIndex( void ) const;
+      /** @} */
+
       SITK_RETURN_SELF_TYPE_HEADER SetFileName ( const std::string &fileName );
       std::string GetFileName() const;
 
@@ -106,6 +144,7 @@ class SmartPointer;
       bool m_UseCompression;
       std::string m_FileName;
       bool m_KeepOriginalImageUID;
+      std::vector<int> m_PasteIndex;
 
       // function pointer type
       typedef Self& (Self::*MemberFunctionType)( const Image& );
@@ -40,6 +40,10 @@ namespace itk {
      * Once the image series is read the meta-data is directly
      * accessible from the reader.
      *
+     * The files of the series are decoded concurrently, directly into
+     * the output image. The number of threads used is set with
+     * SetNumberOfThreads.
+     *
      * \sa itk::simple::ReadImage for the procedural interface
      **/
     class SITKIO_EXPORT ImageSeriesReader
@@ -35,7 +35,7 @@ namespace itk {
      * image class. It creates a SimpleITK image which shares the bulk
      * data buffer as what is set. SimpleITK will not responsible to
      * delete the buffer afterwards, and it buffer must remain valid
-     * while in use.
+     * while in use, unless a buffer release callback is set.
      *
      * \sa itk::simple::ImportAsInt8, itk::simple::ImportAsUInt8,
      * itk::simple::ImportAsInt16, itk::simple::ImportAsUInt16,
@@ -80,6 +80,19 @@ namespace itk {
       SITK_RETURN_SELF_TYPE_HEADER SetBufferAsFloat( float * buffer, unsigned int numberOfComponents = 1 );
       SITK_RETURN_SELF_TYPE_HEADER SetBufferAsDouble( double * buffer, unsigned int numberOfComponents = 1 );
 
+#ifndef SWIG
+      /** \brief Set a function to be called when the imported buffer
+       * is no longer used.
+       *
+       * By default SimpleITK does not manage the imported buffer. When
+       * a callback is set, it is called with clientData once the last
+       * image sharing the buffer of an Execute's output is destroyed,
+       * so the owner of the buffer may release it. Setting the
+       * callback to NULL disables it.
+       */
+      SITK_RETURN_SELF_TYPE_HEADER SetBufferReleaseCallback( void (*callback)(void *), void *clientData );
+#endif
+
       Image Execute();
 
     protected:
@@ -116,6 +129,9 @@ namespace itk {
 
       void        * m_Buffer;
 
+      void       (* m_BufferReleaseCallback)(void *);
+      void        * m_BufferReleaseClientData;
+
     };
 
   Image SITKIO_EXPORT ImportAsInt8(
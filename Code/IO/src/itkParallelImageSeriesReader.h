@@ -0,0 +1,101 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkParallelImageSeriesReader_h
+#define itkParallelImageSeriesReader_h
+
+#include "itkImageSeriesReader.h"
+#include "itkMultiThreader.h"
+
+#include <string>
+#include <vector>
+
+namespace itk
+{
+/** \class ParallelImageSeriesReader
+ * \brief Reads a series of image files, decoding the files
+ * concurrently.
+ *
+ * When the output image has more dimensions than the files in the
+ * series, each file is read by an ImageFileReader directly into its
+ * slice of the preallocated output buffer. The files are divided
+ * into contiguous blocks which are read by the filter's number of
+ * threads.
+ *
+ * The output information, the order of the files, and the meta-data
+ * dictionary array are the same as the ImageSeriesReader. When only
+ * one thread is used, or a sub-region of the output is requested, the
+ * ImageSeriesReader implementation is used.
+ *
+ * \ingroup IOFilters
+ */
+template< class TOutputImage >
+class ITK_EXPORT ParallelImageSeriesReader:
+  public ImageSeriesReader< TOutputImage >
+{
+public:
+  /** Standard class typedefs. */
+  typedef ParallelImageSeriesReader         Self;
+  typedef ImageSeriesReader< TOutputImage > Superclass;
+  typedef SmartPointer< Self >              Pointer;
+  typedef SmartPointer< const Self >        ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ParallelImageSeriesReader, ImageSeriesReader);
+
+  /** The size of the output image. */
+  typedef TOutputImage                                OutputImageType;
+  typedef typename OutputImageType::RegionType        ImageRegionType;
+  typedef typename OutputImageType::InternalPixelType OutputImagePixelType;
+
+  typedef typename Superclass::DictionaryType DictionaryType;
+
+protected:
+  ParallelImageSeriesReader() {}
+  // ~ParallelImageSeriesReader() {} default ok
+
+  /** Read the files in parallel when possible, otherwise use the
+   * ImageSeriesReader implementation. */
+  virtual void GenerateData() ITK_OVERRIDE;
+
+  /** Read the files with index in [begin, end) into the output's
+   * buffer. */
+  void ReadSlices( SizeValueType begin, SizeValueType end, ThreadIdType threadId );
+
+  /** Static function used as a "callback" by the MultiThreader. */
+  static ITK_THREAD_RETURN_TYPE ReadSlicesThreaderCallback( void *arg );
+
+private:
+  ParallelImageSeriesReader(const Self &); //purposely not implemented
+  void operator=(const Self &);            //purposely not implemented
+
+  // The region read from each file
+  ImageRegionType m_SliceRegion;
+
+  // Error message of an exception caught in each thread
+  std::vector< std::string > m_ThreadErrors;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkParallelImageSeriesReader.hxx"
+#endif
+
+#endif
@@ -0,0 +1,203 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkParallelImageSeriesReader_hxx
+#define itkParallelImageSeriesReader_hxx
+
+#include "itkParallelImageSeriesReader.h"
+#include "itkImageFileReader.h"
+#include "itkProgressReporter.h"
+
+#include <algorithm>
+
+namespace itk
+{
+
+template< class TOutputImage >
+void
+ParallelImageSeriesReader< TOutputImage >
+::GenerateData()
+{
+  TOutputImage *output = this->GetOutput();
+
+  const ImageRegionType requestedRegion = output->GetRequestedRegion();
+  const ImageRegionType largestRegion = output->GetLargestPossibleRegion();
+
+  const SizeValueType numberOfFiles = this->m_FileNames.size();
+  const ThreadIdType  numberOfThreads =
+    static_cast< ThreadIdType >( std::min< SizeValueType >( this->GetNumberOfThreads(), numberOfFiles ) );
+
+  if ( numberOfThreads <= 1
+       || this->m_NumberOfDimensionsInImage >= static_cast< int >( TOutputImage::ImageDimension )
+       || requestedRegion != largestRegion )
+    {
+    Superclass::GenerateData();
+    return;
+    }
+
+  // Each file is read into a slice of the output
+  this->m_SliceRegion = largestRegion;
+  this->m_SliceRegion.SetSize( this->m_NumberOfDimensionsInImage, 1 );
+  this->m_SliceRegion.SetIndex( this->m_NumberOfDimensionsInImage, 0 );
+
+  output->SetBufferedRegion( requestedRegion );
+  output->Allocate();
+
+  // The dictionaries are allocated before reading so that each
+  // thread fills in the entries of its files, in the order of the
+  // files.
+  for ( size_t i = 0; i < this->m_MetaDataDictionaryArray.size(); ++i )
+    {
+    delete this->m_MetaDataDictionaryArray[i];
+    }
+  this->m_MetaDataDictionaryArray.clear();
+  if ( this->GetMetaDataDictionaryArrayUpdate() )
+    {
+    for ( SizeValueType i = 0; i < numberOfFiles; ++i )
+      {
+      this->m_MetaDataDictionaryArray.push_back( new DictionaryType );
+      }
+    }
+
+  this->m_ThreadErrors.assign( numberOfThreads, std::string() );
+
+  this->GetMultiThreader()->SetNumberOfThreads( numberOfThreads );
+  this->GetMultiThreader()->SetSingleMethod( Self::ReadSlicesThreaderCallback, this );
+  this->GetMultiThreader()->SingleMethodExecute();
+
+  for ( ThreadIdType i = 0; i < numberOfThreads; ++i )
+    {
+    if ( !this->m_ThreadErrors[i].empty() )
+      {
+      itkExceptionMacro( << this->m_ThreadErrors[i] );
+      }
+    }
+}
+
+
+template< class TOutputImage >
+ITK_THREAD_RETURN_TYPE
+ParallelImageSeriesReader< TOutputImage >
+::ReadSlicesThreaderCallback( void *arg )
+{
+  typedef MultiThreader::ThreadInfoStruct ThreadInfoType;
+
+  ThreadInfoType *threadInfo = static_cast< ThreadInfoType * >( arg );
+  const ThreadIdType threadId = threadInfo->ThreadID;
+  const ThreadIdType threadCount = threadInfo->NumberOfThreads;
+  Self *self = static_cast< Self * >( threadInfo->UserData );
+
+  // divide the files into contiguous blocks
+  const SizeValueType numberOfFiles = self->m_FileNames.size();
+  const SizeValueType begin = ( numberOfFiles * threadId ) / threadCount;
+  const SizeValueType end = ( numberOfFiles * ( threadId + 1 ) ) / threadCount;
+
+  // exceptions can not be propagated out of the spawned threads
+  try
+    {
+    self->ReadSlices( begin, end, threadId );
+    }
+  catch ( ExceptionObject & e )
+    {
+    self->m_ThreadErrors[threadId] = e.GetDescription();
+    }
+  catch ( std::exception & e )
+    {
+    self->m_ThreadErrors[threadId] = e.what();
+    }
+  catch ( ... )
+    {
+    self->m_ThreadErrors[threadId] = "Unknown exception while reading series.";
+    }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+
+template< class TOutputImage >
+void
+ParallelImageSeriesReader< TOutputImage >
+::ReadSlices( SizeValueType begin, SizeValueType end, ThreadIdType threadId )
+{
+  typedef ImageFileReader< TOutputImage > ReaderType;
+
+  TOutputImage *output = this->GetOutput();
+
+  const SizeValueType numberOfFiles = this->m_FileNames.size();
+  const SizeValueType sliceBufferSize = output->GetPixelContainer()->Size() / numberOfFiles;
+  OutputImagePixelType *outputBuffer = output->GetBufferPointer();
+
+  // progress is only reported by the first thread
+  ProgressReporter progress( this, threadId, end - begin, 100 );
+
+  for ( SizeValueType i = begin; i < end; ++i )
+    {
+    const SizeValueType iFileName = ( this->m_ReverseOrder ? numberOfFiles - i - 1 : i );
+
+    typename ReaderType::Pointer reader = ReaderType::New();
+    reader->SetFileName( this->m_FileNames[iFileName].c_str() );
+    if ( this->m_ImageIO )
+      {
+      ImageIOBase::Pointer imageIO = dynamic_cast< ImageIOBase * >( this->m_ImageIO->CreateAnother().GetPointer() );
+      reader->SetImageIO( imageIO );
+      }
+    reader->SetUseStreaming( this->m_UseStreaming );
+    reader->ReleaseDataBeforeUpdateFlagOff();
+
+    TOutputImage *readerOutput = reader->GetOutput();
+    readerOutput->SetRequestedRegion( this->m_SliceRegion );
+    readerOutput->UpdateOutputInformation();
+
+    if ( readerOutput->GetLargestPossibleRegion().GetSize() != this->m_SliceRegion.GetSize() )
+      {
+      itkExceptionMacro( << "Size mismatch! The size of  "
+                         << this->m_FileNames[iFileName]
+                         << " is "
+                         << readerOutput->GetLargestPossibleRegion().GetSize()
+                         << " and does not match the required size "
+                         << this->m_SliceRegion.GetSize()
+                         << " from file "
+                         << this->m_FileNames[this->m_ReverseOrder ? numberOfFiles - 1 : 0] );
+      }
+
+    readerOutput->PropagateRequestedRegion();
+
+    // The reader decodes directly into the slice of the output
+    // buffer, which is not managed by the reader's container.
+    OutputImagePixelType *sliceBuffer = outputBuffer + i * sliceBufferSize;
+    readerOutput->GetPixelContainer()->SetImportPointer( sliceBuffer, sliceBufferSize, false );
+    readerOutput->UpdateOutputData();
+
+    if ( readerOutput->GetBufferPointer() != sliceBuffer )
+      {
+      // the reader allocated its own buffer
+      const OutputImagePixelType *readerBuffer = readerOutput->GetBufferPointer();
+      std::copy( readerBuffer, readerBuffer + sliceBufferSize, sliceBuffer );
+      }
+
+    if ( this->GetMetaDataDictionaryArrayUpdate() )
+      {
+      *this->m_MetaDataDictionaryArray[i] = reader->GetImageIO()->GetMetaDataDictionary();
+      }
+
+    progress.CompletedPixel();
+    }
+}
+
+} // end namespace itk
+
+#endif
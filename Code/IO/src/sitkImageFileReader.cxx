@@ -22,6 +22,12 @@
 #include "sitkImageFileReader.h"
 
 #include <itkImageFileReader.h>
+#include <itkExtractImageFilter.h>
+#include <itkStreamingImageFilter.h>
+#include <itkNumericTraitsVariableLengthVectorPixel.h>
+#include <itkMetaDataObject.h>
+
+#include <algorithm>
 
 
 namespace itk {
@@ -34,6 +40,10 @@ namespace itk {
     }
 
     ImageFileReader::ImageFileReader()
+      : m_PixelType( sitkUnknown ),
+        m_Dimension( 0 ),
+        m_NumberOfComponents( 0 ),
+        m_MetaDataDictionary( new MetaDataDictionary() )
       {
       // list of pixel types supported
       typedef NonLabelPixelIDTypeList PixelIDTypeList;
@@ -45,6 +55,10 @@ namespace itk {
       this->m_MemberFactory->RegisterMemberFunctions< PixelIDTypeList, 2 > ();
       }
 
+    ImageFileReader::~ImageFileReader()
+      {
+      }
+
     std::string ImageFileReader::ToString() const {
 
       std::ostringstream out;
@@ -52,6 +66,8 @@ namespace itk {
       out << std::endl;
       out << "  FileName: \"";
       this->ToStringHelper(out, this->m_FileName) << "\"" << std::endl;
+      out << "  ExtractSize: " << this->m_ExtractSize << std::endl;
+      out << "  ExtractIndex: " << this->m_ExtractIndex << std::endl;
 
       out << ImageReaderBase::ToString();
       return out.str();
@@ -66,22 +82,126 @@ namespace itk {
       return this->m_FileName;
     }
 
-    Image ImageFileReader::Execute () {
+    ImageFileReader& ImageFileReader::SetExtractSize( const std::vector<unsigned int> &size ) {
+      this->m_ExtractSize = size;
+      return *this;
+    }
 
-      PixelIDValueType type = this->GetOutputPixelType();
-      unsigned int dimension = 0;
+    const std::vector<unsigned int> &ImageFileReader::GetExtractSize( ) const {
+      return this->m_ExtractSize;
+    }
 
+    ImageFileReader& ImageFileReader::SetExtractIndex( const std::vector<int> &index ) {
+      this->m_ExtractIndex = index;
+      return *this;
+    }
+
+    const std::vector<int> &ImageFileReader::GetExtractIndex( ) const {
+      return this->m_ExtractIndex;
+    }
 
+    void ImageFileReader::ReadImageInformation( void ) {
       itk::ImageIOBase::Pointer imageio = this->GetImageIOBase( this->m_FileName );
-      if (type == sitkUnknown)
+      this->UpdateImageInformationFromImageIO( imageio.GetPointer() );
+    }
+
+    PixelIDValueEnum ImageFileReader::GetPixelID( void ) const {
+      return this->m_PixelType;
+    }
+
+    PixelIDValueType ImageFileReader::GetPixelIDValue( void ) const {
+      return this->m_PixelType;
+    }
+
+    unsigned int ImageFileReader::GetDimension( void ) const {
+      return this->m_Dimension;
+    }
+
+    unsigned int ImageFileReader::GetNumberOfComponents( void ) const {
+      return this->m_NumberOfComponents;
+    }
+
+    const std::vector<double> &ImageFileReader::GetOrigin( void ) const {
+      return this->m_Origin;
+    }
+
+    const std::vector<double> &ImageFileReader::GetSpacing( void ) const {
+      return this->m_Spacing;
+    }
+
+    const std::vector<double> &ImageFileReader::GetDirection( void ) const {
+      return this->m_Direction;
+    }
+
+    const std::vector<unsigned int> &ImageFileReader::GetSize( void ) const {
+      return this->m_Size;
+    }
+
+    std::vector<std::string> ImageFileReader::GetMetaDataKeys( void ) const {
+      return this->m_MetaDataDictionary->GetKeys();
+    }
+
+    bool ImageFileReader::HasMetaDataKey( const std::string &key ) const {
+      return this->m_MetaDataDictionary->HasKey( key );
+    }
+
+    std::string ImageFileReader::GetMetaData( const std::string &key ) const {
+      const MetaDataDictionary &mdd = *this->m_MetaDataDictionary;
+      std::string value;
+      if ( ExposeMetaData( mdd, key, value ) )
         {
-        this->GetPixelIDFromImageIO( imageio, type, dimension );
+        return value;
         }
-      else
+
+      std::ostringstream ss;
+      mdd.Get( key )->Print( ss );
+      return ss.str();
+    }
+
+    void ImageFileReader::UpdateImageInformationFromImageIO( itk::ImageIOBase *iobase ) {
+      PixelIDValueType pixelType;
+      unsigned int dimension;
+      this->GetPixelIDFromImageIO( iobase, pixelType, dimension );
+
+      std::vector<double> direction( dimension*dimension );
+      std::vector<double> origin( dimension );
+      std::vector<double> spacing( dimension );
+      std::vector<unsigned int> size( dimension );
+      for ( unsigned int i = 0; i < dimension; ++i )
+        {
+        origin[i] = iobase->GetOrigin( i );
+        spacing[i] = iobase->GetSpacing( i );
+        size[i] = static_cast<unsigned int>( iobase->GetDimensions( i ) );
+
+        // the ImageIO stores the direction cosines by column
+        const std::vector<double> axis = iobase->GetDirection( i );
+        for ( unsigned int j = 0; j < dimension; ++j )
+          {
+          direction[j*dimension+i] = axis[j];
+          }
+        }
+
+      this->m_PixelType = static_cast<PixelIDValueEnum>( pixelType );
+      this->m_Dimension = dimension;
+      this->m_NumberOfComponents = iobase->GetNumberOfComponents();
+      this->m_Origin.swap( origin );
+      this->m_Spacing.swap( spacing );
+      this->m_Direction.swap( direction );
+      this->m_Size.swap( size );
+      *this->m_MetaDataDictionary = iobase->GetMetaDataDictionary();
+    }
+
+    Image ImageFileReader::Execute () {
+
+      itk::ImageIOBase::Pointer imageio = this->GetImageIOBase( this->m_FileName );
+      this->UpdateImageInformationFromImageIO( imageio.GetPointer() );
+
+      PixelIDValueType type = this->GetOutputPixelType();
+      if (type == sitkUnknown)
         {
-        PixelIDValueType unused;
-        this->GetPixelIDFromImageIO( imageio, unused, dimension );
+        type = this->m_PixelType;
         }
+      const unsigned int dimension = this->m_Dimension;
 
 #ifdef SITK_4D_IMAGES
       if ( dimension != 2 && dimension != 3  && dimension != 4 )
@@ -92,6 +212,23 @@ namespace itk {
         sitkExceptionMacro( "The file has unsupported " << dimension << " dimensions." );
         }
 
+      if ( !this->m_ExtractSize.empty() && this->m_ExtractSize.size() != dimension )
+        {
+        sitkExceptionMacro( "The ExtractSize has length " << this->m_ExtractSize.size()
+                            << " but the file has " << dimension << " dimensions." );
+        }
+
+      if ( std::find( this->m_ExtractSize.begin(), this->m_ExtractSize.end(), 0u ) != this->m_ExtractSize.end() )
+        {
+        sitkExceptionMacro( "The ExtractSize " << this->m_ExtractSize << " has a zero component." );
+        }
+
+      if ( !this->m_ExtractIndex.empty() && this->m_ExtractIndex.size() != dimension )
+        {
+        sitkExceptionMacro( "The ExtractIndex has length " << this->m_ExtractIndex.size()
+                            << " but the file has " << dimension << " dimensions." );
+        }
+
       if ( !this->m_MemberFactory->HasMemberFunction( type, dimension ) )
         {
         sitkExceptionMacro( << "PixelType is not supported!" << std::endl
@@ -120,10 +257,49 @@ namespace itk {
     reader->SetFileName( this->m_FileName.c_str() );
 
     this->PreUpdate( reader.GetPointer() );
+    AcquiredThreadsReleaser releaseThreads( this );
+
+    if ( this->m_ExtractSize.empty() )
+      {
+      // streamed reading bounds the buffers of the ImageIO
+      typename ImageType::Pointer image = this->UpdateOutput( reader.GetPointer(), reader->GetOutput() );
+      image->SetMetaDataDictionary( reader->GetOutput()->GetMetaDataDictionary() );
+
+      return Image( image );
+      }
+
+    typename ImageType::RegionType region;
+    for ( unsigned int i = 0; i < ImageType::ImageDimension; ++i )
+      {
+      region.SetSize( i, this->m_ExtractSize[i] );
+      region.SetIndex( i, this->m_ExtractIndex.empty() ? 0 : this->m_ExtractIndex[i] );
+      }
+
+    reader->UpdateOutputInformation();
+    if ( !reader->GetOutput()->GetLargestPossibleRegion().IsInside( region ) )
+      {
+      sitkExceptionMacro( "The extraction region " << region
+                          << " is not inside the image's region " << reader->GetOutput()->GetLargestPossibleRegion() );
+      }
+
+    // The extractor only requests the extraction region from the
+    // reader, which streams when the ImageIO supports it. When the
+    // reader produces exactly the requested region the output is
+    // grafted without copying.
+    typedef itk::ExtractImageFilter<ImageType, ImageType> ExtractType;
+    typename ExtractType::Pointer extractor = ExtractType::New();
+    extractor->InPlaceOn();
+    extractor->SetInput( reader->GetOutput() );
+    extractor->SetDirectionCollapseToSubmatrix();
+    extractor->SetExtractionRegion( region );
+
+    typename ImageType::Pointer image = this->UpdateOutput( extractor.GetPointer(), extractor->GetOutput() );
+    image->DisconnectPipeline();
+    image->SetMetaDataDictionary( reader->GetOutput()->GetMetaDataDictionary() );
 
-    reader->Update();
+    this->FixNonZeroIndex( image.GetPointer() );
 
-    return Image( reader->GetOutput() );
+    return Image( image );
   }
 
   }
@@ -17,9 +17,11 @@
 *=========================================================================*/
 
 #include "sitkImageFileWriter.h"
+#include "sitkImageFileReader.h"
 
 #include <itkImageIOBase.h>
 #include <itkImageFileWriter.h>
+#include <itkImageIOFactory.h>
 #include <itkImageRegionIterator.h>
 #include <itkGDCMImageIO.h>
 
@@ -61,6 +63,8 @@ std::string ImageFileWriter::ToString() const
   this->ToStringHelper(out, this->m_KeepOriginalImageUID);
   out << std::endl;
 
+  out << "  PasteIndex: " << this->m_PasteIndex << std::endl;
+
   out << "  FileName: \"";
   this->ToStringHelper(out, this->m_FileName);
   out << "\"" << std::endl;
@@ -93,6 +97,18 @@ std::string ImageFileWriter::ToString() const
     return this->m_KeepOriginalImageUID;
   }
 
+  ImageFileWriter::Self&
+  ImageFileWriter::SetPasteIndex( const std::vector<int> &index )
+  {
+    this->m_PasteIndex = index;
+    return *this;
+  }
+
+  const std::vector<int> &ImageFileWriter::GetPasteIndex( void ) const
+  {
+    return this->m_PasteIndex;
+  }
+
 ImageFileWriter& ImageFileWriter::SetFileName ( const std::string &fn )
   {
   this->m_FileName = fn;
@@ -152,10 +168,91 @@ ImageFileWriter& ImageFileWriter::ExecuteInternal( const Image& inImage )
     typename Writer::Pointer writer = Writer::New();
     writer->SetUseCompression( this->m_UseCompression );
     writer->SetFileName ( this->m_FileName.c_str() );
-    writer->SetInput ( image );
     writer->SetImageIO( GetImageIOBase( this->m_FileName ).GetPointer() );
+    writer->SetNumberOfStreamDivisions(
+      this->ComputeNumberOfStreamDivisions( image->GetBufferedRegion().GetNumberOfPixels(),
+                                            image->GetNumberOfComponentsPerPixel()
+                                            * sizeof( typename InputImageType::InternalPixelType ) ) );
+
+    if ( this->m_PasteIndex.empty() )
+      {
+      writer->SetInput ( image );
+      }
+    else
+      {
+      const unsigned int dimension = InputImageType::ImageDimension;
+      if ( this->m_PasteIndex.size() != dimension )
+        {
+        sitkExceptionMacro( "The PasteIndex has length " << this->m_PasteIndex.size()
+                            << " but the image has " << dimension << " dimensions." );
+        }
+
+      // The header of the existing file defines the whole image
+      ImageFileReader fileReader;
+      fileReader.SetFileName( this->m_FileName );
+      fileReader.ReadImageInformation();
+
+      if ( fileReader.GetDimension() != dimension )
+        {
+        sitkExceptionMacro( "The file \"" << this->m_FileName << "\" has " << fileReader.GetDimension()
+                            << " dimensions but the image has " << dimension << " dimensions." );
+        }
+
+      if ( fileReader.GetPixelID() != inImage.GetPixelID() )
+        {
+        sitkExceptionMacro( "The file \"" << this->m_FileName << "\" has pixel type "
+                            << GetPixelIDValueAsString( fileReader.GetPixelID() )
+                            << " but the image has pixel type "
+                            << GetPixelIDValueAsString( inImage.GetPixelID() ) << "." );
+        }
+
+      typename InputImageType::RegionType largestRegion;
+      typename InputImageType::RegionType pasteRegion;
+      typename InputImageType::PointType origin;
+      typename InputImageType::SpacingType spacing;
+      typename InputImageType::DirectionType direction;
+      itk::ImageIORegion ioRegion( dimension );
+      for ( unsigned int i = 0; i < dimension; ++i )
+        {
+        largestRegion.SetSize( i, fileReader.GetSize()[i] );
+        largestRegion.SetIndex( i, 0 );
+        pasteRegion.SetSize( i, image->GetBufferedRegion().GetSize( i ) );
+        pasteRegion.SetIndex( i, this->m_PasteIndex[i] );
+        ioRegion.SetSize( i, pasteRegion.GetSize( i ) );
+        ioRegion.SetIndex( i, pasteRegion.GetIndex( i ) );
+
+        origin[i] = fileReader.GetOrigin()[i];
+        spacing[i] = fileReader.GetSpacing()[i];
+        for ( unsigned int j = 0; j < dimension; ++j )
+          {
+          direction[i][j] = fileReader.GetDirection()[i*dimension+j];
+          }
+        }
+
+      if ( !largestRegion.IsInside( pasteRegion ) )
+        {
+        sitkExceptionMacro( "The paste region " << pasteRegion
+                            << " is not inside the file's region " << largestRegion );
+        }
+
+      // An image which references the input's pixels as the paste
+      // region of the file's image.
+      typename InputImageType::Pointer pasteImage = InputImageType::New();
+      pasteImage->Graft( image.GetPointer() );
+      pasteImage->SetOrigin( origin );
+      pasteImage->SetSpacing( spacing );
+      pasteImage->SetDirection( direction );
+      pasteImage->SetLargestPossibleRegion( largestRegion );
+      pasteImage->SetBufferedRegion( pasteRegion );
+      pasteImage->SetRequestedRegion( pasteRegion );
+      pasteImage->SetMetaDataDictionary( image->GetMetaDataDictionary() );
+
+      writer->SetInput( pasteImage );
+      writer->SetIORegion( ioRegion );
+      }
 
     this->PreUpdate( writer.GetPointer() );
+    AcquiredThreadsReleaser releaseThreads( this );
 
     writer->Update();
 
@@ -22,7 +22,7 @@
 #include "sitkImageSeriesReader.h"
 
 #include <itkImageIOBase.h>
-#include <itkImageSeriesReader.h>
+#include "itkParallelImageSeriesReader.h"
 
 #include "itkGDCMSeriesFileNames.h"
 
@@ -118,6 +118,8 @@ namespace itk {
 
   Image ImageSeriesReader::Execute ()
     {
+    this->CheckStreamingNotRequested();
+
     if( this->m_FileNames.empty() )
       {
       sitkExceptionMacro( "File names information is empty. Cannot read series." );
@@ -217,7 +219,7 @@ struct GetMetaDataCustomCast
     {
 
     typedef TImageType                        ImageType;
-    typedef itk::ImageSeriesReader<ImageType> Reader;
+    typedef itk::ParallelImageSeriesReader<ImageType> Reader;
 
     // if the IsInstantiated is correctly implemented this should
     // not occur
@@ -241,6 +243,7 @@ struct GetMetaDataCustomCast
 
 
     this->PreUpdate( reader.GetPointer() );
+    AcquiredThreadsReleaser releaseThreads( this );
 
     if (m_MetaDataDictionaryArrayUpdate)
       {
@@ -108,6 +108,7 @@ namespace itk {
 
   ImageSeriesWriter &ImageSeriesWriter::Execute ( const Image &image )
   {
+    this->CheckStreamingNotRequested();
 
     // check that the number of file names match the slice size
     PixelIDValueType type = image.GetPixelIDValue();
@@ -154,6 +155,7 @@ namespace itk {
     writer->SetInput( image );
 
     this->PreUpdate( writer.GetPointer() );
+    AcquiredThreadsReleaser releaseThreads( this );
 
     writer->Update();
 
@@ -24,6 +24,7 @@
 
 #include <itkImage.h>
 #include <itkVectorImage.h>
+#include <itkCommand.h>
 
 #include <iterator>
 
@@ -31,6 +32,48 @@
 namespace
 {
 const unsigned int UnusedDimension = 2;
+
+/** A command which calls a C style function once, when the observed
+ * object is deleted.
+ */
+class BufferReleaseCommand
+  : public itk::Command
+{
+public:
+  typedef BufferReleaseCommand       Self;
+  typedef itk::Command               Superclass;
+  typedef itk::SmartPointer<Self>    Pointer;
+
+  itkNewMacro( Self );
+
+  void SetCallback( void (*callback)(void *), void *clientData )
+    {
+      m_Callback = callback;
+      m_ClientData = clientData;
+    }
+
+  virtual void Execute( itk::Object *caller, const itk::EventObject &event )
+    {
+      this->Execute( (const itk::Object *)caller, event );
+    }
+
+  virtual void Execute( const itk::Object *, const itk::EventObject & )
+    {
+      if ( m_Callback )
+        {
+        void (*callback)(void *) = m_Callback;
+        m_Callback = NULL;
+        callback( m_ClientData );
+        }
+    }
+
+protected:
+  BufferReleaseCommand() : m_Callback( NULL ), m_ClientData( NULL ) {}
+
+private:
+  void (*m_Callback)(void *);
+  void *m_ClientData;
+};
 }
 
 namespace itk {
@@ -213,6 +256,8 @@ ImportImageFilter::ImportImageFilter()
   m_Origin = std::vector<double>( 3, 0.0 );
   m_Spacing = std::vector<double>( 3, 1.0 );
   this->m_Buffer = NULL;
+  this->m_BufferReleaseCallback = NULL;
+  this->m_BufferReleaseClientData = NULL;
 
   // list of pixel types supported
   typedef NonLabelPixelIDTypeList PixelIDTypeList;
@@ -411,6 +456,13 @@ ImportImageFilter::Self& ImportImageFilter::SetBufferAsDouble( double * buffer,
   return *this;
 }
 
+ImportImageFilter::Self& ImportImageFilter::SetBufferReleaseCallback( void (*callback)(void *), void *clientData )
+{
+  this->m_BufferReleaseCallback = callback;
+  this->m_BufferReleaseClientData = clientData;
+  return *this;
+}
+
 
 #define PRINT_IVAR_MACRO( VAR ) "\t" << #VAR << ": " << VAR << std::endl
 
@@ -425,7 +477,8 @@ std::string ImportImageFilter::ToString() const
       << PRINT_IVAR_MACRO( m_Spacing )
       << PRINT_IVAR_MACRO( m_Size )
       << PRINT_IVAR_MACRO( m_Direction )
-      << PRINT_IVAR_MACRO( m_Buffer );
+      << PRINT_IVAR_MACRO( m_Buffer )
+      << PRINT_IVAR_MACRO( m_BufferReleaseClientData );
   return out.str();
 }
 
@@ -433,6 +486,8 @@ Image ImportImageFilter::Execute ()
 {
   unsigned int imageDimension = this->m_Size.size();
 
+  this->CheckStreamingNotRequested();
+
   // perform sanity check on some parameters
   if (  this->m_NumberOfComponentsPerPixel == 0 || this->m_PixelIDValue == sitkUnknown )
     {
@@ -524,6 +579,15 @@ Image ImportImageFilter::ExecuteInternal( )
   //
   this->SetNumberOfComponentsOnImage( image.GetPointer() );
 
+  // Notify the owner of the buffer when the pixel container, which
+  // may be shared by many images, is deleted.
+  if ( this->m_BufferReleaseCallback )
+    {
+    BufferReleaseCommand::Pointer releaseCommand = BufferReleaseCommand::New();
+    releaseCommand->SetCallback( this->m_BufferReleaseCallback, this->m_BufferReleaseClientData );
+    image->GetPixelContainer()->AddObserver( itk::DeleteEvent(), releaseCommand );
+    }
+
   // This line must be the last line in the function to prevent a deep
   // copy caused by a implicit sitk::MakeUnique
   return Image( image );
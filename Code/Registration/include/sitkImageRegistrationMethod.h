@@ -111,9 +111,9 @@ namespace simple
      * @{
      */
     InterpolatorEnum GetInterpolator()
-      { return this->m_Interpolator; }
+      { return this->m_Settings.m_Interpolator; }
     SITK_RETURN_SELF_TYPE_HEADER SetInterpolator ( InterpolatorEnum Interpolator )
-      { this->m_Interpolator = Interpolator; return *this; }
+      { this->m_Settings.m_Interpolator = Interpolator; return *this; }
     /** @} */
 
     /** \brief Set the initial transform and parameters to optimize.
@@ -140,7 +140,7 @@ namespace simple
     Transform GetInitialTransform()
       { return this->m_InitialTransform; }
     bool GetInitialTransformInPlace() const
-    { return this->m_InitialTransformInPlace;}
+    { return this->m_Settings.m_InitialTransformInPlace;}
     /** @} */
 
     /** \brief Set a fixed transform component towards moving domain.
@@ -157,9 +157,9 @@ namespace simple
      * @{
      */
     SITK_RETURN_SELF_TYPE_HEADER SetMovingInitialTransform( const Transform &transform )
-    { this->m_MovingInitialTransform = transform; return *this; }
+    { this->m_Settings.m_MovingInitialTransform = transform; return *this; }
     Transform GetMovingInitialTransform( ) const
-    { return this->m_MovingInitialTransform; }
+    { return this->m_Settings.m_MovingInitialTransform; }
     /**@}*/
 
     /** \brief Set transform mapping to the fixed domain.
@@ -173,9 +173,9 @@ namespace simple
      * @{
      */
     SITK_RETURN_SELF_TYPE_HEADER SetFixedInitialTransform( const Transform &transform )
-    { this->m_FixedInitialTransform = transform; return *this; }
+    { this->m_Settings.m_FixedInitialTransform = transform; return *this; }
     Transform GetFixedInitialTransform( ) const
-    { return this->m_FixedInitialTransform; }
+    { return this->m_Settings.m_FixedInitialTransform; }
     /**@}*/
 
 
@@ -323,6 +323,54 @@ namespace simple
     SITK_RETURN_SELF_TYPE_HEADER SetOptimizerAsExhaustive( const std::vector<unsigned int> &numberOfSteps,
                                     double stepLength = 1.0 );
 
+    /** \brief Set the optimizer to sample the metric at regular steps
+     * in parallel.
+     *
+     * The sampling grid is the one of the Exhaustive optimizer. The
+     * grid points are evaluated as with MetricEvaluateBatch, spread
+     * over the threads of this method, each with its own metric. For
+     * small images and many grid points this is much faster than the
+     * Exhaustive optimizer, which evaluates one point at a time.
+     *
+     * The resulting transform and value at the end of execution is
+     * the best location, and the values of all the grid points are
+     * available from GetOptimizerCostSurface. Like MetricEvaluate,
+     * the shrink factors and smoothing sigmas are not used, and no
+     * iteration events are invoked.
+     *
+     * \sa SetOptimizerAsExhaustive
+     */
+    SITK_RETURN_SELF_TYPE_HEADER SetOptimizerAsParallelExhaustive( const std::vector<unsigned int> &numberOfSteps,
+                                                                   double stepLength = 1.0 );
+
+    /** \brief The metric values at the sampling grid of the last
+     * execution with the ParallelExhaustive optimizer.
+     *
+     * The axes of the image are the parameters with a non zero number
+     * of steps, and the origin and spacing are the parameters of the
+     * first grid point and the steps. The image is empty when more
+     * than 3 parameters are sampled, the values are then available
+     * from GetOptimizerCostSurfaceValues.
+     */
+    Image GetOptimizerCostSurface() const
+    { return this->m_OptimizerCostSurface; }
+
+    /** \brief The metric values and parameters of the sampling grid
+     * of the last execution with the ParallelExhaustive optimizer.
+     *
+     * The values are available for any number of sampled
+     * parameters. The grid points are in the order of the values, the
+     * first parameter varying the fastest, and the parameters holds
+     * the parameters of the transform at each grid point one after
+     * the other.
+     * @{
+     */
+    std::vector<double> GetOptimizerCostSurfaceValues() const
+    { return this->m_OptimizerCostSurfaceValues; }
+    std::vector<double> GetOptimizerCostSurfaceParameters() const
+    { return this->m_OptimizerCostSurfaceParameters; }
+    /** @} */
+
     /** \brief Set optimizer to Nelder-Mead downhill simplex algorithm.
      *
      * \sa itk::AmoebaOptimizerv4
@@ -443,15 +491,50 @@ namespace simple
     enum MetricSamplingStrategyType {
       NONE,
       REGULAR,
-      RANDOM
+      RANDOM,
+      GRADIENT_MAGNITUDE ///< Sample with a probability proportional to the fixed image gradient magnitude.
     };
 
     /** \brief Set sampling strategy for sample generation.
+     *
+     * The GRADIENT_MAGNITUDE strategy places the samples on the edges
+     * of the fixed image, so a smaller percentage of samples is
+     * needed than with random sampling. Its sample points are computed
+     * once, from the first sampling percentage, and used at all the
+     * levels.
      *
      * \sa itk::ImageRegistrationMethodv4::SetMetricSamplingStrategy
      */
     SITK_RETURN_SELF_TYPE_HEADER SetMetricSamplingStrategy( MetricSamplingStrategyType strategy);
 
+    /** \brief Set the points of the fixed image domain sampled by the
+     * metric.
+     *
+     * The points are given as a flat list of physical coordinates,
+     * such as [x0, y0, x1, y1, ...] in 2D. When set, they are
+     * sampled at all the levels of the registration, and by
+     * MetricEvaluate, instead of the sampling strategy. An empty list
+     * removes the points.
+     * @{
+     */
+    SITK_RETURN_SELF_TYPE_HEADER SetMetricSamplingPoints( const std::vector<double> &points );
+    std::vector<double> GetMetricSamplingPoints() const
+    { return this->m_Settings.m_MetricSamplingPoints; }
+    /** @} */
+
+    /** \brief Set an image mask of the fixed image pixels from which
+     * the sample points are drawn.
+     *
+     * The sampling strategy and the first sampling percentage are
+     * applied to the pixels of the fixed image inside the mask, with
+     * the NONE strategy all of them are sampled. Unlike the fixed
+     * mask, the sample points are computed once and used at all the
+     * levels of the registration, and by MetricEvaluate. The mask is
+     * expected to be in the same physical space as the fixed
+     * image. An empty image removes the mask.
+     */
+    SITK_RETURN_SELF_TYPE_HEADER SetMetricSamplingMask( const Image &binaryMask );
+
     /** \brief Enable image gradient computation by a filter.
      *
      * By default the image gradient is computed by
@@ -508,9 +591,97 @@ namespace simple
     /** @} */
 
 
+    /** \brief Cache the fixed image data across executions.
+     *
+     * When enabled, the smoothed fixed image of each level and the
+     * fixed image mask are computed once and reused by the following
+     * Execute calls with the same fixed image, fixed mask and
+     * smoothing settings. This is intended for registering many
+     * moving images to one fixed image, such as an atlas.
+     *
+     * The cached data is recomputed when the fixed image, the fixed
+     * mask or the smoothing sigmas change. SimpleITK images are copy
+     * on write, and the cache holds a reference, so a modification of
+     * the pixels of the fixed image produces a different image.
+     *
+     * By default the cache is disabled.
+     * @{
+     */
+    SITK_RETURN_SELF_TYPE_HEADER SetUseFixedImageCache(bool);
+    SITK_RETURN_SELF_TYPE_HEADER UseFixedImageCacheOn() {return this->SetUseFixedImageCache(true);}
+    SITK_RETURN_SELF_TYPE_HEADER UseFixedImageCacheOff() {return this->SetUseFixedImageCache(false);}
+    bool GetUseFixedImageCache() const { return this->m_UseFixedImageCache; }
+    /** @} */
+
+    /** \brief Release the cached fixed image data. */
+    void ClearFixedImageCache();
+
+    /** \brief The number of executions which reused the cached
+     * smoothed fixed images since the cache was cleared. */
+    uint64_t GetNumberOfFixedImageCacheHits() const;
+
+
     /** \brief Optimize the configured registration problem. */
     Transform Execute ( const Image &fixed, const Image & moving );
 
+    /** \brief Register each moving image to the fixed image.
+     *
+     * The registrations are configured as for Execute, and are
+     * executed concurrently with the threads of this method divided
+     * between them. The smoothed fixed images and the fixed mask are
+     * computed once and shared by all the registrations, as with the
+     * fixed image cache.
+     *
+     * Each registration starts from its own copy of the
+     * InitialTransform, which is not modified, and the transform of
+     * each registration is returned in the order of the moving
+     * images. The stop condition, final metric value and number of
+     * iterations of each registration are available after execution.
+     *
+     * Commands added to this method are not invoked by the
+     * registrations of the batch. If a registration fails the others
+     * complete, then an exception is thrown.
+     */
+    std::vector<Transform> ExecuteBatch ( const Image &fixed, const std::vector<Image> &movingImages );
+
+    /** \brief Set the number of registrations ExecuteBatch executes
+     * at the same time.
+     *
+     * The threads of this method are divided between the concurrent
+     * registrations. The default, 0, executes one registration for
+     * every 4 threads.
+     * @{
+     */
+    SITK_RETURN_SELF_TYPE_HEADER SetNumberOfConcurrentRegistrations( unsigned int n )
+    { this->m_NumberOfConcurrentRegistrations = n; return *this; }
+    unsigned int GetNumberOfConcurrentRegistrations() const
+    { return this->m_NumberOfConcurrentRegistrations; }
+    /** @} */
+
+    /** Measurements of each registration of the last ExecuteBatch.
+     * @{
+     */
+    std::vector<std::string> GetBatchOptimizerStopConditionDescriptions() const
+    { return this->m_BatchStopConditionDescriptions; }
+    std::vector<double> GetBatchMetricValues() const
+    { return this->m_BatchMetricValues; }
+    std::vector<unsigned int> GetBatchOptimizerIterations() const
+    { return this->m_BatchIterations; }
+    std::vector<Image> GetBatchOptimizerCostSurfaces() const
+    { return this->m_BatchOptimizerCostSurfaces; }
+    /** @} */
+
+    /** The cost surface values and parameters of the registrations of
+     * the last ExecuteBatch with the ParallelExhaustive optimizer, one
+     * registration after the other.
+     * @{
+     */
+    std::vector<double> GetBatchOptimizerCostSurfaceValues() const
+    { return this->m_BatchOptimizerCostSurfaceValues; }
+    std::vector<double> GetBatchOptimizerCostSurfaceParameters() const
+    { return this->m_BatchOptimizerCostSurfaceParameters; }
+    /** @} */
+
 
     /** \brief Get the value of the metric given the state of the method
      *
@@ -519,10 +690,38 @@ namespace simple
      * into consideration the current transforms, metric,
      * interpolator, and image masks. It does not take into
      * consideration the sampling strategy, smoothing sigmas, or the
-     * shrink factors.
+     * shrink factors, except for the sample points computed once: the
+     * MetricSamplingPoints, the MetricSamplingMask and the
+     * GRADIENT_MAGNITUDE sampling strategy.
      */
     double MetricEvaluate( const Image &fixed, const Image & moving );
 
+    /** \brief Get the values of the metric for many parameters of
+     * the InitialTransform.
+     *
+     * The parameters are a flat matrix in row major order, with a row
+     * of the parameters of the InitialTransform for each
+     * evaluation. The metric is configured as for MetricEvaluate once
+     * for all the rows, then the rows are evaluated in parallel with
+     * the threads of this method. The InitialTransform is not
+     * modified. The value of each row is returned.
+     *
+     * When computeDerivatives is true the derivatives of the metric
+     * with respect to the parameters are also computed. They are
+     * available from GetMetricEvaluateBatchDerivatives as a flat
+     * matrix with a row for each evaluation. Following the ITK
+     * convention, the derivative is the negative of the gradient of
+     * the metric value.
+     */
+    std::vector<double> MetricEvaluateBatch( const Image &fixed,
+                                             const Image &moving,
+                                             const std::vector<double> &parameters,
+                                             bool computeDerivatives = false );
+
+    /** The derivatives of the last MetricEvaluateBatch. */
+    std::vector<double> GetMetricEvaluateBatchDerivatives() const
+    { return this->m_MetricEvaluateBatchDerivatives; }
+
 
     /**
       * Active measurements which can be obtained during call backs.
@@ -560,6 +759,15 @@ namespace simple
     template<class TImage>
     double EvaluateInternal ( const Image &fixed, const Image &moving );
 
+    template<class TImage>
+    Transform ExecuteParallelExhaustiveInternal ( const Image &fixed, const Image &moving );
+
+    template<class TImage>
+    std::vector<double> EvaluateBatchInternal ( const Image &fixed,
+                                                const Image &moving,
+                                                const std::vector<double> &parameters,
+                                                bool computeDerivatives );
+
 
     itk::ObjectToObjectOptimizerBaseTemplate<double> *CreateOptimizer( unsigned int numberOfTransformParameters );
 
@@ -574,6 +782,25 @@ namespace simple
       itk::DefaultImageToImageMetricTraitsv4< TImageType, TImageType, TImageType, double >
       >* CreateMetric( );
 
+    template <class TImageType>
+      itk::ImageToImageMetricv4<TImageType,
+      TImageType,
+      TImageType,
+      double,
+      itk::DefaultImageToImageMetricTraitsv4< TImageType, TImageType, TImageType, double >
+      >* CreateEvaluateMetric( const TImageType *fixed,
+                               const TImageType *moving,
+                               const Image &inFixed,
+                               Transform &transform,
+                               bool computeDerivatives,
+                               unsigned int numberOfThreads,
+                               const itk::ImageToImageMetricv4<TImageType,
+                               TImageType,
+                               TImageType,
+                               double,
+                               itk::DefaultImageToImageMetricTraitsv4< TImageType, TImageType, TImageType, double >
+                               > *gradientMetric = SITK_NULLPTR );
+
     template <class TImageType>
       void SetupMetric(
       itk::ImageToImageMetricv4<TImageType,
@@ -586,6 +813,15 @@ namespace simple
     template <typename TMetric>
       itk::RegistrationParameterScalesEstimator< TMetric >*CreateScalesEstimator();
 
+    template <class TImageType>
+      std::vector<typename TImageType::Pointer> GetFixedImagePyramid( const Image &fixed );
+
+    template<unsigned int VDimension>
+      itk::SpatialObject<VDimension> *GetFixedMaskSpatialObject();
+
+    template <class TPointSetType, class TImageType>
+      typename TPointSetType::Pointer GetMetricSamplePointSet( const TImageType *fixed, const Image &inFixed );
+
     template <typename TTransformAdaptorPointer, typename TRegistrationMethod >
     std::vector< TTransformAdaptorPointer >
       CreateTransformParametersAdaptor(
@@ -598,6 +834,16 @@ namespace simple
 
   private:
 
+    // A registration of a batch, configured as the parent and sharing
+    // its fixed image cache.
+    explicit ImageRegistrationMethod( ImageRegistrationMethod *batchParent );
+
+    void RegisterMemberFunctions();
+
+    // Returns true if the metric samples points computed once, instead
+    // of using the sampling of the ITK registration.
+    bool UseMetricSamplePointSet() const;
+
     nsstd::function<unsigned int()> m_pfGetOptimizerIteration;
     nsstd::function<std::vector<double>()> m_pfGetOptimizerPosition;
     nsstd::function<double()> m_pfGetOptimizerLearningRate;
@@ -623,22 +869,30 @@ namespace simple
         }
     };
 
+    template < class TMemberFunctionPointer >
+      struct EvaluateBatchMemberFunctionAddressor
+    {
+      typedef typename ::detail::FunctionTraits<TMemberFunctionPointer>::ClassType ObjectType;
+
+      template< typename TImageType >
+      TMemberFunctionPointer operator() ( void ) const
+        {
+          return &ObjectType::template EvaluateBatchInternal< TImageType >;
+        }
+    };
+
     typedef Transform (ImageRegistrationMethod::*MemberFunctionType)( const Image &fixed, const Image &moving );
     typedef double (ImageRegistrationMethod::*EvaluateMemberFunctionType)( const Image &fixed, const Image &moving );
+    typedef std::vector<double> (ImageRegistrationMethod::*EvaluateBatchMemberFunctionType)( const Image &fixed,
+                                                                                           const Image &moving,
+                                                                                           const std::vector<double> &parameters,
+                                                                                           bool computeDerivatives );
     friend struct detail::MemberFunctionAddressor<MemberFunctionType>;
     nsstd::auto_ptr<detail::MemberFunctionFactory<MemberFunctionType> > m_MemberFactory;
     nsstd::auto_ptr<detail::MemberFunctionFactory<EvaluateMemberFunctionType> > m_EvaluateMemberFactory;
+    nsstd::auto_ptr<detail::MemberFunctionFactory<EvaluateBatchMemberFunctionType> > m_EvaluateBatchMemberFactory;
 
-    InterpolatorEnum  m_Interpolator;
     Transform  m_InitialTransform;
-    bool m_InitialTransformInPlace;
-    Transform m_MovingInitialTransform;
-    Transform m_FixedInitialTransform;
-
-    std::vector<uint32_t> m_VirtualDomainSize;
-    std::vector<double> m_VirtualDomainOrigin;
-    std::vector<double> m_VirtualDomainSpacing;
-    std::vector<double> m_VirtualDomainDirection;
 
     // optimizer
     enum OptimizerType { ConjugateGradientLineSearch,
@@ -649,45 +903,9 @@ namespace simple
                          Exhaustive,
                          Amoeba,
                          Powell,
-                         OnePlusOneEvolutionary
+                         OnePlusOneEvolutionary,
+                         ParallelExhaustive
     };
-    OptimizerType m_OptimizerType;
-    double m_OptimizerLearningRate;
-    double m_OptimizerMinimumStepLength;
-    unsigned int m_OptimizerNumberOfIterations;
-    double m_OptimizerLineSearchLowerLimit;
-    double m_OptimizerLineSearchUpperLimit;
-    double m_OptimizerLineSearchEpsilon;
-    unsigned int m_OptimizerLineSearchMaximumIterations;
-    EstimateLearningRateType m_OptimizerEstimateLearningRate;
-    double  m_OptimizerMaximumStepSizeInPhysicalUnits;
-    double m_OptimizerRelaxationFactor;
-    double m_OptimizerGradientMagnitudeTolerance;
-    double m_OptimizerConvergenceMinimumValue;
-    unsigned int m_OptimizerConvergenceWindowSize;
-    double m_OptimizerGradientConvergenceTolerance;
-    unsigned int m_OptimizerMaximumNumberOfCorrections;
-    unsigned int m_OptimizerMaximumNumberOfFunctionEvaluations;
-    double m_OptimizerCostFunctionConvergenceFactor;
-    double m_OptimizerLowerBound;
-    double m_OptimizerUpperBound;
-    bool m_OptimizerTrace;
-    std::vector<unsigned int> m_OptimizerNumberOfSteps;
-    double m_OptimizerStepLength;
-    double m_OptimizerSimplexDelta;
-    double m_OptimizerParametersConvergenceTolerance;
-    double m_OptimizerFunctionConvergenceTolerance;
-    bool m_OptimizerWithRestarts;
-    unsigned int m_OptimizerMaximumLineIterations;
-    double m_OptimizerStepTolerance;
-    double m_OptimizerValueTolerance;
-    double m_OptimizerEpsilon;
-    double m_OptimizerInitialRadius;
-    double m_OptimizerGrowthFactor;
-    double m_OptimizerShrinkFactor;
-    unsigned int m_OptimizerSeed;
-
-    std::vector<double> m_OptimizerWeights;
 
     enum OptimizerScalesType {
       Manual,
@@ -695,10 +913,6 @@ namespace simple
       IndexShift,
       PhysicalShift
     };
-    OptimizerScalesType m_OptimizerScalesType;
-    std::vector<double> m_OptimizerScales;
-    unsigned int m_OptimizerScalesCentralRegionRadius;
-    double m_OptimizerScalesSmallParameterVariation;
 
     // metric
     enum MetricType { ANTSNeighborhoodCorrelation,
@@ -708,29 +922,114 @@ namespace simple
                       MeanSquares,
                       MattesMutualInformation
     };
-    MetricType m_MetricType;
-    unsigned int m_MetricRadius;
-    double m_MetricIntensityDifferenceThreshold;
-    unsigned int m_MetricNumberOfHistogramBins;
-    double m_MetricVarianceForJointPDFSmoothing;
 
-    Image m_MetricFixedMaskImage;
-    Image m_MetricMovingMaskImage;
+    // The configuration of the registration, which the registrations
+    // of a batch copy from their parent.
+    struct Settings
+    {
+      Settings();
+
+      InterpolatorEnum  m_Interpolator;
+      bool m_InitialTransformInPlace;
+      Transform m_MovingInitialTransform;
+      Transform m_FixedInitialTransform;
+
+      std::vector<uint32_t> m_VirtualDomainSize;
+      std::vector<double> m_VirtualDomainOrigin;
+      std::vector<double> m_VirtualDomainSpacing;
+      std::vector<double> m_VirtualDomainDirection;
+
+      // optimizer
+      OptimizerType m_OptimizerType;
+      double m_OptimizerLearningRate;
+      double m_OptimizerMinimumStepLength;
+      unsigned int m_OptimizerNumberOfIterations;
+      double m_OptimizerLineSearchLowerLimit;
+      double m_OptimizerLineSearchUpperLimit;
+      double m_OptimizerLineSearchEpsilon;
+      unsigned int m_OptimizerLineSearchMaximumIterations;
+      EstimateLearningRateType m_OptimizerEstimateLearningRate;
+      double  m_OptimizerMaximumStepSizeInPhysicalUnits;
+      double m_OptimizerRelaxationFactor;
+      double m_OptimizerGradientMagnitudeTolerance;
+      double m_OptimizerConvergenceMinimumValue;
+      unsigned int m_OptimizerConvergenceWindowSize;
+      double m_OptimizerGradientConvergenceTolerance;
+      unsigned int m_OptimizerMaximumNumberOfCorrections;
+      unsigned int m_OptimizerMaximumNumberOfFunctionEvaluations;
+      double m_OptimizerCostFunctionConvergenceFactor;
+      double m_OptimizerLowerBound;
+      double m_OptimizerUpperBound;
+      bool m_OptimizerTrace;
+      std::vector<unsigned int> m_OptimizerNumberOfSteps;
+      double m_OptimizerStepLength;
+      double m_OptimizerSimplexDelta;
+      double m_OptimizerParametersConvergenceTolerance;
+      double m_OptimizerFunctionConvergenceTolerance;
+      bool m_OptimizerWithRestarts;
+      unsigned int m_OptimizerMaximumLineIterations;
+      double m_OptimizerStepTolerance;
+      double m_OptimizerValueTolerance;
+      double m_OptimizerEpsilon;
+      double m_OptimizerInitialRadius;
+      double m_OptimizerGrowthFactor;
+      double m_OptimizerShrinkFactor;
+      unsigned int m_OptimizerSeed;
+
+      std::vector<double> m_OptimizerWeights;
+
+      OptimizerScalesType m_OptimizerScalesType;
+      std::vector<double> m_OptimizerScales;
+      unsigned int m_OptimizerScalesCentralRegionRadius;
+      double m_OptimizerScalesSmallParameterVariation;
+
+      // metric
+      MetricType m_MetricType;
+      unsigned int m_MetricRadius;
+      double m_MetricIntensityDifferenceThreshold;
+      unsigned int m_MetricNumberOfHistogramBins;
+      double m_MetricVarianceForJointPDFSmoothing;
+
+      Image m_MetricFixedMaskImage;
+      Image m_MetricMovingMaskImage;
+
+      std::vector<double> m_MetricSamplingPercentage;
+      MetricSamplingStrategyType m_MetricSamplingStrategy;
+      unsigned int m_MetricSamplingSeed;
+      std::vector<double> m_MetricSamplingPoints;
+      Image m_MetricSamplingMaskImage;
+
+      bool m_MetricUseFixedImageGradientFilter;
+      bool m_MetricUseMovingImageGradientFilter;
+
+      std::vector<unsigned int> m_ShrinkFactorsPerLevel;
+      std::vector<double> m_SmoothingSigmasPerLevel;
+      bool m_SmoothingSigmasAreSpecifiedInPhysicalUnits;
+    };
+    Settings m_Settings;
 
-    std::vector<double> m_MetricSamplingPercentage;
-    MetricSamplingStrategyType m_MetricSamplingStrategy;
-    unsigned int m_MetricSamplingSeed;
+    struct FixedImageCache;
+    bool m_UseFixedImageCache;
+    nsstd::auto_ptr<FixedImageCache> m_FixedImageCache;
+    FixedImageCache &GetFixedImageCache();
 
-    bool m_MetricUseFixedImageGradientFilter;
-    bool m_MetricUseMovingImageGradientFilter;
+    ImageRegistrationMethod *m_BatchParent;
+    unsigned int m_NumberOfConcurrentRegistrations;
+    std::vector<std::string> m_BatchStopConditionDescriptions;
+    std::vector<double> m_BatchMetricValues;
+    std::vector<unsigned int> m_BatchIterations;
+    std::vector<Image> m_BatchOptimizerCostSurfaces;
+    std::vector<double> m_BatchOptimizerCostSurfaceValues;
+    std::vector<double> m_BatchOptimizerCostSurfaceParameters;
 
-    std::vector<unsigned int> m_ShrinkFactorsPerLevel;
-    std::vector<double> m_SmoothingSigmasPerLevel;
-    bool m_SmoothingSigmasAreSpecifiedInPhysicalUnits;
+    std::vector<double> m_MetricEvaluateBatchDerivatives;
 
     std::string m_StopConditionDescription;
     double m_MetricValue;
     unsigned int m_Iteration;
+    Image m_OptimizerCostSurface;
+    std::vector<double> m_OptimizerCostSurfaceValues;
+    std::vector<double> m_OptimizerCostSurfaceParameters;
 
     itk::ObjectToObjectOptimizerBaseTemplate<double> *m_ActiveOptimizer;
   };
@@ -19,16 +19,23 @@
 
 #include "sitkCreateInterpolator.hxx"
 #include "sitkCastImageFilter.h"
+#include "sitkTaskGraph.h"
 
 #include "itkImageMaskSpatialObject.h"
 #include "itkImage.h"
 #include "itkImageRegistrationMethodv4.h"
+#include "itkSimpleFastMutexLock.h"
+#include "itkMutexLockHolder.h"
+#include "itkMultiThreader.h"
 
 #include "itkRegistrationParameterScalesFromJacobian.h"
 #include "itkRegistrationParameterScalesFromIndexShift.h"
 #include "itkRegistrationParameterScalesFromPhysicalShift.h"
 
 #include "sitkImageRegistrationMethod_CreateParametersAdaptor.hxx"
+#include "sitkImageRegistrationMethod_FixedImagePyramid.hxx"
+#include "sitkImageRegistrationMethod_MetricSamplePoints.hxx"
+#include "sitkImageRegistrationMethod_SharedGradientImageFilter.hxx"
 
 
 template< typename TValue, typename TType>
@@ -59,9 +66,127 @@ struct CurrentLevelCustomCast
       return static_cast<unsigned int>(ret);
     }
 };
+
+// Returns true if the image held by a cache has the pixel buffer and
+// the geometry of an image.
+template <class TImageType>
+bool IsCachedImage( const Image &cached, const TImageType *image )
+{
+  const TImageType *cachedImage = dynamic_cast<const TImageType *>( cached.GetITKBase() );
+  return ( cachedImage != NULL
+           && cachedImage->GetBufferPointer() == image->GetBufferPointer()
+           && cachedImage->GetLargestPossibleRegion() == image->GetLargestPossibleRegion()
+           && cachedImage->GetOrigin() == image->GetOrigin()
+           && cachedImage->GetSpacing() == image->GetSpacing()
+           && cachedImage->GetDirection() == image->GetDirection() );
 }
 
-ImageRegistrationMethod::ImageRegistrationMethod()
+// The measurements of a registration of a batch.
+struct BatchResult
+{
+  BatchResult() : MetricValue(0.0), Iteration(0) {}
+
+  Transform           RegistrationTransform;
+  std::string         StopConditionDescription;
+  double              MetricValue;
+  unsigned int        Iteration;
+  Image               CostSurface;
+  std::vector<double> CostSurfaceValues;
+  std::vector<double> CostSurfaceParameters;
+};
+
+// Execute a registration of a batch, the inputs are the fixed and
+// moving images. The transform of the result is the initial
+// transform, and is replaced by the registered transform.
+struct BatchRegistrationTask
+{
+  BatchRegistrationTask( ImageRegistrationMethod *registration, bool inPlace, BatchResult *result )
+    : m_Registration( registration ), m_InPlace( inPlace ), m_Result( result ) {}
+
+  Image operator()( const std::vector<Image> &inputs ) const
+    {
+      m_Registration->SetInitialTransform( m_Result->RegistrationTransform, m_InPlace );
+      try
+        {
+        m_Result->RegistrationTransform = m_Registration->Execute( inputs[0], inputs[1] );
+        }
+      catch (...)
+        {
+        this->UpdateMeasurements();
+        throw;
+        }
+      this->UpdateMeasurements();
+      return Image();
+    }
+
+  void UpdateMeasurements() const
+    {
+      m_Result->StopConditionDescription = m_Registration->GetOptimizerStopConditionDescription();
+      m_Result->MetricValue = m_Registration->GetMetricValue();
+      m_Result->Iteration = m_Registration->GetOptimizerIteration();
+      m_Result->CostSurface = m_Registration->GetOptimizerCostSurface();
+      m_Result->CostSurfaceValues = m_Registration->GetOptimizerCostSurfaceValues();
+      m_Result->CostSurfaceParameters = m_Registration->GetOptimizerCostSurfaceParameters();
+    }
+
+  ImageRegistrationMethod *m_Registration;
+  bool                     m_InPlace;
+  BatchResult             *m_Result;
+};
+
+// Deletes the registrations of a batch.
+struct BatchRegistrations
+{
+  ~BatchRegistrations()
+    {
+      for ( size_t i = 0; i < m_Registrations.size(); ++i )
+        {
+        delete m_Registrations[i];
+        }
+    }
+  std::vector<ImageRegistrationMethod *> m_Registrations;
+};
+
+}
+
+// The fixed image data reused across executions. The fixed image is
+// held, so its pixel buffer and geometry identify it, including for
+// the copies sharing the buffer given to the tasks of a batch. The
+// masks are identified by their ITK images. The lock is held while the
+// registrations of a batch access the cache. The sample points are
+// reused whether or not the fixed image cache is enabled.
+struct ImageRegistrationMethod::FixedImageCache
+{
+  FixedImageCache()
+    : SmoothingSigmasAreSpecifiedInPhysicalUnits(true),
+      NumberOfPyramidHits(0),
+      SamplingStrategy(NONE),
+      SamplingPercentage(1.0),
+      SamplingSeed(sitkWallClock)
+    {}
+
+  itk::SimpleFastMutexLock              Lock;
+
+  Image                                 FixedImage;
+  std::vector<double>                   SmoothingSigmasPerLevel;
+  bool                                  SmoothingSigmasAreSpecifiedInPhysicalUnits;
+  std::vector<itk::DataObject::Pointer> FixedImagePyramid;
+  uint64_t                              NumberOfPyramidHits;
+
+  Image                     FixedMaskImage;
+  itk::LightObject::Pointer FixedMask;
+
+  Image                                               SamplePointsFixedImage;
+  Image                                               SamplingMaskImage;
+  std::vector<double>                                 SamplingPoints;
+  ImageRegistrationMethod::MetricSamplingStrategyType SamplingStrategy;
+  double                                              SamplingPercentage;
+  unsigned int                                        SamplingSeed;
+  itk::LightObject::Pointer                           SamplePointSet;
+};
+
+
+ImageRegistrationMethod::Settings::Settings()
   : m_Interpolator(sitkLinear),
     m_InitialTransformInPlace(true),
     m_OptimizerScalesType(Manual),
@@ -72,8 +197,45 @@ ImageRegistrationMethod::ImageRegistrationMethod()
     m_MetricUseMovingImageGradientFilter(true),
     m_ShrinkFactorsPerLevel(1, 1),
     m_SmoothingSigmasPerLevel(1,0.0),
-    m_SmoothingSigmasAreSpecifiedInPhysicalUnits(true),
+    m_SmoothingSigmasAreSpecifiedInPhysicalUnits(true)
+{
+}
+
+
+ImageRegistrationMethod::ImageRegistrationMethod()
+  : m_UseFixedImageCache(false),
+    m_FixedImageCache(new FixedImageCache),
+    m_BatchParent(NULL),
+    m_NumberOfConcurrentRegistrations(0),
     m_ActiveOptimizer(NULL)
+{
+  this->RegisterMemberFunctions();
+
+  this->SetMetricAsMattesMutualInformation();
+}
+
+
+ImageRegistrationMethod::ImageRegistrationMethod( ImageRegistrationMethod *batchParent )
+  : m_Settings(batchParent->m_Settings),
+    m_UseFixedImageCache(true),
+    m_FixedImageCache(new FixedImageCache),
+    m_BatchParent(batchParent),
+    m_NumberOfConcurrentRegistrations(1),
+    m_ActiveOptimizer(NULL)
+{
+  this->RegisterMemberFunctions();
+
+  this->SetDebug( batchParent->GetDebug() );
+  this->SetNumberOfThreads( batchParent->GetNumberOfThreads() );
+
+  // the registrations of a batch execute concurrently, they must not
+  // share transforms
+  this->m_Settings.m_MovingInitialTransform.MakeUnique();
+  this->m_Settings.m_FixedInitialTransform.MakeUnique();
+}
+
+
+void ImageRegistrationMethod::RegisterMemberFunctions()
 {
   m_MemberFactory.reset( new  detail::MemberFunctionFactory<MemberFunctionType>( this ) );
 
@@ -89,8 +251,11 @@ ImageRegistrationMethod::ImageRegistrationMethod()
   m_EvaluateMemberFactory->RegisterMemberFunctions< RealPixelIDTypeList, 3, EvaluateMemberFunctionAddressorType > ();
   m_EvaluateMemberFactory->RegisterMemberFunctions< RealPixelIDTypeList, 2, EvaluateMemberFunctionAddressorType > ();
 
-  this->SetMetricAsMattesMutualInformation();
+  m_EvaluateBatchMemberFactory.reset( new detail::MemberFunctionFactory<EvaluateBatchMemberFunctionType>(this) );
 
+  typedef EvaluateBatchMemberFunctionAddressor<EvaluateBatchMemberFunctionType> EvaluateBatchMemberFunctionAddressorType;
+  m_EvaluateBatchMemberFactory->RegisterMemberFunctions< RealPixelIDTypeList, 3, EvaluateBatchMemberFunctionAddressorType > ();
+  m_EvaluateBatchMemberFactory->RegisterMemberFunctions< RealPixelIDTypeList, 2, EvaluateBatchMemberFunctionAddressorType > ();
 }
 
 
@@ -112,7 +277,7 @@ std::string  ImageRegistrationMethod::ToString() const
     }
 
   out << "  Interpolator: ";
-  this->ToStringHelper(out, this->m_Interpolator);
+  this->ToStringHelper(out, this->m_Settings.m_Interpolator);
   out << std::endl;
 
   out << "  Transform: ";
@@ -128,7 +293,7 @@ ImageRegistrationMethod::SetInitialTransform ( const Transform &transform )
 {
   this->m_InitialTransform = transform;
   this->m_InitialTransform.MakeUnique();
-  this->m_InitialTransformInPlace = true;
+  this->m_Settings.m_InitialTransformInPlace = true;
   return *this;
     }
 
@@ -145,7 +310,7 @@ ImageRegistrationMethod::SetInitialTransform ( Transform &transform, bool inPlac
 
 
   this->m_InitialTransform = transform;
-  this->m_InitialTransformInPlace = inPlace;
+  this->m_Settings.m_InitialTransformInPlace = inPlace;
   return *this;
 }
 
@@ -172,20 +337,20 @@ ImageRegistrationMethod::SetVirtualDomain( const std::vector<uint32_t> &virtualS
     sitkExceptionMacro("Expected virtualDirection to be of length " << dim*dim << "!" );
     }
 
-  this->m_VirtualDomainSize = virtualSize;
-  this->m_VirtualDomainOrigin = virtualOrigin;
-  this->m_VirtualDomainSpacing = virtualSpacing;
-  this->m_VirtualDomainDirection = virtualDirection;
+  this->m_Settings.m_VirtualDomainSize = virtualSize;
+  this->m_Settings.m_VirtualDomainOrigin = virtualOrigin;
+  this->m_Settings.m_VirtualDomainSpacing = virtualSpacing;
+  this->m_Settings.m_VirtualDomainDirection = virtualDirection;
   return *this;
 }
 
 ImageRegistrationMethod::Self&
 ImageRegistrationMethod::SetVirtualDomainFromImage( const Image &virtualImage )
 {
-  this->m_VirtualDomainSize = virtualImage.GetSize();
-  this->m_VirtualDomainOrigin = virtualImage.GetOrigin();
-  this->m_VirtualDomainSpacing = virtualImage.GetSpacing();
-  this->m_VirtualDomainDirection = virtualImage.GetDirection();
+  this->m_Settings.m_VirtualDomainSize = virtualImage.GetSize();
+  this->m_Settings.m_VirtualDomainOrigin = virtualImage.GetOrigin();
+  this->m_Settings.m_VirtualDomainSpacing = virtualImage.GetSpacing();
+  this->m_Settings.m_VirtualDomainDirection = virtualImage.GetDirection();
 
   return *this;
 }
@@ -193,8 +358,8 @@ ImageRegistrationMethod::SetVirtualDomainFromImage( const Image &virtualImage )
 ImageRegistrationMethod::Self&
 ImageRegistrationMethod::SetMetricAsANTSNeighborhoodCorrelation(  unsigned int radius )
 {
-  m_MetricRadius = radius;
-  m_MetricType = ANTSNeighborhoodCorrelation;
+  m_Settings.m_MetricRadius = radius;
+  m_Settings.m_MetricType = ANTSNeighborhoodCorrelation;
   return *this;
 }
 
@@ -202,15 +367,15 @@ ImageRegistrationMethod::SetMetricAsANTSNeighborhoodCorrelation(  unsigned int r
 ImageRegistrationMethod::Self&
 ImageRegistrationMethod::SetMetricAsCorrelation( )
 {
-  m_MetricType = Correlation;
+  m_Settings.m_MetricType = Correlation;
   return *this;
 }
 
 ImageRegistrationMethod::Self&
 ImageRegistrationMethod::SetMetricAsDemons( double intensityDifferenceThreshold )
 {
-  m_MetricType = Demons;
-  m_MetricIntensityDifferenceThreshold = intensityDifferenceThreshold;
+  m_Settings.m_MetricType = Demons;
+  m_Settings.m_MetricIntensityDifferenceThreshold = intensityDifferenceThreshold;
   return *this;
 }
 
@@ -218,24 +383,24 @@ ImageRegistrationMethod::Self&
 ImageRegistrationMethod::SetMetricAsJointHistogramMutualInformation( unsigned int numberOfHistogramBins,
                                                                      double varianceForJointPDFSmoothing )
 {
-  m_MetricType = JointHistogramMutualInformation;
-  m_MetricNumberOfHistogramBins = numberOfHistogramBins;
-  m_MetricVarianceForJointPDFSmoothing = varianceForJointPDFSmoothing;
+  m_Settings.m_MetricType = JointHistogramMutualInformation;
+  m_Settings.m_MetricNumberOfHistogramBins = numberOfHistogramBins;
+  m_Settings.m_MetricVarianceForJointPDFSmoothing = varianceForJointPDFSmoothing;
   return *this;
 }
 
 ImageRegistrationMethod::Self&
 ImageRegistrationMethod::SetMetricAsMeanSquares( )
 {
-  m_MetricType = MeanSquares;
+  m_Settings.m_MetricType = MeanSquares;
   return *this;
 }
 
 ImageRegistrationMethod::Self&
 ImageRegistrationMethod::SetMetricAsMattesMutualInformation( unsigned int numberOfHistogramBins )
 {
-  m_MetricType = MattesMutualInformation;
-  m_MetricNumberOfHistogramBins = numberOfHistogramBins;
+  m_Settings.m_MetricType = MattesMutualInformation;
+  m_Settings.m_MetricNumberOfHistogramBins = numberOfHistogramBins;
   return *this;
 }
 
@@ -252,17 +417,17 @@ ImageRegistrationMethod::SetOptimizerAsConjugateGradientLineSearch( double learn
                                                                     EstimateLearningRateType estimateLearningRate,
                                                                     double maximumStepSizeInPhysicalUnits )
 {
-  m_OptimizerType = ConjugateGradientLineSearch;
-  m_OptimizerLearningRate = learningRate;
-  m_OptimizerNumberOfIterations = numberOfIterations;
-  m_OptimizerConvergenceMinimumValue = convergenceMinimumValue;
-  m_OptimizerConvergenceWindowSize = convergenceWindowSize;
-  m_OptimizerLineSearchLowerLimit = lineSearchLowerLimit;
-  m_OptimizerLineSearchUpperLimit = lineSearchUpperLimit;
-  m_OptimizerLineSearchEpsilon = lineSearchEpsilon;
-  m_OptimizerLineSearchMaximumIterations = lineSearchMaximumIterations;
-  m_OptimizerEstimateLearningRate = estimateLearningRate;
-  m_OptimizerMaximumStepSizeInPhysicalUnits = maximumStepSizeInPhysicalUnits;
+  m_Settings.m_OptimizerType = ConjugateGradientLineSearch;
+  m_Settings.m_OptimizerLearningRate = learningRate;
+  m_Settings.m_OptimizerNumberOfIterations = numberOfIterations;
+  m_Settings.m_OptimizerConvergenceMinimumValue = convergenceMinimumValue;
+  m_Settings.m_OptimizerConvergenceWindowSize = convergenceWindowSize;
+  m_Settings.m_OptimizerLineSearchLowerLimit = lineSearchLowerLimit;
+  m_Settings.m_OptimizerLineSearchUpperLimit = lineSearchUpperLimit;
+  m_Settings.m_OptimizerLineSearchEpsilon = lineSearchEpsilon;
+  m_Settings.m_OptimizerLineSearchMaximumIterations = lineSearchMaximumIterations;
+  m_Settings.m_OptimizerEstimateLearningRate = estimateLearningRate;
+  m_Settings.m_OptimizerMaximumStepSizeInPhysicalUnits = maximumStepSizeInPhysicalUnits;
   return *this;
 }
 
@@ -275,14 +440,14 @@ ImageRegistrationMethod::SetOptimizerAsRegularStepGradientDescent( double learni
                                                                    EstimateLearningRateType estimateLearningRate,
                                                                    double maximumStepSizeInPhysicalUnits )
 {
-  m_OptimizerType = RegularStepGradientDescent;
-  m_OptimizerLearningRate = learningRate;
-  m_OptimizerMinimumStepLength = minStep;
-  m_OptimizerNumberOfIterations = numberOfIteratons;
-  m_OptimizerRelaxationFactor = relaxationFactor;
-  m_OptimizerGradientMagnitudeTolerance = gradientMagnitudeTolerance;
-  m_OptimizerEstimateLearningRate = estimateLearningRate;
-  m_OptimizerMaximumStepSizeInPhysicalUnits = maximumStepSizeInPhysicalUnits;
+  m_Settings.m_OptimizerType = RegularStepGradientDescent;
+  m_Settings.m_OptimizerLearningRate = learningRate;
+  m_Settings.m_OptimizerMinimumStepLength = minStep;
+  m_Settings.m_OptimizerNumberOfIterations = numberOfIteratons;
+  m_Settings.m_OptimizerRelaxationFactor = relaxationFactor;
+  m_Settings.m_OptimizerGradientMagnitudeTolerance = gradientMagnitudeTolerance;
+  m_Settings.m_OptimizerEstimateLearningRate = estimateLearningRate;
+  m_Settings.m_OptimizerMaximumStepSizeInPhysicalUnits = maximumStepSizeInPhysicalUnits;
   return *this;
 }
 
@@ -294,13 +459,13 @@ ImageRegistrationMethod::SetOptimizerAsGradientDescent( double learningRate,
                                                         EstimateLearningRateType estimateLearningRate,
                                                         double maximumStepSizeInPhysicalUnits )
 {
-  m_OptimizerType = GradientDescent;
-  m_OptimizerLearningRate = learningRate;
-  m_OptimizerNumberOfIterations = numberOfIteratons;
-  m_OptimizerConvergenceMinimumValue = convergenceMinimumValue;
-  m_OptimizerConvergenceWindowSize = convergenceWindowSize;
-  m_OptimizerEstimateLearningRate = estimateLearningRate;
-  m_OptimizerMaximumStepSizeInPhysicalUnits = maximumStepSizeInPhysicalUnits;
+  m_Settings.m_OptimizerType = GradientDescent;
+  m_Settings.m_OptimizerLearningRate = learningRate;
+  m_Settings.m_OptimizerNumberOfIterations = numberOfIteratons;
+  m_Settings.m_OptimizerConvergenceMinimumValue = convergenceMinimumValue;
+  m_Settings.m_OptimizerConvergenceWindowSize = convergenceWindowSize;
+  m_Settings.m_OptimizerEstimateLearningRate = estimateLearningRate;
+  m_Settings.m_OptimizerMaximumStepSizeInPhysicalUnits = maximumStepSizeInPhysicalUnits;
   return *this;
 }
 
@@ -316,17 +481,17 @@ ImageRegistrationMethod::SetOptimizerAsGradientDescentLineSearch( double learnin
                                                                   EstimateLearningRateType estimateLearningRate,
                                                                   double maximumStepSizeInPhysicalUnits )
 {
-  m_OptimizerType = GradientDescentLineSearch;
-  m_OptimizerLearningRate = learningRate;
-  m_OptimizerNumberOfIterations = numberOfIterations;
-  m_OptimizerConvergenceMinimumValue = convergenceMinimumValue;
-  m_OptimizerConvergenceWindowSize = convergenceWindowSize;
-  m_OptimizerLineSearchLowerLimit = lineSearchLowerLimit;
-  m_OptimizerLineSearchUpperLimit = lineSearchUpperLimit;
-  m_OptimizerLineSearchEpsilon = lineSearchEpsilon;
-  m_OptimizerLineSearchMaximumIterations = lineSearchMaximumIterations;
-  m_OptimizerEstimateLearningRate = estimateLearningRate;
-  m_OptimizerMaximumStepSizeInPhysicalUnits = maximumStepSizeInPhysicalUnits;
+  m_Settings.m_OptimizerType = GradientDescentLineSearch;
+  m_Settings.m_OptimizerLearningRate = learningRate;
+  m_Settings.m_OptimizerNumberOfIterations = numberOfIterations;
+  m_Settings.m_OptimizerConvergenceMinimumValue = convergenceMinimumValue;
+  m_Settings.m_OptimizerConvergenceWindowSize = convergenceWindowSize;
+  m_Settings.m_OptimizerLineSearchLowerLimit = lineSearchLowerLimit;
+  m_Settings.m_OptimizerLineSearchUpperLimit = lineSearchUpperLimit;
+  m_Settings.m_OptimizerLineSearchEpsilon = lineSearchEpsilon;
+  m_Settings.m_OptimizerLineSearchMaximumIterations = lineSearchMaximumIterations;
+  m_Settings.m_OptimizerEstimateLearningRate = estimateLearningRate;
+  m_Settings.m_OptimizerMaximumStepSizeInPhysicalUnits = maximumStepSizeInPhysicalUnits;
   return *this;
 }
 
@@ -341,15 +506,15 @@ ImageRegistrationMethod::SetOptimizerAsLBFGSB( double gradientConvergenceToleran
                                                double upperBound,
                                                bool trace )
 {
-  m_OptimizerType = LBFGSB;
-  m_OptimizerGradientConvergenceTolerance = gradientConvergenceTolerance;
-  m_OptimizerNumberOfIterations = numberOfIterations;
-  m_OptimizerMaximumNumberOfCorrections = maximumNumberOfCorrections;
-  m_OptimizerMaximumNumberOfFunctionEvaluations = maximumNumberOfFunctionEvaluations;
-  m_OptimizerCostFunctionConvergenceFactor = costFunctionConvergenceFactor;
-  m_OptimizerLowerBound = lowerBound;
-  m_OptimizerUpperBound = upperBound;
-  m_OptimizerTrace = trace;
+  m_Settings.m_OptimizerType = LBFGSB;
+  m_Settings.m_OptimizerGradientConvergenceTolerance = gradientConvergenceTolerance;
+  m_Settings.m_OptimizerNumberOfIterations = numberOfIterations;
+  m_Settings.m_OptimizerMaximumNumberOfCorrections = maximumNumberOfCorrections;
+  m_Settings.m_OptimizerMaximumNumberOfFunctionEvaluations = maximumNumberOfFunctionEvaluations;
+  m_Settings.m_OptimizerCostFunctionConvergenceFactor = costFunctionConvergenceFactor;
+  m_Settings.m_OptimizerLowerBound = lowerBound;
+  m_Settings.m_OptimizerUpperBound = upperBound;
+  m_Settings.m_OptimizerTrace = trace;
   return *this;
 }
 
@@ -357,23 +522,33 @@ ImageRegistrationMethod::SetOptimizerAsLBFGSB( double gradientConvergenceToleran
 ImageRegistrationMethod::Self&
 ImageRegistrationMethod::SetOptimizerWeights( const std::vector<double> &weights)
 {
-  this->m_OptimizerWeights = weights;
+  this->m_Settings.m_OptimizerWeights = weights;
   return *this;
 }
 
 std::vector<double>
 ImageRegistrationMethod::GetOptimizerWeights( ) const
 {
-  return this->m_OptimizerWeights;
+  return this->m_Settings.m_OptimizerWeights;
 }
 
 ImageRegistrationMethod::Self&
 ImageRegistrationMethod::SetOptimizerAsExhaustive(const std::vector<unsigned int> &numberOfSteps,
                                                   double stepLength )
 {
-  m_OptimizerType = Exhaustive;
-  m_OptimizerStepLength = stepLength;
-  m_OptimizerNumberOfSteps = numberOfSteps;
+  m_Settings.m_OptimizerType = Exhaustive;
+  m_Settings.m_OptimizerStepLength = stepLength;
+  m_Settings.m_OptimizerNumberOfSteps = numberOfSteps;
+  return *this;
+}
+
+ImageRegistrationMethod::Self&
+ImageRegistrationMethod::SetOptimizerAsParallelExhaustive(const std::vector<unsigned int> &numberOfSteps,
+                                                          double stepLength )
+{
+  m_Settings.m_OptimizerType = ParallelExhaustive;
+  m_Settings.m_OptimizerStepLength = stepLength;
+  m_Settings.m_OptimizerNumberOfSteps = numberOfSteps;
   return *this;
 }
 
@@ -384,12 +559,12 @@ ImageRegistrationMethod::SetOptimizerAsAmoeba( double simplexDelta,
                                                double functionConvergenceTolerance,
                                                bool withRestarts )
 {
-  m_OptimizerType = Amoeba;
-  m_OptimizerSimplexDelta = simplexDelta;
-  m_OptimizerNumberOfIterations = numberOfIterations;
-  m_OptimizerParametersConvergenceTolerance = parametersConvergenceTolerance;
-  m_OptimizerFunctionConvergenceTolerance = functionConvergenceTolerance;
-  m_OptimizerWithRestarts = withRestarts;
+  m_Settings.m_OptimizerType = Amoeba;
+  m_Settings.m_OptimizerSimplexDelta = simplexDelta;
+  m_Settings.m_OptimizerNumberOfIterations = numberOfIterations;
+  m_Settings.m_OptimizerParametersConvergenceTolerance = parametersConvergenceTolerance;
+  m_Settings.m_OptimizerFunctionConvergenceTolerance = functionConvergenceTolerance;
+  m_Settings.m_OptimizerWithRestarts = withRestarts;
   return *this;
 }
 
@@ -400,12 +575,12 @@ ImageRegistrationMethod::SetOptimizerAsPowell(unsigned int numberOfIterations,
                                               double stepTolerance,
                                               double valueTolerance )
 {
-  m_OptimizerType = Powell;
-  m_OptimizerNumberOfIterations = numberOfIterations;
-  m_OptimizerMaximumLineIterations = maximumLineIterations;
-  m_OptimizerStepLength = stepLength;
-  m_OptimizerStepTolerance = stepTolerance;
-  m_OptimizerValueTolerance = valueTolerance;
+  m_Settings.m_OptimizerType = Powell;
+  m_Settings.m_OptimizerNumberOfIterations = numberOfIterations;
+  m_Settings.m_OptimizerMaximumLineIterations = maximumLineIterations;
+  m_Settings.m_OptimizerStepLength = stepLength;
+  m_Settings.m_OptimizerStepTolerance = stepTolerance;
+  m_Settings.m_OptimizerValueTolerance = valueTolerance;
   return *this;
 }
 
@@ -417,13 +592,13 @@ ImageRegistrationMethod::SetOptimizerAsOnePlusOneEvolutionary(unsigned int numbe
                                                               double shrinkFactor,
                                                               unsigned int seed)
 {
-  m_OptimizerType = OnePlusOneEvolutionary;
-  m_OptimizerNumberOfIterations = numberOfIterations;
-  m_OptimizerEpsilon = epsilon;
-  m_OptimizerInitialRadius = initialRadius;
-  m_OptimizerGrowthFactor = growthFactor;
-  m_OptimizerShrinkFactor = shrinkFactor;
-  m_OptimizerSeed = seed;
+  m_Settings.m_OptimizerType = OnePlusOneEvolutionary;
+  m_Settings.m_OptimizerNumberOfIterations = numberOfIterations;
+  m_Settings.m_OptimizerEpsilon = epsilon;
+  m_Settings.m_OptimizerInitialRadius = initialRadius;
+  m_Settings.m_OptimizerGrowthFactor = growthFactor;
+  m_Settings.m_OptimizerShrinkFactor = shrinkFactor;
+  m_Settings.m_OptimizerSeed = seed;
 
   return *this;
 }
@@ -431,8 +606,8 @@ ImageRegistrationMethod::SetOptimizerAsOnePlusOneEvolutionary(unsigned int numbe
 ImageRegistrationMethod::Self&
 ImageRegistrationMethod::SetOptimizerScales( const std::vector<double> &scales)
 {
-  this->m_OptimizerScalesType = Manual;
-  this->m_OptimizerScales = scales;
+  this->m_Settings.m_OptimizerScalesType = Manual;
+  this->m_Settings.m_OptimizerScales = scales;
   return *this;
 }
 
@@ -441,7 +616,7 @@ ImageRegistrationMethod::Self&
 ImageRegistrationMethod::SetMetricFixedMask( const Image &binaryMask )
 {
   // todo
-  m_MetricFixedMaskImage = binaryMask;
+  m_Settings.m_MetricFixedMaskImage = binaryMask;
   //m_MetricFixedMaskRegion.clear();
   return *this;
  }
@@ -449,7 +624,7 @@ ImageRegistrationMethod::SetMetricFixedMask( const Image &binaryMask )
 ImageRegistrationMethod::Self&
 ImageRegistrationMethod::SetMetricMovingMask( const Image &binaryMask )
 {
-  m_MetricMovingMaskImage = binaryMask;
+  m_Settings.m_MetricMovingMaskImage = binaryMask;
   //m_MetricMovingMaskRegion.clear();
   return *this;
 }
@@ -457,9 +632,9 @@ ImageRegistrationMethod::SetMetricMovingMask( const Image &binaryMask )
 ImageRegistrationMethod::Self&
 ImageRegistrationMethod::SetOptimizerScalesFromJacobian( unsigned int centralRegionRadius )
 {
-  this->m_OptimizerScalesType = Jacobian;
-  this->m_OptimizerScalesCentralRegionRadius = centralRegionRadius;
-  this->m_OptimizerScales = std::vector<double>();
+  this->m_Settings.m_OptimizerScalesType = Jacobian;
+  this->m_Settings.m_OptimizerScalesCentralRegionRadius = centralRegionRadius;
+  this->m_Settings.m_OptimizerScales = std::vector<double>();
   return *this;
 }
 
@@ -467,10 +642,10 @@ ImageRegistrationMethod::Self&
 ImageRegistrationMethod::SetOptimizerScalesFromIndexShift( unsigned int centralRegionRadius,
                                                            double smallParameterVariation )
 {
-  this->m_OptimizerScalesType = IndexShift;
-  this->m_OptimizerScalesCentralRegionRadius = centralRegionRadius;
-  this->m_OptimizerScalesSmallParameterVariation = smallParameterVariation;
-  this->m_OptimizerScales = std::vector<double>();
+  this->m_Settings.m_OptimizerScalesType = IndexShift;
+  this->m_Settings.m_OptimizerScalesCentralRegionRadius = centralRegionRadius;
+  this->m_Settings.m_OptimizerScalesSmallParameterVariation = smallParameterVariation;
+  this->m_Settings.m_OptimizerScales = std::vector<double>();
   return *this;
 }
 
@@ -478,46 +653,67 @@ ImageRegistrationMethod::Self&
 ImageRegistrationMethod::SetOptimizerScalesFromPhysicalShift( unsigned int centralRegionRadius,
                                                               double smallParameterVariation )
 {
-  this->m_OptimizerScalesType = PhysicalShift;
-  this->m_OptimizerScalesCentralRegionRadius = centralRegionRadius;
-  this->m_OptimizerScalesSmallParameterVariation = smallParameterVariation;
-  this->m_OptimizerScales = std::vector<double>();
+  this->m_Settings.m_OptimizerScalesType = PhysicalShift;
+  this->m_Settings.m_OptimizerScalesCentralRegionRadius = centralRegionRadius;
+  this->m_Settings.m_OptimizerScalesSmallParameterVariation = smallParameterVariation;
+  this->m_Settings.m_OptimizerScales = std::vector<double>();
   return *this;
 }
 
 ImageRegistrationMethod::Self&
 ImageRegistrationMethod::SetMetricSamplingPercentage(double percentage, unsigned int seed)
 {
-  m_MetricSamplingPercentage.resize(1);
-  m_MetricSamplingPercentage[0] = percentage;
-  m_MetricSamplingSeed = seed;
+  m_Settings.m_MetricSamplingPercentage.resize(1);
+  m_Settings.m_MetricSamplingPercentage[0] = percentage;
+  m_Settings.m_MetricSamplingSeed = seed;
   return *this;
 }
 
 ImageRegistrationMethod::Self&
 ImageRegistrationMethod::SetMetricSamplingPercentagePerLevel(const std::vector<double> &percentage, unsigned int seed)
 {
-  m_MetricSamplingPercentage = percentage;
-  m_MetricSamplingSeed = seed;
+  m_Settings.m_MetricSamplingPercentage = percentage;
+  m_Settings.m_MetricSamplingSeed = seed;
   return *this;
 }
 
 ImageRegistrationMethod::Self&
 ImageRegistrationMethod::SetMetricSamplingStrategy( MetricSamplingStrategyType strategy)
 {
-  m_MetricSamplingStrategy = strategy;
+  m_Settings.m_MetricSamplingStrategy = strategy;
+  return *this;
+}
+
+ImageRegistrationMethod::Self&
+ImageRegistrationMethod::SetMetricSamplingPoints( const std::vector<double> &points )
+{
+  m_Settings.m_MetricSamplingPoints = points;
+  return *this;
+}
+
+ImageRegistrationMethod::Self&
+ImageRegistrationMethod::SetMetricSamplingMask( const Image &binaryMask )
+{
+  m_Settings.m_MetricSamplingMaskImage = binaryMask;
   return *this;
 }
 
+bool ImageRegistrationMethod::UseMetricSamplePointSet() const
+{
+  return ( !m_Settings.m_MetricSamplingPoints.empty()
+           || m_Settings.m_MetricSamplingMaskImage.GetSize() != std::vector<unsigned int>(m_Settings.m_MetricSamplingMaskImage.GetDimension(), 0u)
+           || m_Settings.m_MetricSamplingStrategy == GRADIENT_MAGNITUDE );
+}
+
 ImageRegistrationMethod::Self& ImageRegistrationMethod::SetMetricUseFixedImageGradientFilter(bool arg)
 {
-  m_MetricUseFixedImageGradientFilter = arg;
+  m_Settings.m_MetricUseFixedImageGradientFilter = arg;
   return *this;
 }
 
 ImageRegistrationMethod::Self& ImageRegistrationMethod::SetMetricUseMovingImageGradientFilter(bool arg)
 {
-  m_MetricUseMovingImageGradientFilter = arg;
+  m_Settings.m_MetricUseMovingImageGradientFilter = arg;
   return *this;
 }
 
@@ -525,24 +721,56 @@ ImageRegistrationMethod::Self& ImageRegistrationMethod::SetMetricUseMovingImageG
 ImageRegistrationMethod::Self&
 ImageRegistrationMethod::SetShrinkFactorsPerLevel( const std::vector<unsigned int> &shrinkFactors )
 {
-  this->m_ShrinkFactorsPerLevel = shrinkFactors;
+  this->m_Settings.m_ShrinkFactorsPerLevel = shrinkFactors;
   return *this;
 }
 
 ImageRegistrationMethod::Self&
 ImageRegistrationMethod::SetSmoothingSigmasPerLevel( const std::vector<double> &smoothingSigmas )
 {
-  this->m_SmoothingSigmasPerLevel = smoothingSigmas;
+  this->m_Settings.m_SmoothingSigmasPerLevel = smoothingSigmas;
   return *this;
 }
 
 ImageRegistrationMethod::Self&
 ImageRegistrationMethod::SetSmoothingSigmasAreSpecifiedInPhysicalUnits(bool arg)
 {
-  m_SmoothingSigmasAreSpecifiedInPhysicalUnits = arg;
+  m_Settings.m_SmoothingSigmasAreSpecifiedInPhysicalUnits = arg;
   return *this;
 }
 
+ImageRegistrationMethod::Self&
+ImageRegistrationMethod::SetUseFixedImageCache(bool arg)
+{
+  m_UseFixedImageCache = arg;
+  if ( !arg )
+    {
+    this->ClearFixedImageCache();
+    }
+  return *this;
+}
+
+void ImageRegistrationMethod::ClearFixedImageCache()
+{
+  m_FixedImageCache.reset( new FixedImageCache );
+}
+
+uint64_t ImageRegistrationMethod::GetNumberOfFixedImageCacheHits() const
+{
+  itk::MutexLockHolder<itk::SimpleFastMutexLock> lock( m_FixedImageCache->Lock );
+  return m_FixedImageCache->NumberOfPyramidHits;
+}
+
+ImageRegistrationMethod::FixedImageCache &
+ImageRegistrationMethod::GetFixedImageCache()
+{
+  if ( m_BatchParent )
+    {
+    return m_BatchParent->GetFixedImageCache();
+    }
+  return *m_FixedImageCache;
+}
+
 std::string ImageRegistrationMethod::GetOptimizerStopConditionDescription() const
 {
   if (bool(this->m_pfGetOptimizerStopConditionDescription))
@@ -603,9 +831,9 @@ double ImageRegistrationMethod::GetMetricValue() const
 
 std::vector<double> ImageRegistrationMethod::GetOptimizerScales() const
 {
-  if(this->m_OptimizerScalesType==Manual)
+  if(this->m_Settings.m_OptimizerScalesType==Manual)
     {
-    return m_OptimizerScales;
+    return m_Settings.m_OptimizerScales;
     }
   else if(bool(this->m_pfGetOptimizerScales))
     {
@@ -629,13 +857,13 @@ template <typename TMetric>
  itk::RegistrationParameterScalesEstimator< TMetric >*
 ImageRegistrationMethod::CreateScalesEstimator()
 {
-  switch(m_OptimizerScalesType)
+  switch(m_Settings.m_OptimizerScalesType)
     {
     case Jacobian:
     {
       typedef RegistrationParameterScalesFromJacobian<TMetric> ScalesEstimatorType;
       typename ScalesEstimatorType::Pointer scalesEstimator = ScalesEstimatorType::New();
-      scalesEstimator->SetCentralRegionRadius(this->m_OptimizerScalesCentralRegionRadius);
+      scalesEstimator->SetCentralRegionRadius(this->m_Settings.m_OptimizerScalesCentralRegionRadius);
       scalesEstimator->Register();
       return scalesEstimator;
     }
@@ -643,8 +871,8 @@ ImageRegistrationMethod::CreateScalesEstimator()
     {
       typedef RegistrationParameterScalesFromIndexShift<TMetric> ScalesEstimatorType;
       typename ScalesEstimatorType::Pointer scalesEstimator = ScalesEstimatorType::New();
-      scalesEstimator->SetCentralRegionRadius(this->m_OptimizerScalesCentralRegionRadius);
-      scalesEstimator->SetSmallParameterVariation(this->m_OptimizerScalesSmallParameterVariation);
+      scalesEstimator->SetCentralRegionRadius(this->m_Settings.m_OptimizerScalesCentralRegionRadius);
+      scalesEstimator->SetSmallParameterVariation(this->m_Settings.m_OptimizerScalesSmallParameterVariation);
       scalesEstimator->Register();
       return scalesEstimator;
     }
@@ -652,8 +880,8 @@ ImageRegistrationMethod::CreateScalesEstimator()
     {
       typedef RegistrationParameterScalesFromPhysicalShift<TMetric> ScalesEstimatorType;
       typename ScalesEstimatorType::Pointer scalesEstimator = ScalesEstimatorType::New();
-      scalesEstimator->SetCentralRegionRadius(this->m_OptimizerScalesCentralRegionRadius);
-      scalesEstimator->SetSmallParameterVariation(this->m_OptimizerScalesSmallParameterVariation);
+      scalesEstimator->SetCentralRegionRadius(this->m_Settings.m_OptimizerScalesCentralRegionRadius);
+      scalesEstimator->SetSmallParameterVariation(this->m_Settings.m_OptimizerScalesSmallParameterVariation);
       scalesEstimator->Register();
       return scalesEstimator;
     }
@@ -696,8 +924,147 @@ ImageRegistrationMethod::CreateSpatialObjectMask(const Image &imageMask)
 }
 
 
+template <class TImageType>
+std::vector<typename TImageType::Pointer>
+ImageRegistrationMethod::GetFixedImagePyramid( const Image &inFixed )
+{
+  FixedImageCache &cache = this->GetFixedImageCache();
+  itk::MutexLockHolder<itk::SimpleFastMutexLock> lock( cache.Lock );
+
+  typename TImageType::ConstPointer fixed = this->CastImageToITK<TImageType>( inFixed );
+
+  const bool isCached = ( IsCachedImage( cache.FixedImage, fixed.GetPointer() )
+                          && cache.SmoothingSigmasPerLevel == m_Settings.m_SmoothingSigmasPerLevel
+                          && cache.SmoothingSigmasAreSpecifiedInPhysicalUnits == m_Settings.m_SmoothingSigmasAreSpecifiedInPhysicalUnits
+                          && cache.FixedImagePyramid.size() == m_Settings.m_SmoothingSigmasPerLevel.size() );
+
+  std::vector<typename TImageType::Pointer> pyramid( m_Settings.m_SmoothingSigmasPerLevel.size() );
+
+  if ( isCached )
+    {
+    for ( size_t level = 0; level < pyramid.size(); ++level )
+      {
+      pyramid[level] = dynamic_cast<TImageType*>( cache.FixedImagePyramid[level].GetPointer() );
+      }
+    ++cache.NumberOfPyramidHits;
+    return pyramid;
+    }
+
+  cache.FixedImage = Image();
+  cache.FixedImagePyramid.clear();
+  for ( size_t level = 0; level < pyramid.size(); ++level )
+    {
+    pyramid[level] = SmoothImageForLevel( fixed.GetPointer(),
+                                          m_Settings.m_SmoothingSigmasPerLevel[level],
+                                          m_Settings.m_SmoothingSigmasAreSpecifiedInPhysicalUnits,
+                                          this->GetNumberOfThreads() );
+    cache.FixedImagePyramid.push_back( pyramid[level].GetPointer() );
+    }
+
+  cache.FixedImage = inFixed;
+  cache.SmoothingSigmasPerLevel = m_Settings.m_SmoothingSigmasPerLevel;
+  cache.SmoothingSigmasAreSpecifiedInPhysicalUnits = m_Settings.m_SmoothingSigmasAreSpecifiedInPhysicalUnits;
+  return pyramid;
+}
+
+
+template<unsigned int VDimension>
+itk::SpatialObject<VDimension> *
+ImageRegistrationMethod::GetFixedMaskSpatialObject()
+{
+  FixedImageCache &cache = this->GetFixedImageCache();
+  itk::MutexLockHolder<itk::SimpleFastMutexLock> lock( cache.Lock );
+
+  const Image &cachedMask = cache.FixedMaskImage;
+  const Image &mask = m_Settings.m_MetricFixedMaskImage;
+  if ( !cache.FixedMask || cachedMask.GetITKBase() != mask.GetITKBase() )
+    {
+    itk::SpatialObject<VDimension> *mask = this->CreateSpatialObjectMask<VDimension>(m_Settings.m_MetricFixedMaskImage);
+    cache.FixedMask = mask;
+    mask->UnRegister();
+    cache.FixedMaskImage = m_Settings.m_MetricFixedMaskImage;
+    }
+
+  return dynamic_cast<itk::SpatialObject<VDimension> *>( cache.FixedMask.GetPointer() );
+}
+
+
+template <class TPointSetType, class TImageType>
+typename TPointSetType::Pointer
+ImageRegistrationMethod::GetMetricSamplePointSet( const TImageType *fixed, const Image &inFixed )
+{
+  FixedImageCache &cache = this->GetFixedImageCache();
+  itk::MutexLockHolder<itk::SimpleFastMutexLock> lock( cache.Lock );
+
+  const Image &cachedMask = cache.SamplingMaskImage;
+  const Image &mask = m_Settings.m_MetricSamplingMaskImage;
+  const double percentage = m_Settings.m_MetricSamplingPercentage.empty() ? 1.0 : m_Settings.m_MetricSamplingPercentage[0];
+
+  // explicit points do not depend on the fixed image and the
+  // sampling, but the points cached for an other dimension are of an
+  // other type
+  TPointSetType *cachedPointSet = dynamic_cast<TPointSetType *>( cache.SamplePointSet.GetPointer() );
+  const bool isCached = ( cachedPointSet
+                          && cache.SamplingPoints == m_Settings.m_MetricSamplingPoints
+                          && ( !m_Settings.m_MetricSamplingPoints.empty()
+                               || ( IsCachedImage( cache.SamplePointsFixedImage, fixed )
+                                    && cachedMask.GetITKBase() == mask.GetITKBase()
+                                    && cache.SamplingStrategy == m_Settings.m_MetricSamplingStrategy
+                                    && cache.SamplingPercentage == percentage
+                                    && cache.SamplingSeed == m_Settings.m_MetricSamplingSeed ) ) );
+
+  if ( isCached )
+    {
+    return cachedPointSet;
+    }
+
+  typename TPointSetType::Pointer pointSet;
+  if ( !m_Settings.m_MetricSamplingPoints.empty() )
+    {
+    pointSet = CreateMetricSamplePointSet<TPointSetType>( m_Settings.m_MetricSamplingPoints );
+    }
+  else
+    {
+    typedef itk::Image<unsigned char, TImageType::ImageDimension> MaskImageType;
+    typename MaskImageType::ConstPointer itkMask;
+    if ( m_Settings.m_MetricSamplingMaskImage.GetSize() != std::vector<unsigned int>(m_Settings.m_MetricSamplingMaskImage.GetDimension(), 0u) )
+      {
+      if ( m_Settings.m_MetricSamplingMaskImage.GetDimension() != TImageType::ImageDimension )
+        {
+        sitkExceptionMacro("MetricSamplingMask does not match dimension of the fixed image!");
+        }
+      Image uint8Mask = m_Settings.m_MetricSamplingMaskImage;
+      if ( uint8Mask.GetPixelID() != sitkUInt8 )
+        {
+        uint8Mask = Cast( uint8Mask, sitkUInt8 );
+        }
+      // the casted image is held by the ITK pointer
+      itkMask = this->CastImageToITK<MaskImageType>( uint8Mask );
+      }
+
+    pointSet = ComputeMetricSamplePointSet<TPointSetType>( fixed,
+                                                          itkMask.GetPointer(),
+                                                          m_Settings.m_MetricSamplingStrategy,
+                                                          percentage,
+                                                          m_Settings.m_MetricSamplingSeed,
+                                                          this->GetNumberOfThreads() );
+    }
+
+  cache.SamplePointsFixedImage = inFixed;
+  cache.SamplingMaskImage = m_Settings.m_MetricSamplingMaskImage;
+  cache.SamplingPoints = m_Settings.m_MetricSamplingPoints;
+  cache.SamplingStrategy = m_Settings.m_MetricSamplingStrategy;
+  cache.SamplingPercentage = percentage;
+  cache.SamplingSeed = m_Settings.m_MetricSamplingSeed;
+  cache.SamplePointSet = pointSet.GetPointer();
+  return pointSet;
+}
+
+
 Transform ImageRegistrationMethod::Execute ( const Image &fixed, const Image & moving )
 {
+  this->CheckStreamingNotRequested();
+
   const PixelIDValueType fixedType = fixed.GetPixelIDValue();
   const unsigned int fixedDim = fixed.GetDimension();
   if ( fixed.GetPixelIDValue() != moving.GetPixelIDValue() )
@@ -721,6 +1088,139 @@ Transform ImageRegistrationMethod::Execute ( const Image &fixed, const Image & m
 
 }
 
+std::vector<Transform> ImageRegistrationMethod::ExecuteBatch ( const Image &fixed, const std::vector<Image> &movingImages )
+{
+  this->CheckStreamingNotRequested();
+
+  for ( size_t i = 0; i < movingImages.size(); ++i )
+    {
+    if ( fixed.GetPixelIDValue() != movingImages[i].GetPixelIDValue() )
+      {
+      sitkExceptionMacro ( << "Fixed and moving image " << i << " must be the same datatype! Got "
+                           << fixed.GetPixelIDValue() << " and " << movingImages[i].GetPixelIDValue() );
+      }
+
+    if ( fixed.GetDimension() != movingImages[i].GetDimension() )
+      {
+      sitkExceptionMacro ( << "Fixed and moving image " << i << " must be the same dimensionality! Got "
+                           << fixed.GetDimension() << " and " << movingImages[i].GetDimension() );
+      }
+    }
+
+  if ( !this->m_MemberFactory->HasMemberFunction( fixed.GetPixelIDValue(), fixed.GetDimension() ) )
+    {
+    sitkExceptionMacro( << "Filter does not support fixed image type: " << itk::simple::GetPixelIDValueAsString (fixed.GetPixelIDValue()) );
+    }
+
+  this->m_BatchStopConditionDescriptions.clear();
+  this->m_BatchMetricValues.clear();
+  this->m_BatchIterations.clear();
+  this->m_BatchOptimizerCostSurfaces.clear();
+  this->m_BatchOptimizerCostSurfaceValues.clear();
+  this->m_BatchOptimizerCostSurfaceParameters.clear();
+
+  if ( movingImages.empty() )
+    {
+    return std::vector<Transform>();
+    }
+
+  // divide the threads between the concurrent registrations
+  const unsigned int numberOfThreads = this->GetNumberOfThreads();
+  unsigned int numberOfRegistrations = this->m_NumberOfConcurrentRegistrations;
+  if ( numberOfRegistrations == 0 )
+    {
+    numberOfRegistrations = std::max( 1u, numberOfThreads / 4 );
+    }
+  numberOfRegistrations = std::min( numberOfRegistrations, static_cast<unsigned int>( movingImages.size() ) );
+  const unsigned int threadsPerRegistration = std::max( 1u, numberOfThreads / numberOfRegistrations );
+
+  BatchRegistrations registrations;
+  for ( unsigned int i = 0; i < numberOfRegistrations; ++i )
+    {
+    registrations.m_Registrations.push_back( new ImageRegistrationMethod( this ) );
+    registrations.m_Registrations.back()->SetNumberOfThreads( threadsPerRegistration );
+    }
+
+  // each registration starts from its own copy of the initial
+  // transform, copied before executing concurrently
+  std::vector<BatchResult> results( movingImages.size() );
+  for ( size_t i = 0; i < results.size(); ++i )
+    {
+    results[i].RegistrationTransform = this->m_InitialTransform;
+    results[i].RegistrationTransform.MakeUnique();
+    }
+
+  TaskGraph graph;
+  graph.SetNumberOfThreads( numberOfRegistrations );
+
+  std::vector<ImageFuture> inputs( 2 );
+  inputs[0] = graph.AddImage( fixed );
+
+  std::vector<ImageFuture> futures;
+  for ( size_t i = 0; i < movingImages.size(); ++i )
+    {
+    ImageRegistrationMethod &registration = *registrations.m_Registrations[i % numberOfRegistrations];
+    inputs[1] = graph.AddImage( movingImages[i] );
+    futures.push_back( graph.Submit( registration,
+                                     BatchRegistrationTask( &registration, this->m_Settings.m_InitialTransformInPlace, &results[i] ),
+                                     inputs ) );
+    }
+
+  graph.Execute();
+
+  // the cache holds the copy of the fixed image given to a task,
+  // replace it by the fixed image which owns the buffer
+  FixedImageCache &cache = *this->m_FixedImageCache;
+  if ( this->m_UseFixedImageCache && cache.FixedImagePyramid.size() )
+    {
+    cache.FixedImage = fixed;
+    }
+  else
+    {
+    cache.FixedImage = Image();
+    cache.FixedImagePyramid.clear();
+    cache.FixedMaskImage = Image();
+    cache.FixedMask = SITK_NULLPTR;
+    }
+  if ( cache.SamplePointSet )
+    {
+    cache.SamplePointsFixedImage = fixed;
+    }
+
+  std::vector<Transform> transforms;
+  std::ostringstream failures;
+  for ( size_t i = 0; i < results.size(); ++i )
+    {
+    transforms.push_back( results[i].RegistrationTransform );
+    this->m_BatchStopConditionDescriptions.push_back( results[i].StopConditionDescription );
+    this->m_BatchMetricValues.push_back( results[i].MetricValue );
+    this->m_BatchIterations.push_back( results[i].Iteration );
+    this->m_BatchOptimizerCostSurfaces.push_back( results[i].CostSurface );
+    this->m_BatchOptimizerCostSurfaceValues.insert( this->m_BatchOptimizerCostSurfaceValues.end(),
+                                                    results[i].CostSurfaceValues.begin(),
+                                                    results[i].CostSurfaceValues.end() );
+    this->m_BatchOptimizerCostSurfaceParameters.insert( this->m_BatchOptimizerCostSurfaceParameters.end(),
+                                                        results[i].CostSurfaceParameters.begin(),
+                                                        results[i].CostSurfaceParameters.end() );
+
+    try
+      {
+      futures[i].Get();
+      }
+    catch ( std::exception &e )
+      {
+      failures << "Registration of moving image " << i << " failed: " << e.what() << std::endl;
+      }
+    }
+
+  if ( !failures.str().empty() )
+    {
+    sitkExceptionMacro( << failures.str() );
+    }
+
+  return transforms;
+}
+
 template<class TImageType>
 Transform ImageRegistrationMethod::ExecuteInternal ( const Image &inFixed, const Image &inMoving )
 {
@@ -729,8 +1229,16 @@ Transform ImageRegistrationMethod::ExecuteInternal ( const Image &inFixed, const
   const unsigned int ImageDimension = FixedImageType::ImageDimension;
   //typedef itk::SpatialObject<ImageDimension> SpatialObjectMaskType;
 
+  this->m_OptimizerCostSurface = Image();
+  this->m_OptimizerCostSurfaceValues.clear();
+  this->m_OptimizerCostSurfaceParameters.clear();
+
+  if ( this->m_Settings.m_OptimizerType == ParallelExhaustive )
+    {
+    return this->ExecuteParallelExhaustiveInternal<TImageType>( inFixed, inMoving );
+    }
 
-  typedef itk::ImageRegistrationMethodv4<FixedImageType, MovingImageType>  RegistrationType;
+  typedef FixedImagePyramidRegistrationMethodv4<FixedImageType, MovingImageType>  RegistrationType;
   typename RegistrationType::Pointer   registration  = RegistrationType::New();
 
   // this variable will hold the initial moving then fixed, then the
@@ -738,10 +1246,10 @@ Transform ImageRegistrationMethod::ExecuteInternal ( const Image &inFixed, const
   const std::string strIdentityTransform = "IdentityTransform";
 
   // Set initial moving transform
-  if ( strIdentityTransform != this->m_MovingInitialTransform.GetITKBase()->GetNameOfClass())
+  if ( strIdentityTransform != this->m_Settings.m_MovingInitialTransform.GetITKBase()->GetNameOfClass())
     {
     typename RegistrationType::InitialTransformType *itkTx;
-    if ( !(itkTx = dynamic_cast<typename RegistrationType::InitialTransformType *>(this->m_MovingInitialTransform.GetITKBase())) )
+    if ( !(itkTx = dynamic_cast<typename RegistrationType::InitialTransformType *>(this->m_Settings.m_MovingInitialTransform.GetITKBase())) )
       {
       sitkExceptionMacro( "Unexpected error converting initial moving transform! Possible miss matching dimensions!" );
       }
@@ -749,10 +1257,10 @@ Transform ImageRegistrationMethod::ExecuteInternal ( const Image &inFixed, const
     }
 
   // Set initial fixed transform
-  if ( strIdentityTransform != this->m_FixedInitialTransform.GetITKBase()->GetNameOfClass())
+  if ( strIdentityTransform != this->m_Settings.m_FixedInitialTransform.GetITKBase()->GetNameOfClass())
     {
     typename RegistrationType::InitialTransformType *itkTx;
-    if ( !(itkTx = dynamic_cast<typename RegistrationType::InitialTransformType *>(this->m_FixedInitialTransform.GetITKBase())) )
+    if ( !(itkTx = dynamic_cast<typename RegistrationType::InitialTransformType *>(this->m_Settings.m_FixedInitialTransform.GetITKBase())) )
       {
       sitkExceptionMacro( "Unexpected error converting initial moving transform! Possible miss matching dimensions!" );
       }
@@ -766,7 +1274,7 @@ Transform ImageRegistrationMethod::ExecuteInternal ( const Image &inFixed, const
     }
 
   registration->SetInitialTransform( itkTx );
-  registration->SetInPlace(this->m_InitialTransformInPlace);
+  registration->SetInPlace(this->m_Settings.m_InitialTransformInPlace);
 
 
   typedef itk::ObjectToObjectOptimizerBaseTemplate<double> _OptimizerType;
@@ -779,6 +1287,7 @@ Transform ImageRegistrationMethod::ExecuteInternal ( const Image &inFixed, const
   const bool stashedDebug = this->GetDebug();
   this->DebugOff();
   this->PreUpdate( registration.GetPointer() );
+  AcquiredThreadsReleaser releaseThreads( this );
   this->SetDebug(stashedDebug);
 
 
@@ -791,14 +1300,17 @@ Transform ImageRegistrationMethod::ExecuteInternal ( const Image &inFixed, const
   metric->UnRegister();
   this->SetupMetric(metric.GetPointer(), fixed.GetPointer(), moving.GetPointer());
 
+  // use the threads given to the registration from the shared pool
+  metric->SetMaximumNumberOfThreads(registration->GetNumberOfThreads());
+
   registration->SetMetric( metric );
 
   registration->SetFixedImage( fixed );
   registration->SetMovingImage( moving );
 
   // determine number of levels
-  const unsigned int numberOfLevels = m_ShrinkFactorsPerLevel.size();
-  if (m_ShrinkFactorsPerLevel.size() != m_SmoothingSigmasPerLevel.size())
+  const unsigned int numberOfLevels = m_Settings.m_ShrinkFactorsPerLevel.size();
+  if (m_Settings.m_ShrinkFactorsPerLevel.size() != m_Settings.m_SmoothingSigmasPerLevel.size())
     {
     sitkExceptionMacro( "Number of per level parameters for shrink factors and smoothing sigmas don't match!");
     }
@@ -806,43 +1318,58 @@ Transform ImageRegistrationMethod::ExecuteInternal ( const Image &inFixed, const
 
   // set sampling
 
-  // todo test enum match
-  typename RegistrationType::MetricSamplingStrategyType itkSamplingStrategy = static_cast<typename RegistrationType::MetricSamplingStrategyType>(int(m_MetricSamplingStrategy));
-  registration->SetMetricSamplingStrategy(itkSamplingStrategy);
+  if ( this->UseMetricSamplePointSet() )
+    {
+    // without a sampling strategy the registration keeps the sample
+    // points of the metric at each level
+    registration->SetMetricSamplingStrategy(RegistrationType::NONE);
+    metric->SetFixedSampledPointSet( this->GetMetricSamplePointSet<typename _MetricType::FixedSampledPointSetType>( fixed.GetPointer(), inFixed ) );
+    metric->SetUseFixedSampledPointSet( true );
+    }
+  else
+    {
+    // todo test enum match
+    typename RegistrationType::MetricSamplingStrategyType itkSamplingStrategy = static_cast<typename RegistrationType::MetricSamplingStrategyType>(int(m_Settings.m_MetricSamplingStrategy));
+    registration->SetMetricSamplingStrategy(itkSamplingStrategy);
+    }
 
-  if (m_MetricSamplingPercentage.size()==1)
+  if (m_Settings.m_MetricSamplingPercentage.size()==1)
     {
-    registration->SetMetricSamplingPercentage(this->m_MetricSamplingPercentage[0]);
+    registration->SetMetricSamplingPercentage(this->m_Settings.m_MetricSamplingPercentage[0]);
     }
   else
     {
-    if (m_ShrinkFactorsPerLevel.size() != m_MetricSamplingPercentage.size())
+    if (m_Settings.m_ShrinkFactorsPerLevel.size() != m_Settings.m_MetricSamplingPercentage.size())
       {
 
       }
-    typename RegistrationType::MetricSamplingPercentageArrayType param(m_MetricSamplingPercentage.size());
-    std::copy(m_MetricSamplingPercentage.begin(), m_MetricSamplingPercentage.end(), param.begin());
+    typename RegistrationType::MetricSamplingPercentageArrayType param(m_Settings.m_MetricSamplingPercentage.size());
+    std::copy(m_Settings.m_MetricSamplingPercentage.begin(), m_Settings.m_MetricSamplingPercentage.end(), param.begin());
     registration->SetMetricSamplingPercentagePerLevel(param);
     }
 
-  if ( m_MetricSamplingSeed == sitkWallClock )
+  if ( m_Settings.m_MetricSamplingSeed == sitkWallClock )
     {
     registration->MetricSamplingReinitializeSeed();
     }
   else
     {
-    registration->MetricSamplingReinitializeSeed(m_MetricSamplingSeed);
+    registration->MetricSamplingReinitializeSeed(m_Settings.m_MetricSamplingSeed);
     }
 
-  typename RegistrationType::ShrinkFactorsArrayType shrinkFactorsPerLevel( m_ShrinkFactorsPerLevel.size() );
-  std::copy(m_ShrinkFactorsPerLevel.begin(), m_ShrinkFactorsPerLevel.end(), shrinkFactorsPerLevel.begin());
+  typename RegistrationType::ShrinkFactorsArrayType shrinkFactorsPerLevel( m_Settings.m_ShrinkFactorsPerLevel.size() );
+  std::copy(m_Settings.m_ShrinkFactorsPerLevel.begin(), m_Settings.m_ShrinkFactorsPerLevel.end(), shrinkFactorsPerLevel.begin());
   registration->SetShrinkFactorsPerLevel( shrinkFactorsPerLevel );
 
-  typename RegistrationType::SmoothingSigmasArrayType smoothingSigmasPerLevel( m_SmoothingSigmasPerLevel.size() );
-  std::copy(m_SmoothingSigmasPerLevel.begin(), m_SmoothingSigmasPerLevel.end(), smoothingSigmasPerLevel.begin());
+  typename RegistrationType::SmoothingSigmasArrayType smoothingSigmasPerLevel( m_Settings.m_SmoothingSigmasPerLevel.size() );
+  std::copy(m_Settings.m_SmoothingSigmasPerLevel.begin(), m_Settings.m_SmoothingSigmasPerLevel.end(), smoothingSigmasPerLevel.begin());
   registration->SetSmoothingSigmasPerLevel( smoothingSigmasPerLevel );
-  registration->SetSmoothingSigmasAreSpecifiedInPhysicalUnits(m_SmoothingSigmasAreSpecifiedInPhysicalUnits);
+  registration->SetSmoothingSigmasAreSpecifiedInPhysicalUnits(m_Settings.m_SmoothingSigmasAreSpecifiedInPhysicalUnits);
 
+  if ( m_UseFixedImageCache )
+    {
+    registration->SetFixedImagePyramid( this->GetFixedImagePyramid<FixedImageType>( inFixed ), smoothingSigmasPerLevel );
+    }
 
   // setup transform parameters adaptor
   std::vector<typename RegistrationType::TransformParametersAdaptorPointer> adaptors =
@@ -852,14 +1379,14 @@ Transform ImageRegistrationMethod::ExecuteInternal ( const Image &inFixed, const
   //
   // Configure Optimizer
   //
-  optimizer->SetNumberOfThreads(this->GetNumberOfThreads());
+  optimizer->SetNumberOfThreads(registration->GetNumberOfThreads());
 
   registration->SetOptimizer( optimizer );
 
-  if ( m_OptimizerWeights.size( ) )
+  if ( m_Settings.m_OptimizerWeights.size( ) )
     {
-    itk::ObjectToObjectOptimizerBaseTemplate<double>::ScalesType weights(m_OptimizerWeights.size());
-    std::copy( m_OptimizerWeights.begin(), m_OptimizerWeights.end(), weights.begin() );
+    itk::ObjectToObjectOptimizerBaseTemplate<double>::ScalesType weights(m_Settings.m_OptimizerWeights.size());
+    std::copy( m_Settings.m_OptimizerWeights.begin(), m_Settings.m_OptimizerWeights.end(), weights.begin() );
     optimizer->SetWeights(weights);
     }
 
@@ -871,10 +1398,10 @@ Transform ImageRegistrationMethod::ExecuteInternal ( const Image &inFixed, const
     scalesEstimator->SetTransformForward( true );
     optimizer->SetScalesEstimator( scalesEstimator );
     }
-  else if ( m_OptimizerScales.size() )
+  else if ( m_Settings.m_OptimizerScales.size() )
     {
-    itk::ObjectToObjectOptimizerBaseTemplate<double>::ScalesType scales(m_OptimizerScales.size());
-    std::copy( m_OptimizerScales.begin(), m_OptimizerScales.end(), scales.begin() );
+    itk::ObjectToObjectOptimizerBaseTemplate<double>::ScalesType scales(m_Settings.m_OptimizerScales.size());
+    std::copy( m_Settings.m_OptimizerScales.begin(), m_Settings.m_OptimizerScales.end(), scales.begin() );
     optimizer->SetScales(scales);
     }
 
@@ -911,7 +1438,7 @@ Transform ImageRegistrationMethod::ExecuteInternal ( const Image &inFixed, const
   m_MetricValue = this->GetMetricValue();
   m_Iteration = this->GetOptimizerIteration();
 
-  if (this->m_InitialTransformInPlace)
+  if (this->m_Settings.m_InitialTransformInPlace)
     {
     if (m_pfUpdateWithBestValue)
       {
@@ -943,8 +1470,149 @@ Transform ImageRegistrationMethod::ExecuteInternal ( const Image &inFixed, const
 }
 
 
+template<class TImageType>
+Transform ImageRegistrationMethod::ExecuteParallelExhaustiveInternal ( const Image &inFixed, const Image &inMoving )
+{
+  typedef TImageType     FixedImageType;
+  typedef TImageType     MovingImageType;
+
+  const std::vector<double> initialParameters = this->m_InitialTransform.GetParameters();
+  const size_t numberOfParameters = initialParameters.size();
+  if ( this->m_Settings.m_OptimizerNumberOfSteps.size() != numberOfParameters )
+    {
+    sitkExceptionMacro( "Expected the number of steps to be of length " << numberOfParameters << "!" );
+    }
+
+  // the grid is scaled as by the Exhaustive optimizer
+  std::vector<double> scales( numberOfParameters, 1.0 );
+  typedef itk::ImageToImageMetricv4<FixedImageType, MovingImageType> _MetricType;
+  typename itk::RegistrationParameterScalesEstimator< _MetricType >::Pointer scalesEstimator = this->CreateScalesEstimator<_MetricType>();
+  if ( scalesEstimator )
+    {
+    scalesEstimator->UnRegister();
+
+    typename FixedImageType::ConstPointer fixed = this->CastImageToITK<FixedImageType>( inFixed );
+    typename MovingImageType::ConstPointer moving = this->CastImageToITK<MovingImageType>( inMoving );
+    Transform transform = this->m_InitialTransform;
+    transform.MakeUnique();
+    typename _MetricType::Pointer metric = this->CreateEvaluateMetric<FixedImageType>( fixed.GetPointer(),
+                                                                                       moving.GetPointer(),
+                                                                                       inFixed,
+                                                                                       transform,
+                                                                                       false,
+                                                                                       this->GetNumberOfThreads() );
+    metric->UnRegister();
+
+    scalesEstimator->SetMetric( metric );
+    scalesEstimator->SetTransformForward( true );
+    typename itk::RegistrationParameterScalesEstimator< _MetricType >::ScalesType estimatedScales;
+    scalesEstimator->EstimateScales( estimatedScales );
+    scales.assign( estimatedScales.begin(), estimatedScales.end() );
+    }
+  else if ( this->m_Settings.m_OptimizerScales.size() )
+    {
+    if ( this->m_Settings.m_OptimizerScales.size() != numberOfParameters )
+      {
+      sitkExceptionMacro( "Expected the optimizer scales to be of length " << numberOfParameters << "!" );
+      }
+    scales = this->m_Settings.m_OptimizerScales;
+    }
+
+  // the parameters of the grid points, the first parameter varying
+  // the fastest
+  std::vector<unsigned int> gridSize( numberOfParameters );
+  size_t numberOfPoints = 1;
+  for ( size_t p = 0; p < numberOfParameters; ++p )
+    {
+    gridSize[p] = 2*this->m_Settings.m_OptimizerNumberOfSteps[p] + 1;
+    numberOfPoints *= gridSize[p];
+    }
+
+  std::vector<double> parameters( numberOfPoints*numberOfParameters );
+  std::vector<unsigned int> gridIndex( numberOfParameters, 0u );
+  for ( size_t point = 0; point < numberOfPoints; ++point )
+    {
+    for ( size_t p = 0; p < numberOfParameters; ++p )
+      {
+      parameters[point*numberOfParameters + p] = initialParameters[p]
+        + ( static_cast<double>( gridIndex[p] ) - this->m_Settings.m_OptimizerNumberOfSteps[p] ) * this->m_Settings.m_OptimizerStepLength * scales[p];
+      }
+    for ( size_t p = 0; p < numberOfParameters && ++gridIndex[p] == gridSize[p]; ++p )
+      {
+      gridIndex[p] = 0;
+      }
+    }
+
+  const std::vector<double> values = this->EvaluateBatchInternal<TImageType>( inFixed, inMoving, parameters, false );
+  const size_t best = std::min_element( values.begin(), values.end() ) - values.begin();
+
+  // update measurements
+  std::ostringstream stopCondition;
+  stopCondition << "ParallelExhaustive: Completed sampling of parametric space of size " << numberOfPoints;
+  m_StopConditionDescription = stopCondition.str();
+  m_MetricValue = values[best];
+  m_Iteration = static_cast<unsigned int>( numberOfPoints );
+
+  this->m_OptimizerCostSurfaceValues = values;
+  this->m_OptimizerCostSurfaceParameters = parameters;
+
+  // the values as an image over the sampled parameters, when there
+  // are few enough of them for an image dimension
+  std::vector<size_t> sampledParameters;
+  for ( size_t p = 0; p < numberOfParameters; ++p )
+    {
+    if ( this->m_Settings.m_OptimizerNumberOfSteps[p] != 0 )
+      {
+      sampledParameters.push_back( p );
+      }
+    }
+
+  if ( sampledParameters.size() <= 3 )
+    {
+    const size_t dimension = std::max<size_t>( 2, sampledParameters.size() );
+    std::vector<unsigned int> size( dimension, 1u );
+    std::vector<double> origin( dimension, 0.0 );
+    std::vector<double> spacing( dimension, 1.0 );
+    for ( size_t d = 0; d < sampledParameters.size(); ++d )
+      {
+      const size_t p = sampledParameters[d];
+      size[d] = gridSize[p];
+      origin[d] = parameters[p];
+      spacing[d] = std::abs( this->m_Settings.m_OptimizerStepLength * scales[p] );
+      if ( spacing[d] == 0.0 )
+        {
+        spacing[d] = 1.0;
+        }
+      }
+
+    Image costSurface( size, sitkFloat64 );
+    costSurface.SetOrigin( origin );
+    costSurface.SetSpacing( spacing );
+    std::copy( values.begin(), values.end(), costSurface.GetBufferAsDouble() );
+    this->m_OptimizerCostSurface = costSurface;
+    }
+
+  const std::vector<double> bestParameters( parameters.begin() + best*numberOfParameters,
+                                            parameters.begin() + (best+1)*numberOfParameters );
+  if ( this->m_Settings.m_InitialTransformInPlace )
+    {
+    // the transform is shared with the caller, do not copy it
+    itk::TransformBase::ParametersType itkParameters( numberOfParameters );
+    std::copy( bestParameters.begin(), bestParameters.end(), itkParameters.begin() );
+    this->m_InitialTransform.GetITKBase()->SetParameters( itkParameters );
+    return this->m_InitialTransform;
+    }
+
+  Transform outTransform = this->m_InitialTransform;
+  outTransform.SetParameters( bestParameters );
+  return outTransform;
+}
+
+
 double ImageRegistrationMethod::MetricEvaluate ( const Image &fixed, const Image & moving )
 {
+  this->CheckStreamingNotRequested();
+
   const PixelIDValueType fixedType = fixed.GetPixelIDValue();
   const unsigned int fixedDim = fixed.GetDimension();
   if ( fixed.GetPixelIDValue() != moving.GetPixelIDValue() )
@@ -972,11 +1640,233 @@ double ImageRegistrationMethod::MetricEvaluate ( const Image &fixed, const Image
 
 template<class TImageType>
 double ImageRegistrationMethod::EvaluateInternal ( const Image &inFixed, const Image &inMoving )
+{
+  typedef TImageType     FixedImageType;
+  typedef TImageType     MovingImageType;
+
+  // Get the pointer to the ITK image contained in image1
+  typename FixedImageType::ConstPointer fixed = this->CastImageToITK<FixedImageType>( inFixed );
+  typename MovingImageType::ConstPointer moving = this->CastImageToITK<MovingImageType>( inMoving );
+
+  typedef itk::ImageToImageMetricv4<FixedImageType, MovingImageType> _MetricType;
+  typename _MetricType::Pointer metric = this->CreateEvaluateMetric<FixedImageType>( fixed.GetPointer(),
+                                                                                     moving.GetPointer(),
+                                                                                     inFixed,
+                                                                                     this->m_InitialTransform,
+                                                                                     false,
+                                                                                     this->GetNumberOfThreads() );
+  metric->UnRegister();
+
+  return metric->GetValue();
+}
+
+
+std::vector<double> ImageRegistrationMethod::MetricEvaluateBatch ( const Image &fixed,
+                                                                   const Image &moving,
+                                                                   const std::vector<double> &parameters,
+                                                                   bool computeDerivatives )
+{
+  this->CheckStreamingNotRequested();
+
+  const PixelIDValueType fixedType = fixed.GetPixelIDValue();
+  const unsigned int fixedDim = fixed.GetDimension();
+  if ( fixed.GetPixelIDValue() != moving.GetPixelIDValue() )
+    {
+    sitkExceptionMacro ( << "Fixed and moving images must be the same datatype! Got "
+                         << fixed.GetPixelIDValue() << " and " << moving.GetPixelIDValue() );
+    }
+
+  if ( fixed.GetDimension() != moving.GetDimension() )
+    {
+    sitkExceptionMacro ( << "Fixed and moving images must be the same dimensionality! Got "
+                         << fixed.GetDimension() << " and " << moving.GetDimension() );
+    }
+
+  if (this->m_EvaluateBatchMemberFactory->HasMemberFunction( fixedType, fixedDim ) )
+    {
+    return this->m_EvaluateBatchMemberFactory->GetMemberFunction( fixedType, fixedDim )( fixed, moving, parameters, computeDerivatives );
+    }
+
+  sitkExceptionMacro( << "Filter does not support fixed image type: " << itk::simple::GetPixelIDValueAsString (fixedType) );
+}
+
+
+namespace
+{
+
+// Evaluates the rows of a parameter matrix with a metric for each
+// thread, thread i of n evaluating the rows i, i+n, ...
+template <class TMetric>
+struct MetricEvaluateBatchThreader
+{
+  std::vector<typename TMetric::Pointer> m_Metrics;
+  const std::vector<double>             *m_Parameters;
+  bool                                   m_ComputeDerivatives;
+  std::vector<double>                   *m_Values;
+  std::vector<double>                   *m_Derivatives;
+  std::vector<std::string>               m_Errors;
+
+  static ITK_THREAD_RETURN_TYPE EvaluateCallback( void *arg )
+    {
+      typedef itk::MultiThreader::ThreadInfoStruct ThreadInfoType;
+      ThreadInfoType *threadInfo = static_cast< ThreadInfoType * >( arg );
+      static_cast<MetricEvaluateBatchThreader *>( threadInfo->UserData )->Evaluate( threadInfo->ThreadID,
+                                                                                threadInfo->NumberOfThreads );
+      return ITK_THREAD_RETURN_VALUE;
+    }
+
+  void Evaluate( unsigned int thread, unsigned int numberOfThreads )
+    {
+      TMetric *metric = m_Metrics[thread].GetPointer();
+      const unsigned int numberOfParameters = metric->GetNumberOfParameters();
+      const size_t numberOfRows = m_Values->size();
+
+      typename TMetric::ParametersType rowParameters( numberOfParameters );
+      typename TMetric::DerivativeType derivative( numberOfParameters );
+      try
+        {
+        for ( size_t row = thread; row < numberOfRows; row += numberOfThreads )
+          {
+          std::copy( m_Parameters->begin() + row*numberOfParameters,
+                     m_Parameters->begin() + (row+1)*numberOfParameters,
+                     rowParameters.begin() );
+          metric->SetParameters( rowParameters );
+
+          if ( m_ComputeDerivatives )
+            {
+            typename TMetric::MeasureType value;
+            metric->GetValueAndDerivative( value, derivative );
+            (*m_Values)[row] = value;
+            std::copy( derivative.begin(), derivative.end(), m_Derivatives->begin() + row*numberOfParameters );
+            }
+          else
+            {
+            (*m_Values)[row] = metric->GetValue();
+            }
+          }
+        }
+      catch ( std::exception &e )
+        {
+        m_Errors[thread] = e.what();
+        }
+    }
+};
+
+}
+
+
+template<class TImageType>
+std::vector<double> ImageRegistrationMethod::EvaluateBatchInternal ( const Image &inFixed,
+                                                                     const Image &inMoving,
+                                                                     const std::vector<double> &parameters,
+                                                                     bool computeDerivatives )
+{
+  typedef TImageType     FixedImageType;
+  typedef TImageType     MovingImageType;
+
+  this->m_MetricEvaluateBatchDerivatives.clear();
+
+  const unsigned int numberOfParameters = this->m_InitialTransform.GetITKBase()->GetNumberOfParameters();
+  if ( numberOfParameters == 0 || parameters.size() % numberOfParameters != 0 )
+    {
+    sitkExceptionMacro( "Expected the number of parameters, " << parameters.size()
+                        << ", to be a multiple of the number of parameters of the initial transform, "
+                        << numberOfParameters << "!" );
+    }
+  const size_t numberOfRows = parameters.size() / numberOfParameters;
+
+  std::vector<double> values( numberOfRows );
+  if ( numberOfRows == 0 )
+    {
+    return values;
+    }
+
+  typename FixedImageType::ConstPointer fixed = this->CastImageToITK<FixedImageType>( inFixed );
+  typename MovingImageType::ConstPointer moving = this->CastImageToITK<MovingImageType>( inMoving );
+
+  typedef itk::ImageToImageMetricv4<FixedImageType, MovingImageType> _MetricType;
+
+  // a metric for each thread, with its own copy of the transform,
+  // when there are fewer rows the threads are given to the metrics.
+  // The gradient images are computed by the first metric with all the
+  // threads, and shared by the others.
+  const unsigned int numberOfThreads = this->GetNumberOfThreads();
+  const unsigned int numberOfMetrics = static_cast<unsigned int>( std::min<size_t>( std::max( 1u, numberOfThreads ), numberOfRows ) );
+  const unsigned int threadsPerMetric = std::max( 1u, numberOfThreads / numberOfMetrics );
+
+  MetricEvaluateBatchThreader<_MetricType> threader;
+  std::vector<Transform> transforms( numberOfMetrics, this->m_InitialTransform );
+  for ( unsigned int i = 0; i < numberOfMetrics; ++i )
+    {
+    transforms[i].MakeUnique();
+    typename _MetricType::Pointer metric = this->CreateEvaluateMetric<FixedImageType>( fixed.GetPointer(),
+                                                                                       moving.GetPointer(),
+                                                                                       inFixed,
+                                                                                       transforms[i],
+                                                                                       computeDerivatives,
+                                                                                       i == 0 ? numberOfThreads : threadsPerMetric,
+                                                                                       i == 0 ? SITK_NULLPTR : threader.m_Metrics[0].GetPointer() );
+    metric->UnRegister();
+    metric->SetMaximumNumberOfThreads( threadsPerMetric );
+
+    if ( metric->GetNumberOfParameters() != numberOfParameters )
+      {
+      sitkExceptionMacro( "Unexpected number of parameters of the metric!" );
+      }
+    threader.m_Metrics.push_back( metric );
+    }
+
+  if ( computeDerivatives )
+    {
+    this->m_MetricEvaluateBatchDerivatives.resize( parameters.size() );
+    }
+
+  threader.m_Parameters = &parameters;
+  threader.m_ComputeDerivatives = computeDerivatives;
+  threader.m_Values = &values;
+  threader.m_Derivatives = &this->m_MetricEvaluateBatchDerivatives;
+  threader.m_Errors.resize( numberOfMetrics );
+
+  itk::MultiThreader::Pointer multiThreader = itk::MultiThreader::New();
+  multiThreader->SetNumberOfThreads( numberOfMetrics );
+  multiThreader->SetSingleMethod( MetricEvaluateBatchThreader<_MetricType>::EvaluateCallback, &threader );
+  multiThreader->SingleMethodExecute();
+
+  for ( unsigned int i = 0; i < numberOfMetrics; ++i )
+    {
+    if ( !threader.m_Errors[i].empty() )
+      {
+      sitkExceptionMacro( "Metric evaluation failed: " << threader.m_Errors[i] );
+      }
+    }
+
+  return values;
+}
+
+
+template <class TImageType>
+itk::ImageToImageMetricv4<TImageType,
+                          TImageType,
+                          TImageType,
+                          double,
+                          itk::DefaultImageToImageMetricTraitsv4< TImageType, TImageType, TImageType, double >
+                          >*
+ImageRegistrationMethod::CreateEvaluateMetric( const TImageType *fixed,
+                                               const TImageType *moving,
+                                               const Image &inFixed,
+                                               Transform &transform,
+                                               bool computeDerivatives,
+                                               unsigned int numberOfThreads,
+                                               const itk::ImageToImageMetricv4<TImageType,
+                                               TImageType,
+                                               TImageType,
+                                               double,
+                                               itk::DefaultImageToImageMetricTraitsv4< TImageType, TImageType, TImageType, double >
+                                               > *gradientMetric )
 {
   typedef TImageType     FixedImageType;
   typedef TImageType     MovingImageType;
   const unsigned int ImageDimension = FixedImageType::ImageDimension;
-  //typedef itk::SpatialObject<ImageDimension> SpatialObjectMaskType;
 
  typedef itk::ImageRegistrationMethodv4<FixedImageType, MovingImageType>  RegistrationType;
 
@@ -984,26 +1874,50 @@ double ImageRegistrationMethod::EvaluateInternal ( const Image &inFixed, const I
   // initial to optimize.
   const std::string strIdentityTransform = "IdentityTransform";
 
-  // Get the pointer to the ITK image contained in image1
-  typename FixedImageType::ConstPointer fixed = this->CastImageToITK<FixedImageType>( inFixed );
-  typename MovingImageType::ConstPointer moving = this->CastImageToITK<MovingImageType>( inMoving );
-
   typedef itk::ImageToImageMetricv4<FixedImageType, MovingImageType> _MetricType;
   typename _MetricType::Pointer metric = this->CreateMetric<FixedImageType>();
   metric->UnRegister();
 
-  this->SetupMetric(metric.GetPointer(), fixed.GetPointer(), moving.GetPointer());
+  this->SetupMetric(metric.GetPointer(), fixed, moving);
+  metric->SetMaximumNumberOfThreads( numberOfThreads );
+
+  // the gradient images are only used by the derivatives
+  if ( !computeDerivatives )
+    {
+    metric->SetUseFixedImageGradientFilter( false );
+    metric->SetUseMovingImageGradientFilter( false );
+    }
 
   metric->SetFixedImage(fixed);
   metric->SetMovingImage(moving);
 
+  // the gradient images of an other metric of the same images are
+  // used instead of computing them again
+  if ( gradientMetric )
+    {
+    if ( metric->GetUseFixedImageGradientFilter() && gradientMetric->GetFixedImageGradientImage() )
+      {
+      typedef SharedGradientImageFilter<FixedImageType, typename _MetricType::FixedImageGradientImageType> FixedGradientFilterType;
+      typename FixedGradientFilterType::Pointer fixedGradientFilter = FixedGradientFilterType::New();
+      fixedGradientFilter->SetGradientImage( gradientMetric->GetFixedImageGradientImage() );
+      metric->SetFixedImageGradientFilter( fixedGradientFilter );
+      }
+    if ( metric->GetUseMovingImageGradientFilter() && gradientMetric->GetMovingImageGradientImage() )
+      {
+      typedef SharedGradientImageFilter<MovingImageType, typename _MetricType::MovingImageGradientImageType> MovingGradientFilterType;
+      typename MovingGradientFilterType::Pointer movingGradientFilter = MovingGradientFilterType::New();
+      movingGradientFilter->SetGradientImage( gradientMetric->GetMovingImageGradientImage() );
+      metric->SetMovingImageGradientFilter( movingGradientFilter );
+      }
+    }
+
   typedef itk::CompositeTransform<double, ImageDimension> CompositeTransformType;
   typename CompositeTransformType::Pointer movingInitialCompositeTransform = CompositeTransformType::New();
   // Set initial moving transform
-  if ( strIdentityTransform != this->m_MovingInitialTransform.GetITKBase()->GetNameOfClass())
+  if ( strIdentityTransform != this->m_Settings.m_MovingInitialTransform.GetITKBase()->GetNameOfClass())
     {
     typename RegistrationType::InitialTransformType *itkTx;
-    if ( !(itkTx = dynamic_cast<typename RegistrationType::InitialTransformType *>(this->m_MovingInitialTransform.GetITKBase())) )
+    if ( !(itkTx = dynamic_cast<typename RegistrationType::InitialTransformType *>(this->m_Settings.m_MovingInitialTransform.GetITKBase())) )
       {
       sitkExceptionMacro( "Unexpected error converting initial moving transform! Possible miss matching dimensions!" );
       }
@@ -1011,10 +1925,10 @@ double ImageRegistrationMethod::EvaluateInternal ( const Image &inFixed, const I
     }
 
   // Set initial fixed transform
-  if ( strIdentityTransform != this->m_FixedInitialTransform.GetITKBase()->GetNameOfClass())
+  if ( strIdentityTransform != this->m_Settings.m_FixedInitialTransform.GetITKBase()->GetNameOfClass())
     {
     typename RegistrationType::InitialTransformType *itkTx;
-    if ( !(itkTx = dynamic_cast<typename RegistrationType::InitialTransformType *>(this->m_FixedInitialTransform.GetITKBase())) )
+    if ( !(itkTx = dynamic_cast<typename RegistrationType::InitialTransformType *>(this->m_Settings.m_FixedInitialTransform.GetITKBase())) )
       {
       sitkExceptionMacro( "Unexpected error converting initial moving transform! Possible miss matching dimensions!" );
       }
@@ -1022,16 +1936,25 @@ double ImageRegistrationMethod::EvaluateInternal ( const Image &inFixed, const I
     }
 
   typename RegistrationType::InitialTransformType *itkTx;
-  if ( !(itkTx = dynamic_cast<typename RegistrationType::InitialTransformType *>(this->m_InitialTransform.GetITKBase())) )
+  if ( !(itkTx = dynamic_cast<typename RegistrationType::InitialTransformType *>(transform.GetITKBase())) )
     {
     sitkExceptionMacro( "Unexpected error converting initial transform! Possible miss matching dimensions!" );
     }
   movingInitialCompositeTransform->AddTransform(itkTx);
+  // the parameters of the metric are those of the initial transform
+  movingInitialCompositeTransform->SetOnlyMostRecentTransformToOptimizeOn();
   metric->SetMovingTransform(movingInitialCompositeTransform);
 
+  if ( this->UseMetricSamplePointSet() )
+    {
+    metric->SetFixedSampledPointSet( this->GetMetricSamplePointSet<typename _MetricType::FixedSampledPointSetType>( fixed, inFixed ) );
+    metric->SetUseFixedSampledPointSet( true );
+    }
+
   metric->Initialize();
 
-  return metric->GetValue();
+  metric->Register();
+  return metric.GetPointer();
 }
 
 
@@ -1053,48 +1976,56 @@ ImageRegistrationMethod::SetupMetric(
 
   metric->SetMaximumNumberOfThreads(this->GetNumberOfThreads());
 
-  metric->SetUseFixedImageGradientFilter( m_MetricUseFixedImageGradientFilter );
-  metric->SetUseMovingImageGradientFilter( m_MetricUseMovingImageGradientFilter );
+  metric->SetUseFixedImageGradientFilter( m_Settings.m_MetricUseFixedImageGradientFilter );
+  metric->SetUseMovingImageGradientFilter( m_Settings.m_MetricUseMovingImageGradientFilter );
 
-  if ( this->m_VirtualDomainSize.size() != 0 )
+  if ( this->m_Settings.m_VirtualDomainSize.size() != 0 )
     {
-    typename FixedImageType::SpacingType itkSpacing = sitkSTLVectorToITK<typename FixedImageType::SpacingType>(this->m_VirtualDomainSpacing);
-    typename FixedImageType::PointType itkOrigin = sitkSTLVectorToITK<typename FixedImageType::PointType>(this->m_VirtualDomainOrigin);
-    typename FixedImageType::DirectionType itkDirection = sitkSTLToITKDirection<typename FixedImageType::DirectionType>(this->m_VirtualDomainDirection);
+    typename FixedImageType::SpacingType itkSpacing = sitkSTLVectorToITK<typename FixedImageType::SpacingType>(this->m_Settings.m_VirtualDomainSpacing);
+    typename FixedImageType::PointType itkOrigin = sitkSTLVectorToITK<typename FixedImageType::PointType>(this->m_Settings.m_VirtualDomainOrigin);
+    typename FixedImageType::DirectionType itkDirection = sitkSTLToITKDirection<typename FixedImageType::DirectionType>(this->m_Settings.m_VirtualDomainDirection);
 
     typename FixedImageType::RegionType itkRegion;
-    itkRegion.SetSize( sitkSTLVectorToITK<typename FixedImageType::SizeType>( this->m_VirtualDomainSize ) );
+    itkRegion.SetSize( sitkSTLVectorToITK<typename FixedImageType::SizeType>( this->m_Settings.m_VirtualDomainSize ) );
 
     metric->SetVirtualDomain( itkSpacing, itkOrigin, itkDirection, itkRegion );
     }
 
   typedef itk::InterpolateImageFunction< FixedImageType, double > FixedInterpolatorType;
-  typename FixedInterpolatorType::Pointer   fixedInterpolator  = CreateInterpolator(fixed, m_Interpolator);
+  typename FixedInterpolatorType::Pointer   fixedInterpolator  = CreateInterpolator(fixed, m_Settings.m_Interpolator);
   metric->SetFixedInterpolator( fixedInterpolator );
 
   typedef itk::InterpolateImageFunction< MovingImageType, double > MovingInterpolatorType;
-  typename MovingInterpolatorType::Pointer   movingInterpolator  = CreateInterpolator(moving, m_Interpolator);
+  typename MovingInterpolatorType::Pointer   movingInterpolator  = CreateInterpolator(moving, m_Settings.m_Interpolator);
   metric->SetMovingInterpolator( movingInterpolator );
 
   // todo implement ImageRegionSpatialObject
-  if ( m_MetricFixedMaskImage.GetSize() != std::vector<unsigned int>(m_MetricFixedMaskImage.GetDimension(), 0u) )
+  if ( m_Settings.m_MetricFixedMaskImage.GetSize() != std::vector<unsigned int>(m_Settings.m_MetricFixedMaskImage.GetDimension(), 0u) )
     {
-    if ( m_MetricFixedMaskImage.GetDimension() != FixedImageType::ImageDimension )
+    if ( m_Settings.m_MetricFixedMaskImage.GetDimension() != FixedImageType::ImageDimension )
       {
       sitkExceptionMacro("FixedMaskImage does not match dimension of then fixed image!");
       }
-    typename SpatialObjectMaskType::ConstPointer fixedMask = this->CreateSpatialObjectMask<ImageDimension>(m_MetricFixedMaskImage);
-    fixedMask->UnRegister();
+    typename SpatialObjectMaskType::ConstPointer fixedMask;
+    if ( m_UseFixedImageCache )
+      {
+      fixedMask = this->GetFixedMaskSpatialObject<ImageDimension>();
+      }
+    else
+      {
+      fixedMask = this->CreateSpatialObjectMask<ImageDimension>(m_Settings.m_MetricFixedMaskImage);
+      fixedMask->UnRegister();
+      }
     metric->SetFixedImageMask(fixedMask);
     }
 
-  if ( m_MetricMovingMaskImage.GetSize() != std::vector<unsigned int>(m_MetricMovingMaskImage.GetDimension(), 0u) )
+  if ( m_Settings.m_MetricMovingMaskImage.GetSize() != std::vector<unsigned int>(m_Settings.m_MetricMovingMaskImage.GetDimension(), 0u) )
     {
-    if ( m_MetricMovingMaskImage.GetDimension() != MovingImageType::ImageDimension )
+    if ( m_Settings.m_MetricMovingMaskImage.GetDimension() != MovingImageType::ImageDimension )
       {
       sitkExceptionMacro("MovingMaskImage does not match dimension of the moving image!");
       }
-    typename SpatialObjectMaskType::ConstPointer movingMask = this->CreateSpatialObjectMask<ImageDimension>(m_MetricMovingMaskImage);
+    typename SpatialObjectMaskType::ConstPointer movingMask = this->CreateSpatialObjectMask<ImageDimension>(m_Settings.m_MetricMovingMaskImage);
     movingMask->UnRegister();
     metric->SetMovingImageMask(movingMask);
     }
@@ -45,7 +45,7 @@ ImageRegistrationMethod::CreateMetric( )
   typedef TImageType     MovingImageType;
 
 
-  switch (m_MetricType)
+  switch (m_Settings.m_MetricType)
     {
     case ANTSNeighborhoodCorrelation:
     {
@@ -53,7 +53,7 @@ ImageRegistrationMethod::CreateMetric( )
 
       typename _MetricType::Pointer metric = _MetricType::New();
       typename _MetricType::RadiusType radius;
-      radius.Fill( m_MetricRadius );
+      radius.Fill( m_Settings.m_MetricRadius );
       metric->SetRadius( radius );
       metric->Register();
       return metric.GetPointer();
@@ -70,7 +70,7 @@ ImageRegistrationMethod::CreateMetric( )
     {
       typedef itk::DemonsImageToImageMetricv4< FixedImageType, MovingImageType > _MetricType;
       typename _MetricType::Pointer metric = _MetricType::New();
-      metric->SetIntensityDifferenceThreshold(m_MetricIntensityDifferenceThreshold);
+      metric->SetIntensityDifferenceThreshold(m_Settings.m_MetricIntensityDifferenceThreshold);
       metric->Register();
       return metric.GetPointer();
     }
@@ -78,8 +78,8 @@ ImageRegistrationMethod::CreateMetric( )
     {
       typedef itk::JointHistogramMutualInformationImageToImageMetricv4< FixedImageType, MovingImageType > _MetricType;
       typename _MetricType::Pointer metric = _MetricType::New();
-      metric->SetNumberOfHistogramBins(m_MetricNumberOfHistogramBins);
-      metric->SetVarianceForJointPDFSmoothing(m_MetricVarianceForJointPDFSmoothing);
+      metric->SetNumberOfHistogramBins(m_Settings.m_MetricNumberOfHistogramBins);
+      metric->SetVarianceForJointPDFSmoothing(m_Settings.m_MetricVarianceForJointPDFSmoothing);
       metric->Register();
       return metric.GetPointer();
     }
@@ -94,7 +94,7 @@ ImageRegistrationMethod::CreateMetric( )
     {
       typedef itk::MattesMutualInformationImageToImageMetricv4< FixedImageType, MovingImageType > _MetricType;
       typename _MetricType::Pointer metric = _MetricType::New();
-      metric->SetNumberOfHistogramBins(m_MetricNumberOfHistogramBins);
+      metric->SetNumberOfHistogramBins(m_Settings.m_MetricNumberOfHistogramBins);
       metric->Register();
       return metric.GetPointer();
     }
@@ -84,21 +84,21 @@ namespace simple
   {
     typedef double InternalComputationValueType;
 
-    if ( m_OptimizerType == ConjugateGradientLineSearch )
+    if ( m_Settings.m_OptimizerType == ConjugateGradientLineSearch )
       {
       typedef itk::ConjugateGradientLineSearchOptimizerv4Template<InternalComputationValueType> _OptimizerType;
       _OptimizerType::Pointer      optimizer     = _OptimizerType::New();
-      optimizer->SetLearningRate( this->m_OptimizerLearningRate );
-      optimizer->SetNumberOfIterations( this->m_OptimizerNumberOfIterations );
-      optimizer->SetMinimumConvergenceValue( this->m_OptimizerConvergenceMinimumValue );
-      optimizer->SetConvergenceWindowSize( this->m_OptimizerConvergenceWindowSize );
-      optimizer->SetLowerLimit( this->m_OptimizerLineSearchLowerLimit);
-      optimizer->SetUpperLimit( this->m_OptimizerLineSearchUpperLimit);
-      optimizer->SetEpsilon( this->m_OptimizerLineSearchEpsilon);
-      optimizer->SetMaximumLineSearchIterations( this->m_OptimizerLineSearchMaximumIterations);
-      optimizer->SetDoEstimateLearningRateAtEachIteration( this->m_OptimizerEstimateLearningRate==EachIteration );
-      optimizer->SetDoEstimateLearningRateOnce( this->m_OptimizerEstimateLearningRate==Once );
-      optimizer->SetMaximumStepSizeInPhysicalUnits( this->m_OptimizerMaximumStepSizeInPhysicalUnits );
+      optimizer->SetLearningRate( this->m_Settings.m_OptimizerLearningRate );
+      optimizer->SetNumberOfIterations( this->m_Settings.m_OptimizerNumberOfIterations );
+      optimizer->SetMinimumConvergenceValue( this->m_Settings.m_OptimizerConvergenceMinimumValue );
+      optimizer->SetConvergenceWindowSize( this->m_Settings.m_OptimizerConvergenceWindowSize );
+      optimizer->SetLowerLimit( this->m_Settings.m_OptimizerLineSearchLowerLimit);
+      optimizer->SetUpperLimit( this->m_Settings.m_OptimizerLineSearchUpperLimit);
+      optimizer->SetEpsilon( this->m_Settings.m_OptimizerLineSearchEpsilon);
+      optimizer->SetMaximumLineSearchIterations( this->m_Settings.m_OptimizerLineSearchMaximumIterations);
+      optimizer->SetDoEstimateLearningRateAtEachIteration( this->m_Settings.m_OptimizerEstimateLearningRate==EachIteration );
+      optimizer->SetDoEstimateLearningRateOnce( this->m_Settings.m_OptimizerEstimateLearningRate==Once );
+      optimizer->SetMaximumStepSizeInPhysicalUnits( this->m_Settings.m_OptimizerMaximumStepSizeInPhysicalUnits );
 
       this->m_pfGetMetricValue = nsstd::bind(&_OptimizerType::GetCurrentMetricValue,optimizer.GetPointer());
       this->m_pfGetOptimizerIteration = nsstd::bind(&CurrentIterationCustomCast::CustomCast,optimizer.GetPointer());
@@ -110,17 +110,17 @@ namespace simple
       optimizer->Register();
       return optimizer.GetPointer();
       }
-    else if ( m_OptimizerType == GradientDescent )
+    else if ( m_Settings.m_OptimizerType == GradientDescent )
       {
       typedef itk::GradientDescentOptimizerv4Template<InternalComputationValueType> _OptimizerType;
       _OptimizerType::Pointer      optimizer     = _OptimizerType::New();
-      optimizer->SetLearningRate( this->m_OptimizerLearningRate );
-      optimizer->SetNumberOfIterations( this->m_OptimizerNumberOfIterations );
-      optimizer->SetMinimumConvergenceValue( this->m_OptimizerConvergenceMinimumValue );
-      optimizer->SetConvergenceWindowSize( this->m_OptimizerConvergenceWindowSize );
-      optimizer->SetDoEstimateLearningRateAtEachIteration( this->m_OptimizerEstimateLearningRate==EachIteration );
-      optimizer->SetDoEstimateLearningRateOnce( this->m_OptimizerEstimateLearningRate==Once );
-      optimizer->SetMaximumStepSizeInPhysicalUnits( this->m_OptimizerMaximumStepSizeInPhysicalUnits );
+      optimizer->SetLearningRate( this->m_Settings.m_OptimizerLearningRate );
+      optimizer->SetNumberOfIterations( this->m_Settings.m_OptimizerNumberOfIterations );
+      optimizer->SetMinimumConvergenceValue( this->m_Settings.m_OptimizerConvergenceMinimumValue );
+      optimizer->SetConvergenceWindowSize( this->m_Settings.m_OptimizerConvergenceWindowSize );
+      optimizer->SetDoEstimateLearningRateAtEachIteration( this->m_Settings.m_OptimizerEstimateLearningRate==EachIteration );
+      optimizer->SetDoEstimateLearningRateOnce( this->m_Settings.m_OptimizerEstimateLearningRate==Once );
+      optimizer->SetMaximumStepSizeInPhysicalUnits( this->m_Settings.m_OptimizerMaximumStepSizeInPhysicalUnits );
 
       this->m_pfGetMetricValue = nsstd::bind(&_OptimizerType::GetCurrentMetricValue,optimizer.GetPointer());
       this->m_pfGetOptimizerIteration = nsstd::bind(&CurrentIterationCustomCast::CustomCast,optimizer.GetPointer());
@@ -132,21 +132,21 @@ namespace simple
       optimizer->Register();
       return optimizer.GetPointer();
       }
-    else if ( m_OptimizerType == GradientDescentLineSearch )
+    else if ( m_Settings.m_OptimizerType == GradientDescentLineSearch )
       {
       typedef itk::GradientDescentLineSearchOptimizerv4Template<InternalComputationValueType> _OptimizerType;
       _OptimizerType::Pointer      optimizer     = _OptimizerType::New();
-      optimizer->SetLearningRate( this->m_OptimizerLearningRate );
-      optimizer->SetNumberOfIterations( this->m_OptimizerNumberOfIterations );
-      optimizer->SetMinimumConvergenceValue( this->m_OptimizerConvergenceMinimumValue );
-      optimizer->SetConvergenceWindowSize( this->m_OptimizerConvergenceWindowSize );
-      optimizer->SetLowerLimit( this->m_OptimizerLineSearchLowerLimit);
-      optimizer->SetUpperLimit( this->m_OptimizerLineSearchUpperLimit);
-      optimizer->SetEpsilon( this->m_OptimizerLineSearchEpsilon);
-      optimizer->SetMaximumLineSearchIterations( this->m_OptimizerLineSearchMaximumIterations);
-      optimizer->SetDoEstimateLearningRateAtEachIteration( this->m_OptimizerEstimateLearningRate==EachIteration );
-      optimizer->SetDoEstimateLearningRateOnce( this->m_OptimizerEstimateLearningRate==Once );
-      optimizer->SetMaximumStepSizeInPhysicalUnits( this->m_OptimizerMaximumStepSizeInPhysicalUnits );
+      optimizer->SetLearningRate( this->m_Settings.m_OptimizerLearningRate );
+      optimizer->SetNumberOfIterations( this->m_Settings.m_OptimizerNumberOfIterations );
+      optimizer->SetMinimumConvergenceValue( this->m_Settings.m_OptimizerConvergenceMinimumValue );
+      optimizer->SetConvergenceWindowSize( this->m_Settings.m_OptimizerConvergenceWindowSize );
+      optimizer->SetLowerLimit( this->m_Settings.m_OptimizerLineSearchLowerLimit);
+      optimizer->SetUpperLimit( this->m_Settings.m_OptimizerLineSearchUpperLimit);
+      optimizer->SetEpsilon( this->m_Settings.m_OptimizerLineSearchEpsilon);
+      optimizer->SetMaximumLineSearchIterations( this->m_Settings.m_OptimizerLineSearchMaximumIterations);
+      optimizer->SetDoEstimateLearningRateAtEachIteration( this->m_Settings.m_OptimizerEstimateLearningRate==EachIteration );
+      optimizer->SetDoEstimateLearningRateOnce( this->m_Settings.m_OptimizerEstimateLearningRate==Once );
+      optimizer->SetMaximumStepSizeInPhysicalUnits( this->m_Settings.m_OptimizerMaximumStepSizeInPhysicalUnits );
 
       this->m_pfGetMetricValue = nsstd::bind(&_OptimizerType::GetCurrentMetricValue,optimizer.GetPointer());
       this->m_pfGetOptimizerIteration = nsstd::bind(&CurrentIterationCustomCast::CustomCast,optimizer.GetPointer());
@@ -158,19 +158,19 @@ namespace simple
       optimizer->Register();
       return optimizer.GetPointer();
       }
-    else if ( m_OptimizerType == RegularStepGradientDescent )
+    else if ( m_Settings.m_OptimizerType == RegularStepGradientDescent )
       {
       typedef itk::RegularStepGradientDescentOptimizerv4<InternalComputationValueType> _OptimizerType;
       _OptimizerType::Pointer      optimizer =  _OptimizerType::New();
 
-      optimizer->SetLearningRate( this->m_OptimizerLearningRate );
-      optimizer->SetMinimumStepLength( this->m_OptimizerMinimumStepLength );
-      optimizer->SetNumberOfIterations( this->m_OptimizerNumberOfIterations  );
-      optimizer->SetRelaxationFactor( this->m_OptimizerRelaxationFactor );
-      optimizer->SetGradientMagnitudeTolerance( this->m_OptimizerGradientMagnitudeTolerance );
-      optimizer->SetDoEstimateLearningRateAtEachIteration( this->m_OptimizerEstimateLearningRate==EachIteration );
-      optimizer->SetDoEstimateLearningRateOnce( this->m_OptimizerEstimateLearningRate==Once );
-      optimizer->SetMaximumStepSizeInPhysicalUnits( this->m_OptimizerMaximumStepSizeInPhysicalUnits );
+      optimizer->SetLearningRate( this->m_Settings.m_OptimizerLearningRate );
+      optimizer->SetMinimumStepLength( this->m_Settings.m_OptimizerMinimumStepLength );
+      optimizer->SetNumberOfIterations( this->m_Settings.m_OptimizerNumberOfIterations  );
+      optimizer->SetRelaxationFactor( this->m_Settings.m_OptimizerRelaxationFactor );
+      optimizer->SetGradientMagnitudeTolerance( this->m_Settings.m_OptimizerGradientMagnitudeTolerance );
+      optimizer->SetDoEstimateLearningRateAtEachIteration( this->m_Settings.m_OptimizerEstimateLearningRate==EachIteration );
+      optimizer->SetDoEstimateLearningRateOnce( this->m_Settings.m_OptimizerEstimateLearningRate==Once );
+      optimizer->SetMaximumStepSizeInPhysicalUnits( this->m_Settings.m_OptimizerMaximumStepSizeInPhysicalUnits );
       optimizer->Register();
 
       this->m_pfGetMetricValue = nsstd::bind(&_OptimizerType::GetValue,optimizer);
@@ -182,16 +182,16 @@ namespace simple
 
       return optimizer.GetPointer();
       }
-    else if ( m_OptimizerType == LBFGSB )
+    else if ( m_Settings.m_OptimizerType == LBFGSB )
       {
       typedef itk::LBFGSBOptimizerv4 _OptimizerType;
       _OptimizerType::Pointer      optimizer =  _OptimizerType::New();
 
-      optimizer->SetGradientConvergenceTolerance( this->m_OptimizerGradientConvergenceTolerance );
-      optimizer->SetNumberOfIterations( this->m_OptimizerNumberOfIterations );
-      optimizer->SetMaximumNumberOfCorrections( this->m_OptimizerMaximumNumberOfCorrections  );
-      optimizer->SetMaximumNumberOfFunctionEvaluations( this->m_OptimizerMaximumNumberOfFunctionEvaluations );
-      optimizer->SetCostFunctionConvergenceFactor( this->m_OptimizerCostFunctionConvergenceFactor );
+      optimizer->SetGradientConvergenceTolerance( this->m_Settings.m_OptimizerGradientConvergenceTolerance );
+      optimizer->SetNumberOfIterations( this->m_Settings.m_OptimizerNumberOfIterations );
+      optimizer->SetMaximumNumberOfCorrections( this->m_Settings.m_OptimizerMaximumNumberOfCorrections  );
+      optimizer->SetMaximumNumberOfFunctionEvaluations( this->m_Settings.m_OptimizerMaximumNumberOfFunctionEvaluations );
+      optimizer->SetCostFunctionConvergenceFactor( this->m_Settings.m_OptimizerCostFunctionConvergenceFactor );
 
       #define NOBOUND     0 // 00
       #define LOWERBOUND  1 // 01
@@ -200,11 +200,11 @@ namespace simple
 
       unsigned char flag = NOBOUND;
       const unsigned int sitkToITK[] = {0,1,3,2};
-      if ( this->m_OptimizerLowerBound != std::numeric_limits<double>::min() )
+      if ( this->m_Settings.m_OptimizerLowerBound != std::numeric_limits<double>::min() )
         {
         flag |= LOWERBOUND;
         }
-      if ( this->m_OptimizerUpperBound != std::numeric_limits<double>::max() )
+      if ( this->m_Settings.m_OptimizerUpperBound != std::numeric_limits<double>::max() )
         {
         flag |= UPPERBOUND;
         }
@@ -214,13 +214,13 @@ namespace simple
       _OptimizerType::BoundValueType upperBound( numberOfTransformParameters );
 
       boundSelection.Fill( sitkToITK[flag] );
-      lowerBound.Fill( this->m_OptimizerUpperBound );
-      upperBound.Fill( this->m_OptimizerUpperBound );
+      lowerBound.Fill( this->m_Settings.m_OptimizerUpperBound );
+      upperBound.Fill( this->m_Settings.m_OptimizerUpperBound );
 
       optimizer->SetBoundSelection( boundSelection );
       optimizer->SetLowerBound( lowerBound  );
       optimizer->SetUpperBound( upperBound  );
-      optimizer->SetTrace( m_OptimizerTrace );
+      optimizer->SetTrace( m_Settings.m_OptimizerTrace );
       optimizer->Register();
 
       this->m_pfGetMetricValue = nsstd::bind(&_OptimizerType::GetValue,optimizer.GetPointer());
@@ -230,13 +230,13 @@ namespace simple
 
       return optimizer.GetPointer();
       }
-    else if ( m_OptimizerType == Exhaustive )
+    else if ( m_Settings.m_OptimizerType == Exhaustive )
       {
       typedef itk::ExhaustiveOptimizerv4<double> _OptimizerType;
       _OptimizerType::Pointer      optimizer     = _OptimizerType::New();
 
-      optimizer->SetStepLength( this->m_OptimizerStepLength );
-      optimizer->SetNumberOfSteps( sitkSTLVectorToITKArray<_OptimizerType::StepsType::ValueType>(this->m_OptimizerNumberOfSteps));
+      optimizer->SetStepLength( this->m_Settings.m_OptimizerStepLength );
+      optimizer->SetNumberOfSteps( sitkSTLVectorToITKArray<_OptimizerType::StepsType::ValueType>(this->m_Settings.m_OptimizerNumberOfSteps));
 
       this->m_pfGetMetricValue = nsstd::bind(&_OptimizerType::GetCurrentValue,optimizer);
       this->m_pfGetOptimizerIteration = nsstd::bind(&CurrentIterationCustomCast::CustomCast,optimizer.GetPointer());
@@ -253,19 +253,19 @@ namespace simple
       optimizer->Register();
       return optimizer.GetPointer();
       }
-    else if( m_OptimizerType == Amoeba )
+    else if( m_Settings.m_OptimizerType == Amoeba )
       {
       typedef itk::AmoebaOptimizerv4 _OptimizerType;
       _OptimizerType::Pointer      optimizer     = _OptimizerType::New();
 
       _OptimizerType::ParametersType simplexDelta( numberOfTransformParameters );
-      simplexDelta.Fill( this->m_OptimizerSimplexDelta );
+      simplexDelta.Fill( this->m_Settings.m_OptimizerSimplexDelta );
       optimizer->SetInitialSimplexDelta( simplexDelta );
 
-      optimizer->SetNumberOfIterations( this->m_OptimizerNumberOfIterations  );
-      optimizer->SetParametersConvergenceTolerance(this->m_OptimizerParametersConvergenceTolerance);
-      optimizer->SetFunctionConvergenceTolerance(this->m_OptimizerFunctionConvergenceTolerance);
-      optimizer->SetOptimizeWithRestarts(this->m_OptimizerWithRestarts);
+      optimizer->SetNumberOfIterations( this->m_Settings.m_OptimizerNumberOfIterations  );
+      optimizer->SetParametersConvergenceTolerance(this->m_Settings.m_OptimizerParametersConvergenceTolerance);
+      optimizer->SetFunctionConvergenceTolerance(this->m_Settings.m_OptimizerFunctionConvergenceTolerance);
+      optimizer->SetOptimizeWithRestarts(this->m_Settings.m_OptimizerWithRestarts);
 
 
       this->m_pfGetMetricValue = nsstd::bind(&_OptimizerType::GetValue,optimizer);
@@ -276,16 +276,16 @@ namespace simple
       optimizer->Register();
       return optimizer.GetPointer();
       }
-    else if ( m_OptimizerType == Powell )
+    else if ( m_Settings.m_OptimizerType == Powell )
       {
       typedef itk::PowellOptimizerv4<double> _OptimizerType;
       _OptimizerType::Pointer optimizer = _OptimizerType::New();
 
-      optimizer->SetMaximumIteration( this->m_OptimizerNumberOfIterations );
-      optimizer->SetMaximumLineIteration( this->m_OptimizerMaximumLineIterations );
-      optimizer->SetStepLength(this->m_OptimizerStepLength );
-      optimizer->SetStepTolerance( this->m_OptimizerStepTolerance );
-      optimizer->SetValueTolerance( this->m_OptimizerValueTolerance );
+      optimizer->SetMaximumIteration( this->m_Settings.m_OptimizerNumberOfIterations );
+      optimizer->SetMaximumLineIteration( this->m_Settings.m_OptimizerMaximumLineIterations );
+      optimizer->SetStepLength(this->m_Settings.m_OptimizerStepLength );
+      optimizer->SetStepTolerance( this->m_Settings.m_OptimizerStepTolerance );
+      optimizer->SetValueTolerance( this->m_Settings.m_OptimizerValueTolerance );
 
       this->m_pfGetMetricValue = nsstd::bind(&_OptimizerType::GetValue,optimizer.GetPointer());
       this->m_pfGetOptimizerIteration = nsstd::bind(&CurrentIterationCustomCast::CustomCast,optimizer.GetPointer());
@@ -295,19 +295,19 @@ namespace simple
       optimizer->Register();
       return optimizer.GetPointer();
       }
-    else if ( m_OptimizerType == OnePlusOneEvolutionary )
+    else if ( m_Settings.m_OptimizerType == OnePlusOneEvolutionary )
       {
        typedef itk::OnePlusOneEvolutionaryOptimizerv4<double> _OptimizerType;
       _OptimizerType::Pointer optimizer = _OptimizerType::New();
-      optimizer->SetMaximumIteration( this->m_OptimizerNumberOfIterations );
-      optimizer->SetEpsilon( this->m_OptimizerEpsilon );
-      optimizer->Initialize( this->m_OptimizerInitialRadius,
-                             this->m_OptimizerGrowthFactor,
-                             this->m_OptimizerShrinkFactor);
+      optimizer->SetMaximumIteration( this->m_Settings.m_OptimizerNumberOfIterations );
+      optimizer->SetEpsilon( this->m_Settings.m_OptimizerEpsilon );
+      optimizer->Initialize( this->m_Settings.m_OptimizerInitialRadius,
+                             this->m_Settings.m_OptimizerGrowthFactor,
+                             this->m_Settings.m_OptimizerShrinkFactor);
 
       typedef itk::Statistics::NormalVariateGenerator  GeneratorType;
       GeneratorType::Pointer generator = GeneratorType::New();
-      if ( this->m_OptimizerSeed == sitkWallClock )
+      if ( this->m_Settings.m_OptimizerSeed == sitkWallClock )
         {
         // use time() and clock() to generate a unlikely-to-repeat
         // seed.
@@ -317,7 +317,7 @@ namespace simple
         }
       else
         {
-        generator->Initialize(this->m_OptimizerSeed);
+        generator->Initialize(this->m_Settings.m_OptimizerSeed);
         }
       optimizer->SetNormalVariateGenerator( generator );
 
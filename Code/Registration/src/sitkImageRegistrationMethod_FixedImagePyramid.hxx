@@ -0,0 +1,171 @@
+/*=========================================================================
+*
+*  Copyright Insight Software Consortium
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*         http://www.apache.org/licenses/LICENSE-2.0.txt
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*=========================================================================*/
+#ifndef sitkImageRegistrationMethod_FixedImagePyramid_hxx
+#define sitkImageRegistrationMethod_FixedImagePyramid_hxx
+
+#include "sitkImageRegistrationMethod.h"
+
+#include "itkImageRegistrationMethodv4.h"
+#include "itkImageToImageMetricv4.h"
+#include "itkDiscreteGaussianImageFilter.h"
+
+namespace itk
+{
+namespace simple
+{
+
+/** Smooth an image for a level of the registration, with the same
+ * Gaussian filter that itk::ImageRegistrationMethodv4 uses internally.
+ */
+template<typename TImageType>
+typename TImageType::Pointer
+SmoothImageForLevel( const TImageType *image,
+                     double sigma,
+                     bool sigmaIsSpecifiedInPhysicalUnits,
+                     unsigned int numberOfThreads )
+{
+  typedef itk::DiscreteGaussianImageFilter<TImageType, TImageType> SmoothingFilterType;
+  typename SmoothingFilterType::Pointer smoothingFilter = SmoothingFilterType::New();
+  smoothingFilter->SetUseImageSpacing( sigmaIsSpecifiedInPhysicalUnits );
+  smoothingFilter->SetVariance( sigma*sigma );
+  smoothingFilter->SetMaximumError( 0.01 );
+  smoothingFilter->SetNumberOfThreads( numberOfThreads );
+  smoothingFilter->SetInput( image );
+  smoothingFilter->Update();
+
+  typename TImageType::Pointer output = smoothingFilter->GetOutput();
+  output->DisconnectPipeline();
+  return output;
+}
+
+
+/** \class FixedImagePyramidRegistrationMethodv4
+ * \brief An ImageRegistrationMethodv4 which uses precomputed smoothed
+ * fixed images for each level.
+ *
+ * When a fixed image pyramid is set, the superclass is given smoothing
+ * sigmas of zero. After the superclass has initialized a level, the
+ * smoothed images of the level and the inputs of the metric are
+ * replaced by the level of the pyramid and the moving image smoothed
+ * for the level, and the metric is initialized again. The gradient
+ * filters of the metric are disabled during the initialization of the
+ * superclass, so the gradient images are only computed once. The
+ * inputs of the registration are not modified. Without a pyramid the
+ * superclass behavior is unchanged.
+ */
+template<typename TFixedImage, typename TMovingImage>
+class FixedImagePyramidRegistrationMethodv4
+  : public itk::ImageRegistrationMethodv4<TFixedImage, TMovingImage>
+{
+public:
+  typedef FixedImagePyramidRegistrationMethodv4                      Self;
+  typedef itk::ImageRegistrationMethodv4<TFixedImage, TMovingImage> Superclass;
+  typedef SmartPointer<Self>                                         Pointer;
+  typedef SmartPointer<const Self>                                   ConstPointer;
+
+  itkNewMacro( Self );
+  itkTypeMacro( FixedImagePyramidRegistrationMethodv4, ImageRegistrationMethodv4 );
+
+  typedef typename TFixedImage::Pointer                          FixedImagePointer;
+  typedef typename TMovingImage::Pointer                         MovingImagePointer;
+  typedef typename Superclass::SmoothingSigmasArrayType          SmoothingSigmasArrayType;
+  typedef itk::ImageToImageMetricv4<TFixedImage, TMovingImage>   PyramidImageMetricType;
+
+  /** Set the smoothed fixed image of each level, with the smoothing
+   * sigmas to apply to the moving image. Must be called after the
+   * smoothing settings of the superclass are set. */
+  void SetFixedImagePyramid( const std::vector<FixedImagePointer> &pyramid,
+                             const SmoothingSigmasArrayType &smoothingSigmasPerLevel )
+  {
+    this->m_FixedImagePyramid = pyramid;
+    this->m_PyramidSmoothingSigmasPerLevel = smoothingSigmasPerLevel;
+
+    SmoothingSigmasArrayType zeroSigmas( smoothingSigmasPerLevel.Size() );
+    zeroSigmas.Fill( 0.0 );
+    this->SetSmoothingSigmasPerLevel( zeroSigmas );
+  }
+
+protected:
+  FixedImagePyramidRegistrationMethodv4() {}
+  ~FixedImagePyramidRegistrationMethodv4() {}
+
+  virtual void InitializeRegistrationAtEachLevel( const SizeValueType level ) ITK_OVERRIDE
+  {
+    if ( this->m_FixedImagePyramid.empty() )
+      {
+      Superclass::InitializeRegistrationAtEachLevel( level );
+      return;
+      }
+
+    if ( level >= this->m_FixedImagePyramid.size() )
+      {
+      itkExceptionMacro( "The fixed image pyramid does not have a level " << level << "!" );
+      }
+
+    PyramidImageMetricType *metric = dynamic_cast<PyramidImageMetricType *>( this->m_Metric.GetPointer() );
+    if ( !metric )
+      {
+      itkExceptionMacro( "The fixed image pyramid requires an image metric!" );
+      }
+
+    const bool useFixedImageGradientFilter = metric->GetUseFixedImageGradientFilter();
+    const bool useMovingImageGradientFilter = metric->GetUseMovingImageGradientFilter();
+    metric->SetUseFixedImageGradientFilter( false );
+    metric->SetUseMovingImageGradientFilter( false );
+    try
+      {
+      Superclass::InitializeRegistrationAtEachLevel( level );
+      }
+    catch (...)
+      {
+      metric->SetUseFixedImageGradientFilter( useFixedImageGradientFilter );
+      metric->SetUseMovingImageGradientFilter( useMovingImageGradientFilter );
+      throw;
+      }
+    metric->SetUseFixedImageGradientFilter( useFixedImageGradientFilter );
+    metric->SetUseMovingImageGradientFilter( useMovingImageGradientFilter );
+
+    // the pyramid may be shared by concurrent registrations, use an
+    // image object of this registration sharing the buffer
+    FixedImagePointer fixedImage = TFixedImage::New();
+    fixedImage->Graft( this->m_FixedImagePyramid[level] );
+    MovingImagePointer movingImage = SmoothImageForLevel( this->GetMovingImage(),
+                                                          this->m_PyramidSmoothingSigmasPerLevel[level],
+                                                          this->GetSmoothingSigmasAreSpecifiedInPhysicalUnits(),
+                                                          this->GetNumberOfThreads() );
+
+    this->m_FixedSmoothImages[0] = fixedImage;
+    this->m_MovingSmoothImages[0] = movingImage;
+
+    metric->SetFixedImage( fixedImage );
+    metric->SetMovingImage( movingImage );
+    metric->Initialize();
+  }
+
+private:
+  FixedImagePyramidRegistrationMethodv4( const Self & ); //purposely not implemented
+  void operator=( const Self & );                        //purposely not implemented
+
+  std::vector<FixedImagePointer> m_FixedImagePyramid;
+  SmoothingSigmasArrayType       m_PyramidSmoothingSigmasPerLevel;
+};
+
+}
+}
+
+#endif // sitkImageRegistrationMethod_FixedImagePyramid_hxx
@@ -0,0 +1,235 @@
+/*=========================================================================
+*
+*  Copyright Insight Software Consortium
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*         http://www.apache.org/licenses/LICENSE-2.0.txt
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*=========================================================================*/
+#ifndef sitkImageRegistrationMethod_MetricSamplePoints_hxx
+#define sitkImageRegistrationMethod_MetricSamplePoints_hxx
+
+#include "sitkImageRegistrationMethod.h"
+
+#include "itkImage.h"
+#include "itkPointSet.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkGradientMagnitudeImageFilter.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+
+namespace itk
+{
+namespace simple
+{
+
+/** Returns true for the pixels of an image inside a mask. The mask is
+ * looked up by physical point, unless it has the geometry of the
+ * image. Without a mask all pixels are inside. */
+template<typename TImageType>
+class SamplingMaskFunction
+{
+public:
+  typedef itk::Image<unsigned char, TImageType::ImageDimension> MaskImageType;
+  typedef typename TImageType::IndexType                        IndexType;
+
+  SamplingMaskFunction( const TImageType *image, const MaskImageType *mask )
+    : m_Image( image ),
+      m_Mask( mask ),
+      m_SameGeometry( false )
+    {
+      if ( mask )
+        {
+        m_SameGeometry = ( mask->GetLargestPossibleRegion() == image->GetLargestPossibleRegion()
+                           && mask->GetOrigin() == image->GetOrigin()
+                           && mask->GetSpacing() == image->GetSpacing()
+                           && mask->GetDirection() == image->GetDirection() );
+        }
+    }
+
+  bool IsInside( const IndexType &index ) const
+    {
+      if ( !m_Mask )
+        {
+        return true;
+        }
+      if ( m_SameGeometry )
+        {
+        return m_Mask->GetPixel( index ) != 0;
+        }
+      typename TImageType::PointType point;
+      m_Image->TransformIndexToPhysicalPoint( index, point );
+      typename MaskImageType::IndexType maskIndex;
+      return m_Mask->TransformPhysicalPointToIndex( point, maskIndex ) && m_Mask->GetPixel( maskIndex ) != 0;
+    }
+
+private:
+  const TImageType    *m_Image;
+  const MaskImageType *m_Mask;
+  bool                 m_SameGeometry;
+};
+
+
+/** Compute the sample points of a metric at the centers of the pixels
+ * of the fixed image inside the sampling mask.
+ *
+ * With the NONE strategy all the pixels are sampled. Otherwise the
+ * percentage of the pixels is sampled regularly, randomly, or with a
+ * probability proportional to the gradient magnitude of the fixed
+ * image. The weighted samples are drawn by systematic sampling along
+ * the image, which spreads them over the image and is deterministic
+ * for a seed.
+ */
+template<typename TPointSetType, typename TImageType>
+typename TPointSetType::Pointer
+ComputeMetricSamplePointSet( const TImageType *fixed,
+                             const itk::Image<unsigned char, TImageType::ImageDimension> *mask,
+                             ImageRegistrationMethod::MetricSamplingStrategyType strategy,
+                             double percentage,
+                             unsigned int seed,
+                             unsigned int numberOfThreads )
+{
+  typedef itk::ImageRegionConstIteratorWithIndex<TImageType> IteratorType;
+  const typename TImageType::RegionType region = fixed->GetLargestPossibleRegion();
+  const SamplingMaskFunction<TImageType> maskFunction( fixed, mask );
+
+  // the sampling weight of the pixels, uniform unless sampling by
+  // gradient magnitude
+  typename TImageType::ConstPointer weights;
+  if ( strategy == ImageRegistrationMethod::GRADIENT_MAGNITUDE )
+    {
+    typedef itk::GradientMagnitudeImageFilter<TImageType, TImageType> GradientMagnitudeFilterType;
+    typename GradientMagnitudeFilterType::Pointer gradientMagnitude = GradientMagnitudeFilterType::New();
+    gradientMagnitude->SetInput( fixed );
+    gradientMagnitude->SetUseImageSpacing( true );
+    gradientMagnitude->SetNumberOfThreads( numberOfThreads );
+    gradientMagnitude->Update();
+    weights = gradientMagnitude->GetOutput();
+    }
+
+  double totalWeight = 0.0;
+  SizeValueType numberOfCandidates = 0;
+  for ( IteratorType it( weights ? weights.GetPointer() : fixed, region ); !it.IsAtEnd(); ++it )
+    {
+    if ( maskFunction.IsInside( it.GetIndex() ) )
+      {
+      totalWeight += weights ? static_cast<double>( it.Get() ) : 1.0;
+      ++numberOfCandidates;
+      }
+    }
+
+  if ( numberOfCandidates == 0 )
+    {
+    sitkExceptionMacro( "The sampling mask does not contain any pixel of the fixed image!" );
+    }
+
+  // a constant image has no gradient, sample it uniformly
+  if ( totalWeight <= 0.0 )
+    {
+    weights = SITK_NULLPTR;
+    totalWeight = numberOfCandidates;
+    }
+
+  double numberOfSamples = numberOfCandidates;
+  if ( strategy != ImageRegistrationMethod::NONE )
+    {
+    numberOfSamples = std::max( 1.0, std::floor( percentage * numberOfCandidates + 0.5 ) );
+    }
+
+  typedef itk::Statistics::MersenneTwisterRandomVariateGenerator RandomGeneratorType;
+  RandomGeneratorType::Pointer generator = RandomGeneratorType::New();
+  generator->SetSeed( seed == sitkWallClock ? static_cast<RandomGeneratorType::IntegerType>( std::time( NULL ) ) : seed );
+
+  // a pixel is sampled when the cumulative weight passes the next
+  // threshold, the thresholds are spaced by the weight of a sample
+  const double step = totalWeight / numberOfSamples;
+  double threshold = ( strategy == ImageRegistrationMethod::REGULAR ) ? 0.5 * step : generator->GetVariateWithOpenUpperRange() * step;
+  const double probability = numberOfSamples / numberOfCandidates;
+  double cumulativeWeight = 0.0;
+
+  typename TPointSetType::Pointer pointSet = TPointSetType::New();
+  pointSet->Initialize();
+  typename TPointSetType::PointIdentifier id = 0;
+
+  for ( IteratorType it( weights ? weights.GetPointer() : fixed, region ); !it.IsAtEnd(); ++it )
+    {
+    if ( !maskFunction.IsInside( it.GetIndex() ) )
+      {
+      continue;
+      }
+
+    bool isSampled = false;
+    if ( strategy == ImageRegistrationMethod::NONE )
+      {
+      isSampled = true;
+      }
+    else if ( strategy == ImageRegistrationMethod::RANDOM )
+      {
+      isSampled = generator->GetVariateWithOpenUpperRange() < probability;
+      }
+    else
+      {
+      cumulativeWeight += weights ? static_cast<double>( it.Get() ) : 1.0;
+      // a pixel with a large weight is sampled once
+      while ( cumulativeWeight > threshold )
+        {
+        isSampled = true;
+        threshold += step;
+        }
+      }
+
+    if ( isSampled )
+      {
+      typename TPointSetType::PointType point;
+      fixed->TransformIndexToPhysicalPoint( it.GetIndex(), point );
+      pointSet->SetPoint( id++, point );
+      }
+    }
+
+  return pointSet;
+}
+
+
+/** Create a point set from the coordinates of points in physical
+ * space. */
+template<typename TPointSetType>
+typename TPointSetType::Pointer
+CreateMetricSamplePointSet( const std::vector<double> &points )
+{
+  const unsigned int dimension = TPointSetType::PointDimension;
+  if ( points.size() % dimension != 0 )
+    {
+    sitkExceptionMacro( "The number of coordinates of the sample points, " << points.size()
+                        << ", is not a multiple of the dimension " << dimension << "!" );
+    }
+
+  typename TPointSetType::Pointer pointSet = TPointSetType::New();
+  pointSet->Initialize();
+  for ( size_t i = 0; i < points.size() / dimension; ++i )
+    {
+    typename TPointSetType::PointType point;
+    for ( unsigned int d = 0; d < dimension; ++d )
+      {
+      point[d] = points[i*dimension + d];
+      }
+    pointSet->SetPoint( i, point );
+    }
+  return pointSet;
+}
+
+}
+}
+
+#endif // sitkImageRegistrationMethod_MetricSamplePoints_hxx
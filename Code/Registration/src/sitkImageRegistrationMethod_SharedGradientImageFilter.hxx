@@ -0,0 +1,77 @@
+/*=========================================================================
+*
+*  Copyright Insight Software Consortium
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*         http://www.apache.org/licenses/LICENSE-2.0.txt
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*=========================================================================*/
+#ifndef sitkImageRegistrationMethod_SharedGradientImageFilter_hxx
+#define sitkImageRegistrationMethod_SharedGradientImageFilter_hxx
+
+#include "itkImageToImageFilter.h"
+
+namespace itk
+{
+namespace simple
+{
+
+/** \class SharedGradientImageFilter
+ * \brief A gradient filter of a metric which outputs a gradient image
+ * already computed.
+ *
+ * The output shares the buffer of the gradient image, so several
+ * metrics of the same images may use the gradients computed by one of
+ * them. The input is ignored, it only has to be in the geometry of
+ * the gradient image.
+ */
+template<typename TInputImage, typename TOutputImage>
+class SharedGradientImageFilter
+  : public itk::ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  typedef SharedGradientImageFilter                            Self;
+  typedef itk::ImageToImageFilter<TInputImage, TOutputImage>   Superclass;
+  typedef SmartPointer<Self>                                   Pointer;
+  typedef SmartPointer<const Self>                             ConstPointer;
+
+  itkNewMacro( Self );
+  itkTypeMacro( SharedGradientImageFilter, ImageToImageFilter );
+
+  itkSetConstObjectMacro( GradientImage, TOutputImage );
+  itkGetConstObjectMacro( GradientImage, TOutputImage );
+
+protected:
+  SharedGradientImageFilter() {}
+  ~SharedGradientImageFilter() {}
+
+  virtual void GenerateData() ITK_OVERRIDE
+  {
+    if ( !this->m_GradientImage )
+      {
+      itkExceptionMacro( "The gradient image is not set!" );
+      }
+    // the gradient image is only read by the metrics
+    this->GraftOutput( const_cast<TOutputImage *>( this->m_GradientImage.GetPointer() ) );
+  }
+
+private:
+  SharedGradientImageFilter( const Self & ); //purposely not implemented
+  void operator=( const Self & );            //purposely not implemented
+
+  typename TOutputImage::ConstPointer m_GradientImage;
+};
+
+}
+}
+
+#endif // sitkImageRegistrationMethod_SharedGradientImageFilter_hxx
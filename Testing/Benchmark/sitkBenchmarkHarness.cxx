@@ -0,0 +1,522 @@
+/*=========================================================================
+*
+*  Copyright Insight Software Consortium
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*         http://www.apache.org/licenses/LICENSE-2.0.txt
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*=========================================================================*/
+#include "sitkBenchmarkHarness.h"
+
+#include <SimpleITKTestHarness.h>
+
+#include <sitkImageFileReader.h>
+#include <sitkResampleImageFilter.h>
+#include <sitkCastImageFilter.h>
+#include <sitkExecutionProfiler.h>
+#include <sitkProcessObject.h>
+#include <sitkExceptionObject.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <sstream>
+
+namespace sitk = itk::simple;
+
+namespace
+{
+
+typedef std::map<std::string, BenchmarkFunction> BenchmarkRegistry;
+
+// constructed on first use, so registration does not depend on the
+// initialization order of the static registrars
+BenchmarkRegistry &GetRegistry()
+{
+  static BenchmarkRegistry registry;
+  return registry;
+}
+
+struct BenchmarkResult
+{
+  std::string   m_Name;
+  std::string   m_PixelType;
+  unsigned int  m_NumberOfThreads;
+  unsigned int  m_Scale;
+  uint64_t      m_NumberOfPixels;
+  unsigned int  m_Repetitions;
+  double        m_MinimumWallTime;
+  double        m_MedianWallTime;
+  double        m_MeanWallTime;
+  double        m_MeanCPUTime;
+  std::string   m_Status;
+};
+
+std::vector<std::string> Split( const std::string &s )
+{
+  std::vector<std::string> out;
+  std::istringstream in( s );
+  std::string item;
+  while ( std::getline( in, item, ',' ) )
+    {
+    if ( !item.empty() )
+      {
+      out.push_back( item );
+      }
+    }
+  return out;
+}
+
+std::vector<unsigned int> SplitUnsigned( const std::string &s )
+{
+  std::vector<std::string> items = Split( s );
+  std::vector<unsigned int> out;
+  for ( size_t i = 0; i < items.size(); ++i )
+    {
+    out.push_back( std::max( 1, std::atoi( items[i].c_str() ) ) );
+    }
+  return out;
+}
+
+// A glob with '*' matching any string, as for --gtest_filter.
+bool Matches( const char *pattern, const char *name )
+{
+  if ( *pattern == '\0' )
+    {
+    return *name == '\0';
+    }
+  if ( *pattern == '*' )
+    {
+    return Matches( pattern + 1, name ) || ( *name != '\0' && Matches( pattern, name + 1 ) );
+    }
+  return *name == *pattern && Matches( pattern + 1, name + 1 );
+}
+
+bool MatchesAny( const std::vector<std::string> &patterns, const std::string &name )
+{
+  if ( patterns.empty() )
+    {
+    return true;
+    }
+  for ( size_t i = 0; i < patterns.size(); ++i )
+    {
+    if ( Matches( patterns[i].c_str(), name.c_str() ) || Matches( ( patterns[i] + ".*" ).c_str(), name.c_str() ) )
+      {
+      return true;
+      }
+    }
+  return false;
+}
+
+std::string PixelTypeName( sitk::PixelIDValueType pixelID )
+{
+  return ( pixelID == sitk::sitkUnknown ) ? std::string( "native" ) : sitk::GetPixelIDValueAsString( pixelID );
+}
+
+void Summarize( const BenchmarkState &state, BenchmarkResult &result )
+{
+  std::vector<double> wall = state.GetWallTimes();
+  const std::vector<double> &cpu = state.GetCPUTimes();
+
+  result.m_NumberOfPixels = state.GetNumberOfPixels();
+  result.m_Repetitions = static_cast<unsigned int>( wall.size() );
+  if ( wall.empty() )
+    {
+    return;
+    }
+
+  std::sort( wall.begin(), wall.end() );
+  result.m_MinimumWallTime = wall.front();
+  result.m_MedianWallTime = ( wall.size() % 2 ) ? wall[wall.size()/2] : 0.5 * ( wall[wall.size()/2-1] + wall[wall.size()/2] );
+  result.m_MeanWallTime = std::accumulate( wall.begin(), wall.end(), 0.0 ) / wall.size();
+  result.m_MeanCPUTime = std::accumulate( cpu.begin(), cpu.end(), 0.0 ) / cpu.size();
+}
+
+double Throughput( const BenchmarkResult &r )
+{
+  // mega pixels per second of the median execution
+  return ( r.m_MedianWallTime > 0.0 ) ? r.m_NumberOfPixels / r.m_MedianWallTime * 1e-6 : 0.0;
+}
+
+std::string JSONQuote( const std::string &s )
+{
+  std::string out = "\"";
+  for ( size_t i = 0; i < s.size(); ++i )
+    {
+    if ( s[i] == '"' || s[i] == '\\' )
+      {
+      out += '\\';
+      }
+    out += ( s[i] == '\n' ) ? ' ' : s[i];
+    }
+  return out + "\"";
+}
+
+std::string CSVQuote( const std::string &s )
+{
+  std::string out = "\"";
+  for ( size_t i = 0; i < s.size(); ++i )
+    {
+    if ( s[i] == '"' )
+      {
+      out += '"';
+      }
+    out += ( s[i] == '\n' ) ? ' ' : s[i];
+    }
+  return out + "\"";
+}
+
+void WriteResults( std::ostream &out, const std::vector<BenchmarkResult> &results, bool json )
+{
+  out.precision( 9 );
+  if ( !json )
+    {
+    out << "Name,PixelType,NumberOfThreads,Scale,NumberOfPixels,Repetitions,MinimumWallTime,MedianWallTime,MeanWallTime,MeanCPUTime,MegaPixelsPerSecond,Status" << std::endl;
+    }
+  else
+    {
+    out << "[";
+    }
+
+  for ( size_t i = 0; i < results.size(); ++i )
+    {
+    const BenchmarkResult &r = results[i];
+    if ( !json )
+      {
+      out << r.m_Name << ","
+          << r.m_PixelType << ","
+          << r.m_NumberOfThreads << ","
+          << r.m_Scale << ","
+          << r.m_NumberOfPixels << ","
+          << r.m_Repetitions << ","
+          << r.m_MinimumWallTime << ","
+          << r.m_MedianWallTime << ","
+          << r.m_MeanWallTime << ","
+          << r.m_MeanCPUTime << ","
+          << Throughput( r ) << ","
+          << CSVQuote( r.m_Status ) << std::endl;
+      }
+    else
+      {
+      out << ( i ? "," : "" ) << std::endl
+          << "  { \"Name\": " << JSONQuote( r.m_Name )
+          << ", \"PixelType\": " << JSONQuote( r.m_PixelType )
+          << ", \"NumberOfThreads\": " << r.m_NumberOfThreads
+          << ", \"Scale\": " << r.m_Scale
+          << ", \"NumberOfPixels\": " << r.m_NumberOfPixels
+          << ", \"Repetitions\": " << r.m_Repetitions
+          << ", \"MinimumWallTime\": " << r.m_MinimumWallTime
+          << ", \"MedianWallTime\": " << r.m_MedianWallTime
+          << ", \"MeanWallTime\": " << r.m_MeanWallTime
+          << ", \"MeanCPUTime\": " << r.m_MeanCPUTime
+          << ", \"MegaPixelsPerSecond\": " << Throughput( r )
+          << ", \"Status\": " << JSONQuote( r.m_Status )
+          << " }";
+      }
+    }
+
+  if ( json )
+    {
+    out << std::endl << "]" << std::endl;
+    }
+}
+
+void PrintUsage( const char *program )
+{
+  std::cout << "Usage: " << program << " [options]" << std::endl
+            << "\t--list                   List the benchmarks" << std::endl
+            << "\t--filter=a,b             Glob patterns of the benchmarks to run, a filter name runs all its benchmarks" << std::endl
+            << "\t--threads=1,2,4          Numbers of threads to run each benchmark with" << std::endl
+            << "\t--pixel-types=sitkUInt8  Pixel types to cast the inputs to, by default the inputs are not cast" << std::endl
+            << "\t--scale=1,2              Factors to scale up each dimension of the inputs by" << std::endl
+            << "\t--repetitions=N          Number of timed executions, after one untimed warm up" << std::endl
+            << "\t--format=csv|json        Format of the results" << std::endl
+            << "\t--output=file            Write the results to a file instead of the standard output" << std::endl
+            << "\t--data=dir               Test data directory" << std::endl;
+}
+
+}
+
+
+BenchmarkState::BenchmarkState( unsigned int numberOfThreads,
+                                sitk::PixelIDValueType pixelID,
+                                unsigned int scale,
+                                unsigned int repetitions )
+  : m_NumberOfThreads( numberOfThreads ),
+    m_PixelID( pixelID ),
+    m_Scale( scale ),
+    m_Repetitions( repetitions ),
+    m_FirstInputPixelID( sitk::sitkUnknown ),
+    m_Iteration( 0 ),
+    m_StartWallTime( 0.0 ),
+    m_StartCPUTime( 0.0 ),
+    m_NumberOfPixels( 0 )
+{
+}
+
+std::vector<sitk::Image> BenchmarkState::ReadInputs( const std::vector<std::string> &fileNames )
+{
+  std::vector<sitk::Image> inputs;
+  sitk::ImageFileReader reader;
+
+  for ( size_t i = 0; i < fileNames.size(); ++i )
+    {
+    sitk::Image image = reader.SetFileName( dataFinder.GetFile( fileNames[i] ) ).Execute();
+
+    if ( m_Scale > 1 )
+      {
+      // a synthetic volume of the same physical extent with more
+      // pixels, nearest neighbor keeps label values intact
+      std::vector<unsigned int> size = image.GetSize();
+      std::vector<double> spacing = image.GetSpacing();
+      for ( size_t d = 0; d < size.size(); ++d )
+        {
+        size[d] *= m_Scale;
+        spacing[d] /= m_Scale;
+        }
+
+      sitk::ResampleImageFilter resampler;
+      resampler.SetSize( size );
+      resampler.SetOutputSpacing( spacing );
+      resampler.SetOutputOrigin( image.GetOrigin() );
+      resampler.SetOutputDirection( image.GetDirection() );
+      resampler.SetInterpolator( sitk::sitkNearestNeighbor );
+      image = resampler.Execute( image );
+      }
+
+    if ( m_PixelID != sitk::sitkUnknown )
+      {
+      // cast the first input, and the inputs of the same type along
+      // with it, other inputs such as masks keep their type
+      if ( inputs.empty() )
+        {
+        m_FirstInputPixelID = image.GetPixelID();
+        }
+      if ( image.GetPixelID() == m_FirstInputPixelID && image.GetPixelID() != m_PixelID )
+        {
+        image = sitk::Cast( image, static_cast<sitk::PixelIDValueEnum>( m_PixelID ) );
+        }
+      }
+
+    inputs.push_back( image );
+    }
+
+  if ( !inputs.empty() )
+    {
+    m_NumberOfPixels = inputs[0].GetNumberOfPixels();
+    }
+  return inputs;
+}
+
+bool BenchmarkState::KeepRunning()
+{
+  const double wallTime = sitk::ExecutionProfiler::GetCurrentWallTime();
+  const double cpuTime = sitk::ExecutionProfiler::GetCurrentCPUTime();
+
+  // the first iteration warms up and is not recorded
+  if ( m_Iteration > 1 )
+    {
+    m_WallTimes.push_back( wallTime - m_StartWallTime );
+    m_CPUTimes.push_back( cpuTime - m_StartCPUTime );
+    }
+
+  if ( m_Iteration > m_Repetitions )
+    {
+    return false;
+    }
+
+  ++m_Iteration;
+  m_StartWallTime = sitk::ExecutionProfiler::GetCurrentWallTime();
+  m_StartCPUTime = sitk::ExecutionProfiler::GetCurrentCPUTime();
+  return true;
+}
+
+
+BenchmarkRegistrar::BenchmarkRegistrar( const char *name, BenchmarkFunction function )
+{
+  GetRegistry()[name] = function;
+}
+
+
+int RunBenchmarks( int argc, char *argv[] )
+{
+  std::vector<std::string> patterns;
+  std::vector<unsigned int> threads( 1, sitk::ProcessObject::GetGlobalDefaultNumberOfThreads() );
+  std::vector<sitk::PixelIDValueType> pixelIDs( 1, sitk::sitkUnknown );
+  std::vector<unsigned int> scales( 1, 1 );
+  unsigned int repetitions = 5;
+  bool json = false;
+  bool list = false;
+  std::string outputFileName;
+
+  for ( int i = 1; i < argc; ++i )
+    {
+    const std::string arg = argv[i];
+    const std::string::size_type eq = arg.find( '=' );
+    const std::string key = arg.substr( 0, eq );
+    const std::string value = ( eq == std::string::npos ) ? std::string() : arg.substr( eq + 1 );
+
+    if ( key == "--help" )
+      {
+      PrintUsage( argv[0] );
+      return EXIT_SUCCESS;
+      }
+    else if ( key == "--list" )
+      {
+      list = true;
+      }
+    else if ( key == "--filter" )
+      {
+      patterns = Split( value );
+      }
+    else if ( key == "--threads" )
+      {
+      threads = SplitUnsigned( value );
+      }
+    else if ( key == "--scale" )
+      {
+      scales = SplitUnsigned( value );
+      }
+    else if ( key == "--repetitions" )
+      {
+      repetitions = std::max( 1, std::atoi( value.c_str() ) );
+      }
+    else if ( key == "--pixel-types" )
+      {
+      pixelIDs.clear();
+      std::vector<std::string> names = Split( value );
+      for ( size_t j = 0; j < names.size(); ++j )
+        {
+        const sitk::PixelIDValueType id = ( names[j] == "native" ) ? sitk::sitkUnknown : sitk::GetPixelIDValueFromString( names[j] );
+        if ( id < 0 && names[j] != "native" )
+          {
+          std::cerr << "Unknown or unsupported pixel type \"" << names[j] << "\"" << std::endl;
+          return EXIT_FAILURE;
+          }
+        pixelIDs.push_back( id );
+        }
+      }
+    else if ( key == "--format" )
+      {
+      if ( value != "csv" && value != "json" )
+        {
+        std::cerr << "Unknown format \"" << value << "\"" << std::endl;
+        return EXIT_FAILURE;
+        }
+      json = ( value == "json" );
+      }
+    else if ( key == "--output" )
+      {
+      outputFileName = value;
+      }
+    else if ( key == "--data" )
+      {
+      dataFinder.SetDirectory( value );
+      }
+    else
+      {
+      std::cerr << "Unknown argument \"" << arg << "\"" << std::endl;
+      PrintUsage( argv[0] );
+      return EXIT_FAILURE;
+      }
+    }
+
+  const BenchmarkRegistry &registry = GetRegistry();
+
+  if ( list )
+    {
+    for ( BenchmarkRegistry::const_iterator b = registry.begin(); b != registry.end(); ++b )
+      {
+      std::cout << b->first << std::endl;
+      }
+    return EXIT_SUCCESS;
+    }
+
+  const unsigned int originalNumberOfThreads = sitk::ProcessObject::GetGlobalDefaultNumberOfThreads();
+
+  std::vector<BenchmarkResult> results;
+  bool failed = false;
+
+  for ( BenchmarkRegistry::const_iterator b = registry.begin(); b != registry.end(); ++b )
+    {
+    if ( !MatchesAny( patterns, b->first ) )
+      {
+      continue;
+      }
+
+    for ( size_t p = 0; p < pixelIDs.size(); ++p )
+      {
+      for ( size_t s = 0; s < scales.size(); ++s )
+        {
+        for ( size_t t = 0; t < threads.size(); ++t )
+          {
+          BenchmarkResult result = BenchmarkResult();
+          result.m_Name = b->first;
+          result.m_PixelType = PixelTypeName( pixelIDs[p] );
+          result.m_NumberOfThreads = threads[t];
+          result.m_Scale = scales[s];
+          result.m_Status = "ok";
+
+          // filters constructed by the benchmark use this default
+          sitk::ProcessObject::SetGlobalDefaultNumberOfThreads( threads[t] );
+
+          BenchmarkState state( threads[t], pixelIDs[p], scales[s], repetitions );
+          try
+            {
+            b->second( state );
+            }
+          catch ( std::exception &e )
+            {
+            // unsupported pixel types are expected when sweeping
+            // types, they are reported and do not fail the run
+            result.m_Status = e.what();
+            if ( pixelIDs[p] == sitk::sitkUnknown )
+              {
+              failed = true;
+              }
+            }
+
+          Summarize( state, result );
+          results.push_back( result );
+
+          std::cerr << result.m_Name << " " << result.m_PixelType
+                    << " threads=" << result.m_NumberOfThreads
+                    << " scale=" << result.m_Scale
+                    << " median=" << result.m_MedianWallTime << "s"
+                    << ( result.m_Status == "ok" ? "" : " FAILED" ) << std::endl;
+          }
+        }
+      }
+    }
+
+  sitk::ProcessObject::SetGlobalDefaultNumberOfThreads( originalNumberOfThreads );
+
+  if ( outputFileName.empty() )
+    {
+    WriteResults( std::cout, results, json );
+    }
+  else
+    {
+    std::ofstream file( outputFileName.c_str() );
+    WriteResults( file, results, json );
+    if ( !file )
+      {
+      std::cerr << "Error writing results to \"" << outputFileName << "\"" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
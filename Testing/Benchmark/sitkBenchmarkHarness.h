@@ -0,0 +1,106 @@
+/*=========================================================================
+*
+*  Copyright Insight Software Consortium
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*         http://www.apache.org/licenses/LICENSE-2.0.txt
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*
+*=========================================================================*/
+#ifndef __sitkBenchmarkHarness_h
+#define __sitkBenchmarkHarness_h
+
+#include "sitkImage.h"
+#include "sitkPixelIDValues.h"
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+/** \class BenchmarkState
+ * \brief The configuration and timing of one run of a benchmark.
+ *
+ * A benchmark function reads its inputs through the state, which
+ * scales them up and casts them to the pixel type of the run, sets up
+ * the filter and then executes it in a loop:
+ *
+ * \code
+ * std::vector<itk::simple::Image> inputs = state.ReadInputs( fileNames );
+ * while ( state.KeepRunning() )
+ *   {
+ *   filter.Execute( inputs[0] );
+ *   }
+ * \endcode
+ *
+ * The first iteration warms up the caches and is not timed. Filters
+ * must be constructed after the state is passed to the benchmark, so
+ * that they use the number of threads of the run.
+ */
+class BenchmarkState
+{
+public:
+  BenchmarkState( unsigned int numberOfThreads,
+                  itk::simple::PixelIDValueType pixelID,
+                  unsigned int scale,
+                  unsigned int repetitions );
+
+  /** Read test data files, scaled up and cast to the run's pixel
+   * type. Inputs with a pixel type different from the first input,
+   * such as masks, are only scaled. */
+  std::vector<itk::simple::Image> ReadInputs( const std::vector<std::string> &fileNames );
+
+  /** Returns true while there are iterations to run, timing the
+   * previous iteration. */
+  bool KeepRunning();
+
+  unsigned int GetNumberOfThreads() const { return m_NumberOfThreads; }
+  itk::simple::PixelIDValueType GetPixelID() const { return m_PixelID; }
+  unsigned int GetScale() const { return m_Scale; }
+
+  /** The number of pixels of the first input, used to compute the
+   * throughput. */
+  uint64_t GetNumberOfPixels() const { return m_NumberOfPixels; }
+
+  /** The wall and processor time of each timed iteration in seconds. */
+  const std::vector<double> &GetWallTimes() const { return m_WallTimes; }
+  const std::vector<double> &GetCPUTimes() const { return m_CPUTimes; }
+
+private:
+  unsigned int                  m_NumberOfThreads;
+  itk::simple::PixelIDValueType m_PixelID;
+  unsigned int                  m_Scale;
+  unsigned int                  m_Repetitions;
+  itk::simple::PixelIDValueType m_FirstInputPixelID;
+
+  unsigned int m_Iteration;
+  double       m_StartWallTime;
+  double       m_StartCPUTime;
+
+  uint64_t            m_NumberOfPixels;
+  std::vector<double> m_WallTimes;
+  std::vector<double> m_CPUTimes;
+};
+
+
+typedef void (*BenchmarkFunction)( BenchmarkState & );
+
+/** Static instances add a benchmark to the global registry. */
+class BenchmarkRegistrar
+{
+public:
+  BenchmarkRegistrar( const char *name, BenchmarkFunction function );
+};
+
+/** Run the registered benchmarks selected by the command line
+ * arguments, writing the results as CSV or JSON. */
+int RunBenchmarks( int argc, char *argv[] );
+
+#endif
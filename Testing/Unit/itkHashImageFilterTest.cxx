@@ -166,6 +166,64 @@ TEST_F(HashImageFilterTest, VectorImages ) {
   }
 }
 
+TEST_F(HashImageFilterTest, XXH64 ) {
+
+  // reference values of the XXH64 hash function
+  EXPECT_EQ( XXH64::Hash( "", 0 ), 0xef46db3751d8e999ULL );
+  EXPECT_EQ( XXH64::Hash( "a", 1 ), 0xd24ec4f1a98c6e5bULL );
+  EXPECT_EQ( XXH64::Hash( "abc", 3 ), 0x44bc2cf5ad770999ULL );
+
+  // an image of several blocks of the tree hash
+  typedef itk::Image<float, 2> ImageType;
+  ImageType::RegionType region;
+  region.SetSize( 0, 1024 );
+  region.SetSize( 1, 700 );
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( region );
+  image->Allocate();
+  for ( size_t i = 0; i < region.GetNumberOfPixels(); ++i )
+    {
+    image->GetBufferPointer()[i] = static_cast<float>( i % 1013 );
+    }
+
+  typedef itk::HashImageFilter< ImageType > HasherType;
+  HasherType::Pointer hasher = HasherType::New();
+  hasher->SetHashFunction( HasherType::XXH64 );
+  hasher->SetInput( image );
+  hasher->SetNumberOfThreads( 1 );
+  hasher->Update();
+  const std::string hash = hasher->GetHash();
+
+  EXPECT_EQ( hash.size(), 16u );
+
+  // the input is passed through without a copy
+  EXPECT_EQ( hasher->GetOutput()->GetBufferPointer(), image->GetBufferPointer() );
+
+  // the tree hash does not depend on the number of threads
+  hasher->SetNumberOfThreads( 4 );
+  hasher->Modified();
+  hasher->Update();
+  EXPECT_EQ( hash, hasher->GetHash() );
+
+  // a change in the last block changes the hash
+  image->GetBufferPointer()[region.GetNumberOfPixels()-1] += 1.0f;
+  image->Modified();
+  hasher->Update();
+  EXPECT_NE( hash, hasher->GetHash() );
+
+  // the sequential hashes are computed on the whole buffer
+  hasher->SetHashFunction( HasherType::MD5 );
+  hasher->Update();
+  EXPECT_EQ( hasher->GetHash().size(), 32u );
+
+  // the procedural interface
+  itk::simple::Image img = itk::simple::ReadImage( dataFinder.GetFile ( "Input/RA-Float.nrrd" ) );
+  EXPECT_EQ( itk::simple::Hash( img, itk::simple::HashImageFilter::XXH64 ),
+             itk::simple::Hash( img, itk::simple::HashImageFilter::XXH64 ) );
+  EXPECT_NE( itk::simple::Hash( img, itk::simple::HashImageFilter::XXH64 ),
+             itk::simple::Hash( itk::simple::Cast( img, itk::simple::sitkFloat64 ), itk::simple::HashImageFilter::XXH64 ) );
+}
+
 TEST_F(HashImageFilterTest, LabelMap ) {
 
   itk::simple::Image img = itk::simple::ReadImage( dataFinder.GetFile ( "Input/2th_cthead1.png" ) );
@@ -197,4 +255,7 @@ TEST_F(HashImageFilterTest, Coverage ) {
 
  hasher->SetHashFunction( UCHAR2HasherType::SHA1 );
  EXPECT_EQ(  hasher->GetHashFunction(), UCHAR2HasherType::SHA1 ) << "expected default hash type to be SHA1";
+
+ hasher->SetHashFunction( UCHAR2HasherType::XXH64 );
+ EXPECT_EQ(  hasher->GetHashFunction(), UCHAR2HasherType::XXH64 ) << "expected hash type to be XXH64";
 }
@@ -46,12 +46,25 @@
 #include <sitkDiffeomorphicDemonsRegistrationFilter.h>
 #include <sitkFastSymmetricForcesDemonsRegistrationFilter.h>
 #include <sitkOtsuThresholdImageFilter.h>
+#include <sitkGradientMagnitudeImageFilter.h>
+#include <sitkMaskImageFilter.h>
+#include <sitkAddImageFilter.h>
 #include <sitkBSplineTransformInitializerFilter.h>
 #include <sitkCenteredTransformInitializerFilter.h>
 #include <sitkCenteredVersorTransformInitializerFilter.h>
 #include <sitkLandmarkBasedTransformInitializerFilter.h>
 #include <sitkAdditionalProcedures.h>
 #include <sitkCommand.h>
+#include <sitkPipeline.h>
+#include <sitkExecutionProfiler.h>
+#include <sitkThreadPool.h>
+#include <sitkTaskGraph.h>
+#include <sitkSmoothingRecursiveGaussianImageFilter.h>
+#include <sitkAbsImageFilter.h>
+#include <sitkSqrtImageFilter.h>
+#include <sitkResampleImageFilter.h>
+#include <sitkMedianImageFilter.h>
+#include <sitkVectorIndexSelectionCastImageFilter.h>
 
 #include "itkVectorImage.h"
 #include "itkVector.h"
@@ -71,6 +84,7 @@
 #include "itkMergeLabelMapFilter.h"
 #include "itkDiffeomorphicDemonsRegistrationFilter.h"
 #include "itkFastSymmetricForcesDemonsRegistrationFilter.h"
+#include "itkMultiThreader.h"
 
 #include "sitkShow.h"
 
@@ -78,6 +92,7 @@
 #include "sitkSimilarity3DTransform.h"
 #include "sitkAffineTransform.h"
 #include "sitkEuler2DTransform.h"
+#include "sitkEuler3DTransform.h"
 #include "sitkSimilarity2DTransform.h"
 #include "sitkVersorTransform.h"
 #include "sitkScaleVersor3DTransform.h"
@@ -302,6 +317,31 @@ TEST(BasicFilters,ImageFilter) {
   filter.DebugOn();
 }
 
+TEST(BasicFilters,SharedMemberFunctionTables) {
+  namespace sitk = itk::simple;
+
+  // The dispatch tables are shared between instances, each instance
+  // must still execute with its own parameters
+  sitk::Image img( 10, 10, sitk::sitkFloat32 );
+
+  sitk::HashImageFilter sha1Hasher;
+  sitk::HashImageFilter md5Hasher;
+  md5Hasher.SetHashFunction( sitk::HashImageFilter::MD5 );
+
+  EXPECT_EQ( sitk::Hash( img, sitk::HashImageFilter::SHA1 ), sha1Hasher.Execute( img ) );
+  EXPECT_EQ( sitk::Hash( img, sitk::HashImageFilter::MD5 ), md5Hasher.Execute( img ) );
+  EXPECT_EQ( sitk::Hash( img, sitk::HashImageFilter::SHA1 ), sha1Hasher.Execute( img ) );
+
+  sitk::CastImageFilter toUInt8;
+  toUInt8.SetOutputPixelType( sitk::sitkUInt8 );
+  sitk::CastImageFilter toFloat64;
+  toFloat64.SetOutputPixelType( sitk::sitkFloat64 );
+
+  EXPECT_EQ( sitk::sitkUInt8, toUInt8.Execute( img ).GetPixelID() );
+  EXPECT_EQ( sitk::sitkFloat64, toFloat64.Execute( img ).GetPixelID() );
+  EXPECT_EQ( sitk::sitkUInt8, toUInt8.Execute( img ).GetPixelID() );
+}
+
 TEST(BasicFilters,ProcessObject_Debug) {
   namespace sitk = itk::simple;
 
@@ -912,3 +952,398 @@ TEST(BasicFilters,OtsuThreshold_CheckNamesInputCompatibility)
   EXPECT_THROW( sitk::OtsuThreshold(input, mask1), sitk::GenericException );
   EXPECT_THROW( sitk::OtsuThreshold(input, mask2), sitk::GenericException );
 }
+
+
+namespace
+{
+// executes a filter on the threads other than the calling one
+ITK_THREAD_RETURN_TYPE AbsOnOtherThreads( void *arg )
+{
+  itk::MultiThreader::ThreadInfoStruct *info = static_cast<itk::MultiThreader::ThreadInfoStruct *>( arg );
+  if ( info->ThreadID != 0 )
+    {
+    const itk::simple::Image *img = static_cast<const itk::simple::Image *>( info->UserData );
+    itk::simple::Abs( *img );
+    }
+  return ITK_THREAD_RETURN_VALUE;
+}
+}
+
+TEST(BasicFilters,Pipeline)
+{
+  namespace sitk = itk::simple;
+
+  sitk::Image img;
+  ASSERT_NO_THROW( img = sitk::ReadImage( dataFinder.GetFile ( "Input/RA-Float.nrrd" ) ) ) << "Reading input Image.";
+
+  const std::string expectedHash = sitk::Hash( sitk::Sqrt( sitk::Abs( sitk::SmoothingRecursiveGaussian( img, 2.0 ) ) ) );
+
+  sitk::Pipeline pipeline;
+  EXPECT_EQ( 1u, pipeline.GetNumberOfStreamDivisions() );
+  EXPECT_EQ( &pipeline, &pipeline.SetNumberOfStreamDivisions( 2 ).SetMaximumMemory( 0 ) );
+  EXPECT_EQ( 2u, pipeline.GetNumberOfStreamDivisions() );
+  EXPECT_FALSE( pipeline.IsRecording() );
+
+  for ( unsigned int divisions = 1; divisions <= 4; divisions *= 4 )
+    {
+    pipeline.SetNumberOfStreamDivisions( divisions );
+    pipeline.StartRecording();
+    EXPECT_TRUE( pipeline.IsRecording() );
+
+    sitk::Image tmp = sitk::SmoothingRecursiveGaussian( img, 2.0 );
+    tmp = sitk::Abs( tmp );
+    tmp = sitk::Sqrt( tmp );
+    EXPECT_EQ( 3u, pipeline.GetNumberOfRecordedFilters() );
+    EXPECT_EQ( img.GetSize(), tmp.GetSize() );
+
+    sitk::Image out = pipeline.Execute( tmp );
+    EXPECT_FALSE( pipeline.IsRecording() );
+    EXPECT_EQ( 0u, pipeline.GetNumberOfRecordedFilters() );
+    EXPECT_EQ( expectedHash, sitk::Hash( out ) ) << " with " << divisions << " stream divisions";
+    }
+
+  // accessing a placeholder updates the recorded filters it depends on
+  std::vector<uint32_t> idx( 3, 10u );
+  const float expectedPixel = sitk::Abs( img ).GetPixelAsFloat( idx );
+  pipeline.SetNumberOfStreamDivisions( 4 );
+  pipeline.StartRecording();
+  sitk::Image placeholder = sitk::Abs( img );
+  EXPECT_FLOAT_EQ( expectedPixel, placeholder.GetPixelAsFloat( idx ) );
+  sitk::Image result = pipeline.Execute( sitk::Sqrt( placeholder ) );
+  EXPECT_EQ( sitk::Hash( sitk::Sqrt( sitk::Abs( img ) ) ), sitk::Hash( result ) );
+  EXPECT_FLOAT_EQ( expectedPixel, placeholder.GetPixelAsFloat( idx ) );
+  EXPECT_EQ( sitk::Hash( sitk::Abs( img ) ), sitk::Hash( placeholder ) );
+
+  // the placeholders can not be computed once the pipeline is cleared
+  pipeline.StartRecording();
+  placeholder = sitk::Abs( img );
+  pipeline.Clear();
+  pipeline.StopRecording();
+  EXPECT_THROW( placeholder.GetPixelAsFloat( idx ), sitk::GenericException );
+  EXPECT_THROW( placeholder.GetBufferAsFloat(), sitk::GenericException );
+  EXPECT_THROW( placeholder.ToString(), sitk::GenericException );
+
+  // only one pipeline may record
+  pipeline.StartRecording();
+  sitk::Pipeline other;
+  EXPECT_THROW( other.StartRecording(), sitk::GenericException );
+
+  sitk::Abs( img );
+  EXPECT_EQ( 1u, pipeline.GetNumberOfRecordedFilters() );
+  pipeline.Clear();
+  EXPECT_EQ( 0u, pipeline.GetNumberOfRecordedFilters() );
+  pipeline.StopRecording();
+
+  // filters executed by other threads are not deferred
+  pipeline.StartRecording();
+  itk::MultiThreader::Pointer threader = itk::MultiThreader::New();
+  threader->SetNumberOfThreads( 2 );
+  threader->SetSingleMethod( AbsOnOtherThreads, &img );
+  threader->SingleMethodExecute();
+  EXPECT_EQ( 0u, pipeline.GetNumberOfRecordedFilters() );
+  pipeline.StopRecording();
+
+  // without recording filters are executed
+  EXPECT_NO_THROW( other.StartRecording() );
+  other.StopRecording();
+  sitk::Abs( img );
+  EXPECT_EQ( 0u, other.GetNumberOfRecordedFilters() );
+}
+
+
+TEST(BasicFilters,StreamDivisions)
+{
+  namespace sitk = itk::simple;
+
+  sitk::Image img;
+  ASSERT_NO_THROW( img = sitk::ReadImage( dataFinder.GetFile ( "Input/RA-Float.nrrd" ) ) ) << "Reading input Image.";
+
+  sitk::SmoothingRecursiveGaussianImageFilter gaussian;
+  gaussian.SetSigma( 2.0 );
+  EXPECT_EQ( 1u, gaussian.GetNumberOfStreamDivisions() );
+  EXPECT_EQ( 0u, gaussian.GetMaximumMemory() );
+
+  const std::string expectedHash = sitk::Hash( gaussian.Execute( img ) );
+
+  gaussian.SetNumberOfStreamDivisions( 5 );
+  EXPECT_EQ( 5u, gaussian.GetNumberOfStreamDivisions() );
+
+  // the commands observe the whole streamed update
+  CountCommand startCmd( gaussian );
+  gaussian.AddCommand( sitk::sitkStartEvent, startCmd );
+  CountCommand endCmd( gaussian );
+  gaussian.AddCommand( sitk::sitkEndEvent, endCmd );
+
+  EXPECT_EQ( expectedHash, sitk::Hash( gaussian.Execute( img ) ) ) << " with stream divisions";
+  EXPECT_EQ( 1, startCmd.m_Count );
+  EXPECT_EQ( 1, endCmd.m_Count );
+  gaussian.RemoveAllCommands();
+
+  gaussian.SetNumberOfStreamDivisions( 0 );
+  EXPECT_EQ( 1u, gaussian.GetNumberOfStreamDivisions() );
+
+  // at most a quarter of the output at once
+  gaussian.SetMaximumMemory( img.GetNumberOfPixels() * sizeof(float) / 4 );
+  EXPECT_EQ( expectedHash, sitk::Hash( gaussian.Execute( img ) ) ) << " with maximum memory";
+
+  sitk::ResampleImageFilter resample;
+  resample.SetReferenceImage( img );
+  resample.SetInterpolator( sitk::sitkLinear );
+  resample.SetTransform( sitk::Euler3DTransform( std::vector<double>( 3, 0.0 ), 0.1, 0.0, 0.0 ) );
+
+  const std::string expectedResampleHash = sitk::Hash( resample.Execute( img ) );
+
+  resample.SetNumberOfStreamDivisions( 7 );
+  EXPECT_EQ( expectedResampleHash, sitk::Hash( resample.Execute( img ) ) ) << " resample with stream divisions";
+}
+
+
+TEST(BasicFilters,VectorImageByComponents)
+{
+  namespace sitk = itk::simple;
+
+  sitk::Image img;
+  ASSERT_NO_THROW( img = sitk::ReadImage( dataFinder.GetFile ( "Input/VM1111Shrink-RGB.png" ) ) ) << "Reading input Image.";
+  ASSERT_EQ( 3u, img.GetNumberOfComponentsPerPixel() );
+
+  sitk::MedianImageFilter median;
+  median.SetRadius( 2 );
+  median.SetNumberOfThreads( 4 );
+
+  sitk::ResampleImageFilter resample;
+  resample.SetReferenceImage( img );
+  resample.SetInterpolator( sitk::sitkLinear );
+  resample.SetTransform( sitk::Euler2DTransform( std::vector<double>( 2, 10.0 ), 0.1 ) );
+  resample.SetNumberOfThreads( 4 );
+
+  // the components are filtered concurrently
+  sitk::Image medianOut = median.Execute( img );
+  sitk::Image resampleOut = resample.Execute( img );
+  ASSERT_EQ( img.GetPixelID(), medianOut.GetPixelID() );
+  ASSERT_EQ( img.GetPixelID(), resampleOut.GetPixelID() );
+
+  for ( unsigned int i = 0; i < img.GetNumberOfComponentsPerPixel(); ++i )
+    {
+    sitk::Image component = sitk::VectorIndexSelectionCast( img, i );
+    EXPECT_EQ( sitk::Hash( median.Execute( component ) ),
+               sitk::Hash( sitk::VectorIndexSelectionCast( medianOut, i ) ) ) << " median of component " << i;
+    EXPECT_EQ( sitk::Hash( resample.Execute( component ) ),
+               sitk::Hash( sitk::VectorIndexSelectionCast( resampleOut, i ) ) ) << " resample of component " << i;
+    }
+
+  // the commands observe the concurrent execution as a whole
+  CountCommand startCmd( median );
+  median.AddCommand( sitk::sitkStartEvent, startCmd );
+  CountCommand endCmd( median );
+  median.AddCommand( sitk::sitkEndEvent, endCmd );
+  ProgressUpdate progressCmd( median );
+  median.AddCommand( sitk::sitkProgressEvent, progressCmd );
+
+  EXPECT_EQ( sitk::Hash( medianOut ), sitk::Hash( median.Execute( img ) ) ) << " with commands";
+  EXPECT_EQ( 1, startCmd.m_Count );
+  EXPECT_EQ( 1, endCmd.m_Count );
+  EXPECT_FLOAT_EQ( 1.0f, progressCmd.m_Progress );
+  EXPECT_FLOAT_EQ( 1.0f, median.GetProgress() );
+
+  // aborting stops the execution of the components
+  AbortAtCommand abortAtCmd( median, 0.0f );
+  median.AddCommand( sitk::sitkProgressEvent, abortAtCmd );
+  CountCommand abortCmd( median );
+  median.AddCommand( sitk::sitkAbortEvent, abortCmd );
+
+  EXPECT_ANY_THROW( median.Execute( img ) );
+  EXPECT_EQ( 2, startCmd.m_Count );
+  EXPECT_EQ( 1, endCmd.m_Count );
+  EXPECT_EQ( 1, abortCmd.m_Count );
+  median.RemoveAllCommands();
+
+  // the streamed components are filtered one after another
+  median.SetNumberOfStreamDivisions( 3 );
+  EXPECT_EQ( sitk::Hash( medianOut ), sitk::Hash( median.Execute( img ) ) ) << " with stream divisions";
+}
+
+
+TEST(BasicFilters,ExecutionProfiler)
+{
+  namespace sitk = itk::simple;
+
+  sitk::Image img;
+  ASSERT_NO_THROW( img = sitk::ReadImage( dataFinder.GetFile ( "Input/RA-Float.nrrd" ) ) ) << "Reading input Image.";
+
+  sitk::SmoothingRecursiveGaussianImageFilter gaussian;
+  EXPECT_EQ( 0.0, gaussian.GetExecutionWallTime() );
+  EXPECT_EQ( 0u, gaussian.GetExecutionOutputBytes() );
+
+  EXPECT_FALSE( sitk::ExecutionProfiler::IsEnabled() );
+  gaussian.Execute( img );
+
+  EXPECT_LE( 0.0, gaussian.GetExecutionWallTime() );
+  EXPECT_LE( 0.0, gaussian.GetExecutionCPUTime() );
+  EXPECT_EQ( gaussian.GetNumberOfThreads(), gaussian.GetExecutionNumberOfThreads() );
+  EXPECT_EQ( img.GetNumberOfPixels() * sizeof(float), gaussian.GetExecutionOutputBytes() );
+  EXPECT_TRUE( sitk::ExecutionProfiler::GetNames().empty() );
+
+  sitk::ExecutionProfiler::Reset();
+  sitk::ExecutionProfiler::Enable();
+
+  gaussian.Execute( img );
+  gaussian.SetNumberOfStreamDivisions( 4 );
+  gaussian.Execute( img );
+  sitk::Abs( img );
+
+  sitk::ExecutionProfiler::Disable();
+  sitk::Abs( img );
+
+  ASSERT_EQ( 2u, sitk::ExecutionProfiler::GetNames().size() );
+  EXPECT_EQ( gaussian.GetName(), sitk::ExecutionProfiler::GetNames()[0] );
+  EXPECT_EQ( 2u, sitk::ExecutionProfiler::GetNumberOfExecutions( gaussian.GetName() ) );
+  EXPECT_EQ( 1u, sitk::ExecutionProfiler::GetNumberOfExecutions( "AbsImageFilter" ) );
+  EXPECT_EQ( 0u, sitk::ExecutionProfiler::GetNumberOfExecutions( "NotAFilter" ) );
+  EXPECT_EQ( 2u * img.GetNumberOfPixels() * sizeof(float), sitk::ExecutionProfiler::GetOutputBytes( gaussian.GetName() ) );
+  EXPECT_LE( gaussian.GetExecutionWallTime(), sitk::ExecutionProfiler::GetWallTime( gaussian.GetName() ) );
+
+  const std::string csv = sitk::ExecutionProfiler::GetReport( sitk::ExecutionProfiler::CSV );
+  EXPECT_EQ( 0u, csv.find( "Name,NumberOfExecutions,WallTime,CPUTime" ) );
+  EXPECT_NE( std::string::npos, csv.find( "\nAbsImageFilter,1," ) );
+
+  const std::string json = sitk::ExecutionProfiler::GetReport( sitk::ExecutionProfiler::JSON );
+  EXPECT_EQ( '[', json[0] );
+  EXPECT_NE( std::string::npos, json.find( "\"Name\": \"AbsImageFilter\", \"NumberOfExecutions\": 1" ) );
+
+  sitk::ExecutionProfiler::Reset();
+  EXPECT_TRUE( sitk::ExecutionProfiler::GetNames().empty() );
+}
+
+
+TEST(BasicFilters,ThreadPool)
+{
+  namespace sitk = itk::simple;
+
+  sitk::Image img;
+  ASSERT_NO_THROW( img = sitk::ReadImage( dataFinder.GetFile ( "Input/RA-Float.nrrd" ) ) ) << "Reading input Image.";
+
+  sitk::SmoothingRecursiveGaussianImageFilter gaussian;
+  const std::string expectedHash = sitk::Hash( gaussian.Execute( img ) );
+
+  EXPECT_FALSE( sitk::ThreadPool::GetShareThreads() );
+  EXPECT_EQ( 0u, sitk::ThreadPool::GetNumberOfThreadsInUse() );
+
+  sitk::ThreadPool::SetNumberOfThreads( 4 );
+  EXPECT_EQ( 4u, sitk::ThreadPool::GetNumberOfThreads() );
+
+  // concurrent executions share the threads of the pool
+  sitk::ThreadPool::ShareThreadsOn();
+  EXPECT_EQ( 3u, sitk::ThreadPool::AcquireThreads( 3 ) );
+  EXPECT_EQ( 1u, sitk::ThreadPool::AcquireThreads( 3 ) );
+  EXPECT_EQ( 1u, sitk::ThreadPool::AcquireThreads( 3 ) );
+  EXPECT_EQ( 5u, sitk::ThreadPool::GetNumberOfThreadsInUse() );
+  sitk::ThreadPool::ReleaseThreads( 5 );
+  EXPECT_EQ( 0u, sitk::ThreadPool::GetNumberOfThreadsInUse() );
+
+  const bool wasEnabled = sitk::ThreadPool::IsEnabled();
+  sitk::ThreadPool::Enable();
+  EXPECT_TRUE( sitk::ThreadPool::IsEnabled() );
+
+  gaussian.SetNumberOfThreads( 8 );
+  EXPECT_EQ( expectedHash, sitk::Hash( gaussian.Execute( img ) ) ) << " executed with the thread pool";
+  EXPECT_EQ( 4u, gaussian.GetExecutionNumberOfThreads() );
+  EXPECT_EQ( 0u, sitk::ThreadPool::GetNumberOfThreadsInUse() );
+
+  // the ITK filter kept for the measurements holds no threads
+  sitk::StatisticsImageFilter stats;
+  stats.SetNumberOfThreads( 8 );
+  ASSERT_NO_THROW( stats.Execute( img ) );
+  EXPECT_EQ( 4u, stats.GetExecutionNumberOfThreads() );
+  EXPECT_EQ( 0u, sitk::ThreadPool::GetNumberOfThreadsInUse() );
+  EXPECT_EQ( expectedHash, sitk::Hash( gaussian.Execute( img ) ) );
+  EXPECT_EQ( 4u, gaussian.GetExecutionNumberOfThreads() );
+
+  // nor does a failed execution
+  sitk::ImageFileWriter writer;
+  writer.SetFileName( dataFinder.GetOutputFile( "NoSuchDirectory/ThreadPool.nrrd" ) );
+  EXPECT_ANY_THROW( writer.Execute( img ) );
+  EXPECT_EQ( 0u, sitk::ThreadPool::GetNumberOfThreadsInUse() );
+
+  sitk::ThreadPool::ShareThreadsOff();
+  EXPECT_EQ( expectedHash, sitk::Hash( gaussian.Execute( img ) ) );
+  EXPECT_EQ( 8u, gaussian.GetExecutionNumberOfThreads() );
+
+  sitk::ThreadPool::SetEnabled( wasEnabled );
+  sitk::ThreadPool::SetNumberOfThreads( 0 );
+}
+
+
+namespace
+{
+// a task returning the image of a future
+struct GetFutureTask
+{
+  GetFutureTask( const itk::simple::ImageFuture *future ) : m_Future( future ) {}
+  itk::simple::Image operator()( const std::vector<itk::simple::Image> & ) const
+    { return m_Future->Get(); }
+  const itk::simple::ImageFuture *m_Future;
+};
+}
+
+TEST(BasicFilters,TaskGraph)
+{
+  namespace sitk = itk::simple;
+
+  sitk::Image img;
+  ASSERT_NO_THROW( img = sitk::ReadImage( dataFinder.GetFile ( "Input/RA-Float.nrrd" ) ) ) << "Reading input Image.";
+
+  sitk::GradientMagnitudeImageFilter gradient;
+  sitk::OtsuThresholdImageFilter otsu;
+  sitk::MaskImageFilter mask;
+  const std::string expectedHash = sitk::Hash( mask.Execute( gradient.Execute( img ), otsu.Execute( img ) ) );
+
+  sitk::TaskGraph graph;
+  graph.SetNumberOfThreads( 2 );
+  EXPECT_EQ( 2u, graph.GetNumberOfThreads() );
+
+  sitk::ImageFuture input = graph.AddImage( img );
+  EXPECT_TRUE( input.IsReady() );
+
+  sitk::ImageFuture gradientFuture = graph.Submit( gradient, input );
+  sitk::ImageFuture otsuFuture = graph.Submit( otsu, input );
+  sitk::ImageFuture maskFuture = graph.Submit( mask, gradientFuture, otsuFuture );
+  EXPECT_EQ( 4u, graph.GetNumberOfTasks() );
+  EXPECT_FALSE( maskFuture.IsReady() );
+
+  // a task which fails, and a task depending on it
+  sitk::AddImageFilter add;
+  sitk::ImageFuture small = graph.AddImage( sitk::Image( 10, 10, 10, sitk::sitkFloat32 ) );
+  sitk::ImageFuture failed = graph.Submit( add, input, small );
+  sitk::ImageFuture dependent = graph.Submit( gradient, failed );
+
+  ASSERT_NO_THROW( graph.Execute() );
+  EXPECT_TRUE( maskFuture.IsReady() );
+  EXPECT_EQ( expectedHash, sitk::Hash( maskFuture.Get() ) );
+  EXPECT_TRUE( failed.IsReady() );
+  EXPECT_THROW( failed.Get(), sitk::GenericException );
+  EXPECT_THROW( dependent.Get(), sitk::GenericException );
+
+  // the input is not modified by the concurrent tasks
+  EXPECT_EQ( sitk::Hash( img ), sitk::Hash( input.Get() ) );
+
+  // an unexecuted future executes the graph
+  sitk::ImageFuture again = graph.Submit( gradient, input );
+  EXPECT_EQ( sitk::Hash( gradientFuture.Get() ), sitk::Hash( again.Get() ) );
+
+  sitk::TaskGraph other;
+  EXPECT_THROW( other.Submit( gradient, input ), sitk::GenericException );
+  EXPECT_FALSE( sitk::ImageFuture().IsValid() );
+
+  // a task waiting for a task which has not executed fails instead
+  // of blocking the graph
+  sitk::TaskGraph waitingGraph;
+  sitk::ImageFuture waiting = waitingGraph.Submit( otsu,
+                                                   sitk::TaskGraph::TaskFunction( GetFutureTask( &waiting ) ),
+                                                   std::vector<sitk::ImageFuture>() );
+  ASSERT_NO_THROW( waitingGraph.Execute() );
+  EXPECT_TRUE( waiting.IsReady() );
+  EXPECT_THROW( waiting.Get(), sitk::GenericException );
+
+  graph.Clear();
+  EXPECT_FALSE( input.IsValid() );
+}
@@ -94,6 +94,113 @@ TEST(IO,ImageFileReader) {
   image = reader.Execute();
 }
 
+TEST(IO,ImageFileReader_Extract) {
+
+  namespace sitk = itk::simple;
+
+  sitk::ImageFileReader reader;
+
+  EXPECT_TRUE( reader.GetExtractSize().empty() );
+  EXPECT_TRUE( reader.GetExtractIndex().empty() );
+
+  const std::string fileName = dataFinder.GetFile( "Input/RA-Short.nrrd" );
+  reader.SetFileName( fileName );
+
+  sitk::Image fullImage = reader.Execute();
+
+  std::vector<unsigned int> size( 3, 4u );
+  std::vector<int> index( 3, 0 );
+  index[0] = 3;
+  index[1] = 5;
+  index[2] = 1;
+
+  reader.SetExtractSize( size );
+  reader.SetExtractIndex( index );
+  EXPECT_EQ( size, reader.GetExtractSize() );
+  EXPECT_EQ( index, reader.GetExtractIndex() );
+  EXPECT_NO_THROW( reader.ToString() );
+
+  sitk::Image image = reader.Execute();
+  EXPECT_EQ( size, image.GetSize() );
+  EXPECT_EQ( fullImage.GetSpacing(), image.GetSpacing() );
+  EXPECT_EQ( fullImage.GetDirection(), image.GetDirection() );
+  EXPECT_VECTOR_DOUBLE_NEAR( fullImage.TransformIndexToPhysicalPoint( std::vector<int64_t>( index.begin(), index.end() ) ),
+                             image.GetOrigin(), 1e-8 );
+
+  std::vector<uint32_t> idx( 3, 2u );
+  std::vector<uint32_t> fullIdx( 3 );
+  for ( unsigned int i = 0; i < 3; ++i )
+    {
+    fullIdx[i] = idx[i] + index[i];
+    }
+  EXPECT_EQ( fullImage.GetPixelAsInt16( fullIdx ), image.GetPixelAsInt16( idx ) );
+
+  // the region must be inside the image
+  reader.SetExtractIndex( std::vector<int>( 3, -1 ) );
+  EXPECT_THROW( reader.Execute(), sitk::GenericException );
+
+  // the size must match the dimension of the file
+  reader.SetExtractIndex( std::vector<int>() );
+  reader.SetExtractSize( std::vector<unsigned int>( 2, 4u ) );
+  EXPECT_THROW( reader.Execute(), sitk::GenericException );
+
+  // an empty extraction region is not allowed
+  std::vector<unsigned int> emptySize( 3, 4u );
+  emptySize[1] = 0;
+  reader.SetExtractSize( emptySize );
+  EXPECT_THROW( reader.Execute(), sitk::GenericException );
+
+  reader.SetExtractSize( std::vector<unsigned int>() );
+  EXPECT_EQ( sitk::Hash( fullImage ), sitk::Hash( reader.Execute() ) );
+}
+
+TEST(IO,ReadImageInformation) {
+
+  namespace sitk = itk::simple;
+
+  sitk::ImageFileReader reader;
+
+  EXPECT_EQ( sitk::sitkUnknown, reader.GetPixelID() );
+  EXPECT_EQ( 0u, reader.GetDimension() );
+  EXPECT_TRUE( reader.GetSize().empty() );
+  EXPECT_TRUE( reader.GetMetaDataKeys().empty() );
+
+  reader.SetFileName( dataFinder.GetFile( "Input/RA-Short.nrrd" ) );
+  reader.ReadImageInformation();
+
+  sitk::Image image = sitk::ReadImage( reader.GetFileName() );
+
+  EXPECT_EQ( image.GetPixelID(), reader.GetPixelID() );
+  EXPECT_EQ( image.GetPixelIDValue(), reader.GetPixelIDValue() );
+  EXPECT_EQ( image.GetDimension(), reader.GetDimension() );
+  EXPECT_EQ( image.GetNumberOfComponentsPerPixel(), reader.GetNumberOfComponents() );
+  EXPECT_EQ( image.GetOrigin(), reader.GetOrigin() );
+  EXPECT_EQ( image.GetSpacing(), reader.GetSpacing() );
+  EXPECT_EQ( image.GetDirection(), reader.GetDirection() );
+  EXPECT_EQ( image.GetSize(), reader.GetSize() );
+
+  EXPECT_EQ( image.GetMetaDataKeys(), reader.GetMetaDataKeys() );
+  std::vector<std::string> keys = reader.GetMetaDataKeys();
+  for ( size_t i = 0; i < keys.size(); ++i )
+    {
+    EXPECT_TRUE( reader.HasMetaDataKey( keys[i] ) );
+    EXPECT_EQ( image.GetMetaData( keys[i] ), reader.GetMetaData( keys[i] ) );
+    }
+  EXPECT_FALSE( reader.HasMetaDataKey( "nothing" ) );
+  EXPECT_ANY_THROW( reader.GetMetaData( "nothing" ) );
+
+  // the information is of the file, not the output pixel type
+  reader.SetOutputPixelType( sitk::sitkVectorFloat32 );
+  reader.SetFileName( dataFinder.GetFile( "Input/VM1111Shrink-RGB.png" ) );
+  image = reader.Execute();
+  EXPECT_EQ( sitk::sitkVectorUInt8, reader.GetPixelID() );
+  EXPECT_EQ( 3u, reader.GetNumberOfComponents() );
+  EXPECT_EQ( 2u, reader.GetDimension() );
+
+  reader.SetFileName( dataFinder.GetFile( "Input/this_file_does_not_exist.nrrd" ) );
+  EXPECT_THROW( reader.ReadImageInformation(), sitk::GenericException );
+}
+
 TEST(IO,ImageFileWriter) {
   namespace sitk = itk::simple;
 
@@ -139,6 +246,77 @@ TEST(IO,ImageFileWriter) {
   EXPECT_NO_THROW ( writer.ToString() );
 }
 
+TEST(IO,ImageFileWriter_Streaming) {
+  namespace sitk = itk::simple;
+
+  sitk::ImageFileWriter writer;
+  EXPECT_EQ( 1u, writer.GetNumberOfStreamDivisions() );
+  EXPECT_TRUE( writer.GetPasteIndex().empty() );
+
+  sitk::Image image = sitk::ReadImage( dataFinder.GetFile( "Input/RA-Short.nrrd" ) );
+
+  const std::string filename = dataFinder.GetOutputFile( "IO.ImageFileWriter_Streaming.mha" );
+  writer.SetNumberOfStreamDivisions( 5 ).SetFileName( filename );
+  EXPECT_EQ( 5u, writer.GetNumberOfStreamDivisions() );
+  EXPECT_EQ( filename, writer.GetFileName() );
+  EXPECT_NO_THROW( writer.ToString() );
+  writer.Execute( image );
+
+  EXPECT_EQ( sitk::Hash( image ), sitk::Hash( sitk::ReadImage( filename ) ) );
+
+  // the maximum memory is converted into stream divisions
+  const uint64_t quarterBytes = image.GetNumberOfPixels() * sizeof(int16_t) / 4;
+  EXPECT_EQ( &writer, &writer.SetNumberOfStreamDivisions( 1 ).SetMaximumMemory( quarterBytes ) );
+  EXPECT_EQ( quarterBytes, writer.GetMaximumMemory() );
+  writer.Execute( image );
+  writer.SetMaximumMemory( 0 );
+
+  // the file is read in pieces, keeping the meta-data
+  sitk::ImageFileReader reader;
+  reader.SetFileName( filename );
+  sitk::Image expected = reader.Execute();
+  EXPECT_EQ( &reader, &reader.SetNumberOfStreamDivisions( 3 ).SetMaximumMemory( quarterBytes ) );
+  sitk::Image streamed = reader.Execute();
+  EXPECT_EQ( sitk::Hash( image ), sitk::Hash( streamed ) );
+  EXPECT_EQ( expected.GetMetaDataKeys(), streamed.GetMetaDataKeys() );
+
+  // paste a sub-region into the existing file
+  sitk::Image patch( 4, 4, 4, sitk::sitkInt16 );
+  std::vector<uint32_t> idx( 3, 1u );
+  patch.SetPixelAsInt16( idx, 1234 );
+
+  std::vector<int> index( 3, 2 );
+  writer.SetNumberOfStreamDivisions( 1 );
+  writer.SetPasteIndex( index );
+  EXPECT_EQ( index, writer.GetPasteIndex() );
+  writer.Execute( patch );
+
+  sitk::Image result = sitk::ReadImage( filename );
+  EXPECT_EQ( image.GetSize(), result.GetSize() );
+  EXPECT_EQ( image.GetOrigin(), result.GetOrigin() );
+  EXPECT_EQ( image.GetSpacing(), result.GetSpacing() );
+
+  std::vector<uint32_t> resultIdx( 3, 3u );
+  EXPECT_EQ( 1234, result.GetPixelAsInt16( resultIdx ) );
+  resultIdx[0] = 2;
+  EXPECT_EQ( 0, result.GetPixelAsInt16( resultIdx ) );
+  resultIdx.assign( 3, 0u );
+  EXPECT_EQ( image.GetPixelAsInt16( resultIdx ), result.GetPixelAsInt16( resultIdx ) );
+
+  // the patch must be inside the file
+  writer.SetPasteIndex( std::vector<int>( 3, -1 ) );
+  EXPECT_THROW( writer.Execute( patch ), sitk::GenericException );
+
+  // the paste index must match the dimension of the image
+  writer.SetPasteIndex( std::vector<int>( 2, 0 ) );
+  EXPECT_THROW( writer.Execute( patch ), sitk::GenericException );
+
+  // the pixel type must match the file
+  writer.SetPasteIndex( index );
+  EXPECT_THROW( writer.Execute( sitk::Image( 4, 4, 4, sitk::sitkFloat32 ) ), sitk::GenericException );
+  EXPECT_EQ( 1234, sitk::ReadImage( filename ).GetPixelAsInt16( std::vector<uint32_t>( 3, 3u ) ) );
+}
+
 TEST(IO,ReadWrite) {
   namespace sitk = itk::simple;
   sitk::HashImageFilter hasher;
@@ -377,6 +555,25 @@ TEST(IO, DicomSeriesReader) {
   EXPECT_ANY_THROW( reader.GetMetaDataKeys(99) );
   EXPECT_ANY_THROW( reader.HasMetaDataKey(99, "nothing") );
   EXPECT_ANY_THROW( reader.GetMetaData(99, "nothing") );
+
+  // the slices decoded by multiple threads must match a single thread
+  reader.SetNumberOfThreads( 1 );
+  sitk::Image serialImage = reader.Execute();
+  std::vector< std::string > serialPositions;
+  for (unsigned int i = 0; i <  serialImage.GetSize()[2]; ++i)
+    {
+    serialPositions.push_back( reader.GetMetaData(i, "0020|0032") );
+    }
+
+  reader.SetNumberOfThreads( 3 );
+  image = reader.Execute();
+  EXPECT_EQ( sitk::Hash( serialImage ), sitk::Hash( image ) );
+  EXPECT_EQ( serialImage.GetOrigin(), image.GetOrigin() );
+  EXPECT_EQ( serialImage.GetSpacing(), image.GetSpacing() );
+  for (unsigned int i = 0; i <  image.GetSize()[2]; ++i)
+    {
+    EXPECT_EQ( serialPositions[i], reader.GetMetaData(i, "0020|0032") ) << "Slice " << i;
+    }
 }
 
 
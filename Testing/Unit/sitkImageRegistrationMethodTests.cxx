@@ -208,6 +208,79 @@ TEST_F(sitkRegistrationMethodTest, Metric_Evaluate)
   R3.SetMetricAsMeanSquares();
   R3.SetMetricMovingMask(sitk::Less(movingBlobs,0));
   EXPECT_NEAR(3.34e-09 ,R3.MetricEvaluate(fixedBlobs,movingBlobs), 1e-10);
+
+  // the registration can not stream
+  R3.SetMaximumMemory(1024);
+  EXPECT_THROW(R3.MetricEvaluate(fixedBlobs,movingBlobs), sitk::GenericException);
+  EXPECT_THROW(R3.Execute(fixedBlobs,movingBlobs), sitk::GenericException);
+  R3.SetMaximumMemory(0);
+  R3.SetNumberOfStreamDivisions(2);
+  EXPECT_THROW(R3.ExecuteBatch(fixedBlobs,std::vector<sitk::Image>(1,movingBlobs)), sitk::GenericException);
+}
+
+TEST_F(sitkRegistrationMethodTest, Metric_EvaluateBatch)
+{
+  sitk::ImageRegistrationMethod R;
+  R.SetMetricAsMeanSquares();
+
+  sitk::TranslationTransform tx(2u);
+  R.SetInitialTransform(tx);
+
+  // a row of parameters for each evaluation
+  std::vector<double> parameters;
+  for ( int y = -3; y <= 3; ++y )
+    {
+    for ( int x = -3; x <= 3; ++x )
+      {
+      parameters.push_back( 2.0*x );
+      parameters.push_back( 2.0*y );
+      }
+    }
+
+  std::vector<double> values = R.MetricEvaluateBatch( fixedBlobs, movingBlobs, parameters );
+  ASSERT_EQ( parameters.size()/2, values.size() );
+  EXPECT_TRUE( R.GetMetricEvaluateBatchDerivatives().empty() );
+
+  for ( size_t i = 0; i < values.size(); ++i )
+    {
+    sitk::ImageRegistrationMethod R2;
+    R2.SetMetricAsMeanSquares();
+    R2.SetInitialTransform( sitk::TranslationTransform( 2u, v2(parameters[2*i], parameters[2*i+1]) ) );
+    EXPECT_NEAR( R2.MetricEvaluate( fixedBlobs, movingBlobs ), values[i], 1e-10 ) << "Evaluation " << i;
+    }
+
+  // the initial transform is not modified
+  EXPECT_VECTOR_DOUBLE_NEAR(v2(0.0, 0.0), R.GetInitialTransform().GetParameters(), 1e-10);
+
+  std::vector<double> valuesWithDerivatives = R.MetricEvaluateBatch( fixedBlobs, movingBlobs, parameters, true );
+  ASSERT_EQ( parameters.size(), R.GetMetricEvaluateBatchDerivatives().size() );
+  EXPECT_VECTOR_DOUBLE_NEAR( values, valuesWithDerivatives, 1e-10 );
+
+  // the metrics of the threads share the gradient images of the
+  // first one, a single metric computes the same derivatives
+  const std::vector<double> derivatives = R.GetMetricEvaluateBatchDerivatives();
+  sitk::ImageRegistrationMethod R1;
+  R1.SetMetricAsMeanSquares();
+  R1.SetInitialTransform(tx);
+  R1.SetNumberOfThreads(1);
+  EXPECT_VECTOR_DOUBLE_NEAR( values, R1.MetricEvaluateBatch( fixedBlobs, movingBlobs, parameters, true ), 1e-10 );
+  EXPECT_VECTOR_DOUBLE_NEAR( derivatives, R1.GetMetricEvaluateBatchDerivatives(), 1e-8 ) << "Derivatives of a single metric";
+
+  // the derivative is the direction decreasing the value
+  for ( size_t i = 0; i < values.size(); ++i )
+    {
+    const double norm = std::sqrt( derivatives[2*i]*derivatives[2*i] + derivatives[2*i+1]*derivatives[2*i+1] );
+    if ( norm > 1e-8 )
+      {
+      std::vector<double> step(2);
+      step[0] = parameters[2*i] + 0.01 * derivatives[2*i] / norm;
+      step[1] = parameters[2*i+1] + 0.01 * derivatives[2*i+1] / norm;
+      EXPECT_LT( R.MetricEvaluateBatch( fixedBlobs, movingBlobs, step )[0], values[i] ) << "Derivative " << i;
+      }
+    }
+
+  EXPECT_TRUE( R.MetricEvaluateBatch( fixedBlobs, movingBlobs, std::vector<double>() ).empty() );
+  EXPECT_THROW( R.MetricEvaluateBatch( fixedBlobs, movingBlobs, std::vector<double>(3, 0.0) ), sitk::GenericException );
 }
 
 TEST_F(sitkRegistrationMethodTest, Transform_InPlaceOn)
@@ -786,6 +859,132 @@ TEST_F(sitkRegistrationMethodTest, Optimizer_Exhaustive)
 }
 
 
+TEST_F(sitkRegistrationMethodTest, Optimizer_ParallelExhaustive)
+{
+  sitk::Image image = MakeGaussianBlob( v2(64, 64), std::vector<unsigned int>(2,256) );
+
+
+  sitk::ImageRegistrationMethod R;
+  R.SetInterpolator(sitk::sitkLinear);
+
+  sitk::TranslationTransform tx(image.GetDimension());
+  tx.SetOffset(v2(-1,-2));
+  R.SetInitialTransform(tx, false);
+
+  R.SetMetricAsMeanSquares();
+
+  // Search grid of size 11x11
+  R.SetOptimizerAsParallelExhaustive(std::vector<unsigned int>(2,5), 0.5);
+
+  sitk::Transform outTx = R.Execute(image, image);
+
+
+  std::cout << "-------" << std::endl;
+  std::cout << outTx.ToString() << std::endl;
+  std::cout << "Optimizer stop condition: " << R.GetOptimizerStopConditionDescription() << std::endl;
+  std::cout << " Iteration: " << R.GetOptimizerIteration() << std::endl;
+  std::cout << " Metric value: " << R.GetMetricValue() << std::endl;
+
+  double metric_value = R.GetMetricValue();
+  EXPECT_DOUBLE_EQ(0.0, metric_value);
+  EXPECT_EQ(121u, R.GetOptimizerIteration());
+  EXPECT_VECTOR_DOUBLE_NEAR(v2(0.0,0.0), outTx.GetParameters(), 1e-3);
+  EXPECT_VECTOR_DOUBLE_NEAR(v2(-1.0,-2.0), tx.GetParameters(), 1e-3);
+
+  // the cost surface is over the grid of offsets
+  sitk::Image costSurface = R.GetOptimizerCostSurface();
+  EXPECT_EQ(sitk::sitkFloat64, costSurface.GetPixelID());
+  EXPECT_EQ(std::vector<unsigned int>(2,11u), costSurface.GetSize());
+  EXPECT_VECTOR_DOUBLE_NEAR(v2(-3.5,-4.5), costSurface.GetOrigin(), 1e-8);
+  EXPECT_VECTOR_DOUBLE_NEAR(v2(0.5,0.5), costSurface.GetSpacing(), 1e-8);
+
+  std::vector<unsigned int> idx(2);
+  idx[0] = 7;
+  idx[1] = 9;
+  EXPECT_DOUBLE_EQ(metric_value, costSurface.GetPixelAsDouble(idx));
+  idx[0] = 0;
+  idx[1] = 0;
+  EXPECT_LT(metric_value, costSurface.GetPixelAsDouble(idx));
+
+  // the flat values and parameters are in the order of the image
+  std::vector<double> costValues = R.GetOptimizerCostSurfaceValues();
+  std::vector<double> costParameters = R.GetOptimizerCostSurfaceParameters();
+  ASSERT_EQ(121u, costValues.size());
+  ASSERT_EQ(242u, costParameters.size());
+  EXPECT_DOUBLE_EQ(metric_value, costValues[9*11+7]);
+  EXPECT_VECTOR_DOUBLE_NEAR(v2(0.0,0.0), std::vector<double>(costParameters.begin()+2*(9*11+7), costParameters.begin()+2*(9*11+8)), 1e-8);
+  EXPECT_VECTOR_DOUBLE_NEAR(v2(-3.5,-4.5), std::vector<double>(costParameters.begin(), costParameters.begin()+2), 1e-8);
+
+  // the values match the serial exhaustive optimizer
+  R.SetOptimizerAsExhaustive(std::vector<unsigned int>(2,5), 0.5);
+  sitk::Transform serialTx = R.Execute(image, image);
+  EXPECT_VECTOR_DOUBLE_NEAR(serialTx.GetParameters(), outTx.GetParameters(), 1e-8);
+  EXPECT_DOUBLE_EQ(R.GetMetricValue(), metric_value);
+
+  // Execute in place
+
+  R.SetOptimizerScalesFromIndexShift();
+
+  tx.SetOffset(v2(-1,-2));
+  R.SetInitialTransform(tx, true);
+
+  R.SetOptimizerAsParallelExhaustive( std::vector<unsigned int>(2,5), 0.5);
+
+  outTx = R.Execute(image, image);
+
+  EXPECT_VECTOR_DOUBLE_NEAR(v2(0.0,0.0), outTx.GetParameters(), 1e-3);
+  EXPECT_VECTOR_DOUBLE_NEAR(v2(0.0,0.0), tx.GetParameters(), 1e-3);
+  EXPECT_EQ(121u, R.GetOptimizerIteration());
+
+  // with a parameter not sampled the surface has one dimension less
+  R.SetOptimizerScales(v2(1.0,1.0));
+  tx.SetOffset(v2(-1,0));
+  R.SetInitialTransform(tx, false);
+  std::vector<unsigned int> steps(2,0);
+  steps[0] = 3;
+  R.SetOptimizerAsParallelExhaustive( steps, 0.5 );
+  outTx = R.Execute(image, image);
+
+  EXPECT_VECTOR_DOUBLE_NEAR(v2(0.0,0.0), outTx.GetParameters(), 1e-3);
+  EXPECT_EQ(7u, R.GetOptimizerIteration());
+  costSurface = R.GetOptimizerCostSurface();
+  EXPECT_EQ(7u, costSurface.GetSize()[0]);
+  EXPECT_EQ(1u, costSurface.GetSize()[1]);
+  EXPECT_EQ(7u, R.GetOptimizerCostSurfaceValues().size());
+
+  // with more than 3 sampled parameters there is no image, but the
+  // values and the grid are available
+  sitk::AffineTransform affineTx(2u);
+  R.SetInitialTransform(affineTx, false);
+  R.SetOptimizerScales(std::vector<double>(6,1.0));
+  steps.assign(6,1u);
+  steps[1] = 0;
+  steps[2] = 0;
+  R.SetOptimizerAsParallelExhaustive( steps, 0.5 );
+  outTx = R.Execute(image, image);
+
+  EXPECT_EQ(81u, R.GetOptimizerIteration());
+  EXPECT_DOUBLE_EQ(0.0, R.GetMetricValue());
+  EXPECT_EQ(0u, R.GetOptimizerCostSurface().GetNumberOfPixels());
+  costValues = R.GetOptimizerCostSurfaceValues();
+  costParameters = R.GetOptimizerCostSurfaceParameters();
+  ASSERT_EQ(81u, costValues.size());
+  ASSERT_EQ(81u*6u, costParameters.size());
+
+  // the center of the grid is the identity
+  EXPECT_DOUBLE_EQ(R.GetMetricValue(), costValues[40]);
+  EXPECT_VECTOR_DOUBLE_NEAR(affineTx.GetParameters(), std::vector<double>(costParameters.begin()+6*40, costParameters.begin()+6*41), 1e-8);
+  EXPECT_VECTOR_DOUBLE_NEAR(affineTx.GetParameters(), outTx.GetParameters(), 1e-8);
+
+  // the surface is not kept by another optimizer
+  R.SetInitialTransform(tx, false);
+  R.SetOptimizerAsExhaustive(std::vector<unsigned int>(2,1), 0.5);
+  R.SetOptimizerScales(v2(1.0,1.0));
+  R.Execute(image, image);
+  EXPECT_TRUE(R.GetOptimizerCostSurfaceValues().empty());
+}
+
+
 TEST_F(sitkRegistrationMethodTest, Optimizer_Amoeba)
 {
   sitk::Image image = MakeGaussianBlob( v2(64, 64), std::vector<unsigned int>(2,256) );
@@ -1033,3 +1232,221 @@ TEST_F(sitkRegistrationMethodTest, Optimizer_Sampling)
    }
  EXPECT_TRUE(totalDiff > 1e-10) << "Expect difference between metric values with random sampling\n";
 }
+
+
+TEST_F(sitkRegistrationMethodTest, Optimizer_SamplePoints)
+{
+  sitk::Image fixedImage = MakeDualGaussianBlobs( v2(64, 64), v2(54, 74), std::vector<unsigned int>(2,128) );
+  sitk::Image movingImage = MakeDualGaussianBlobs( v2(61.2, 65.5), v2(51.2, 75.5), std::vector<unsigned int>(2,128) );
+
+  fixedImage = sitk::AdditiveGaussianNoise(fixedImage,  0.5, 0, 1u);
+
+  sitk::ImageRegistrationMethod R;
+  R.SetInterpolator(sitk::sitkLinear);
+
+  sitk::TranslationTransform tx(2u);
+  R.SetInitialTransform(tx, false);
+
+  R.SetMetricAsMeanSquares();
+
+  const double fullValue = R.MetricEvaluate(fixedImage, movingImage);
+
+  // sampling the center of every pixel is the full metric
+  std::vector<double> points;
+  std::vector<int64_t> idx(2);
+  for ( idx[1] = 0; idx[1] < 128; ++idx[1] )
+    {
+    for ( idx[0] = 0; idx[0] < 128; ++idx[0] )
+      {
+      std::vector<double> pt = fixedImage.TransformIndexToPhysicalPoint(idx);
+      points.insert( points.end(), pt.begin(), pt.end() );
+      }
+    }
+  R.SetMetricSamplingPoints(points);
+  EXPECT_EQ( points, R.GetMetricSamplingPoints() );
+  EXPECT_NEAR( fullValue, R.MetricEvaluate(fixedImage, movingImage), 1e-8 ) << "Sampling all the pixel centers";
+
+  R.SetMetricSamplingPoints(std::vector<double>(3, 0.0));
+  EXPECT_THROW( R.MetricEvaluate(fixedImage, movingImage), sitk::GenericException );
+
+  // the same coordinates are 3 points in 2D and 2 points in 3D, the
+  // points cached for the 2D image are not used for the volume
+  std::vector<double> coordinates( 6, 32.0 );
+  coordinates[1] = coordinates[4] = 48.0;
+  R.SetMetricSamplingPoints(coordinates);
+  EXPECT_NO_THROW( R.MetricEvaluate(fixedImage, movingImage) );
+  sitk::Image volume = sitk::GaussianSource( sitk::sitkFloat32, std::vector<unsigned int>(3, 64),
+                                             std::vector<double>(3, 16.0), std::vector<double>(3, 32.0) );
+  R.SetInitialTransform(sitk::TranslationTransform(3u), false);
+  EXPECT_NEAR( 0.0, R.MetricEvaluate(volume, volume), 1e-8 ) << "Sample points of an other dimension";
+  R.SetInitialTransform(tx, false);
+  EXPECT_NO_THROW( R.MetricEvaluate(fixedImage, movingImage) );
+  R.SetMetricSamplingPoints(std::vector<double>());
+
+  // without a sampling strategy all the pixels of the mask are sampled
+  sitk::Image samplingMask = sitk::Image( fixedImage.GetSize(), sitk::sitkUInt8 ) + 1;
+  samplingMask.CopyInformation(fixedImage);
+  R.SetMetricSamplingMask(samplingMask);
+  EXPECT_NEAR( fullValue, R.MetricEvaluate(fixedImage, movingImage), 1e-8 ) << "Sampling all the pixels of the mask";
+
+  R.SetMetricSamplingMask( sitk::Image( fixedImage.GetSize(), sitk::sitkUInt8 ) );
+  EXPECT_THROW( R.MetricEvaluate(fixedImage, movingImage), sitk::GenericException );
+  R.SetMetricSamplingMask( sitk::Image() );
+
+  R.SetOptimizerAsRegularStepGradientDescent(1.0, 1e-4, 100, 0.5, 1e-5);
+
+  // the sample points are computed once, so the registrations are
+  // the same with a wall clock seed
+  R.SetMetricSamplingStrategy(R.GRADIENT_MAGNITUDE);
+  R.SetMetricSamplingPercentage(.05, sitk::sitkWallClock);
+
+  sitk::Transform outTx1 = R.Execute(fixedImage, movingImage);
+  sitk::Transform outTx2 = R.Execute(fixedImage, movingImage);
+
+  EXPECT_VECTOR_DOUBLE_NEAR(outTx1.GetParameters(), outTx2.GetParameters(), 1e-10) << "Same registration with the sample points reused";
+  EXPECT_VECTOR_DOUBLE_NEAR(v2(-2.8, 1.5), outTx1.GetParameters(), 0.2) << "Registration with gradient magnitude sampling";
+
+  R.SetMetricSamplingMask(samplingMask);
+  R.SetMetricSamplingStrategy(R.RANDOM);
+  outTx1 = R.Execute(fixedImage, movingImage);
+  outTx2 = R.Execute(fixedImage, movingImage);
+  EXPECT_VECTOR_DOUBLE_NEAR(outTx1.GetParameters(), outTx2.GetParameters(), 1e-10) << "Same registration with the sampling mask";
+}
+
+TEST_F(sitkRegistrationMethodTest, FixedImageCache)
+{
+  sitk::ImageRegistrationMethod R;
+  R.SetInterpolator(sitk::sitkLinear);
+
+  EXPECT_FALSE( R.GetUseFixedImageCache() );
+
+  R.SetMetricAsMeanSquares();
+  R.SetOptimizerAsRegularStepGradientDescent(1.0, 1e-4, 100);
+
+  std::vector<unsigned int> shrinkFactors(2);
+  shrinkFactors[0] = 4;
+  shrinkFactors[1] = 1;
+  R.SetShrinkFactorsPerLevel( shrinkFactors );
+  R.SetSmoothingSigmasPerLevel( v2(2.0, 0.0) );
+
+  sitk::Image fixedMask = sitk::Image( fixedBlobs.GetSize(), sitk::sitkUInt8 ) + 1;
+  R.SetMetricFixedMask( fixedMask );
+
+  sitk::TranslationTransform tx(2u);
+  R.SetInitialTransform(tx, false);
+  sitk::Transform outTx = R.Execute(fixedBlobs, movingBlobs);
+  const double metricValue = R.GetMetricValue();
+
+  EXPECT_EQ( 0u, R.GetNumberOfFixedImageCacheHits() );
+
+  R.UseFixedImageCacheOn();
+  EXPECT_TRUE( R.GetUseFixedImageCache() );
+
+  // the first execution fills the cache, the next ones use it
+  for ( unsigned int i = 0; i < 3; ++i )
+    {
+    sitk::Transform cachedOutTx = R.Execute(fixedBlobs, movingBlobs);
+    EXPECT_EQ( i, R.GetNumberOfFixedImageCacheHits() );
+    EXPECT_VECTOR_DOUBLE_NEAR(outTx.GetParameters(), cachedOutTx.GetParameters(), 1e-6) << "Registration with the fixed image cache";
+    EXPECT_NEAR( metricValue, R.GetMetricValue(), 1e-6 );
+    }
+
+  // a copy of the fixed image shares the buffer and hits the cache
+  sitk::Image fixedCopy = fixedBlobs;
+  R.Execute(fixedCopy, movingBlobs);
+  EXPECT_EQ( 3u, R.GetNumberOfFixedImageCacheHits() );
+
+  // changing the smoothing invalidates the cache
+  R.SetSmoothingSigmasPerLevel( v2(1.0, 0.0) );
+  sitk::Transform cachedOutTx = R.Execute(fixedBlobs, movingBlobs);
+  EXPECT_EQ( 3u, R.GetNumberOfFixedImageCacheHits() );
+  R.UseFixedImageCacheOff();
+  EXPECT_EQ( 0u, R.GetNumberOfFixedImageCacheHits() );
+  EXPECT_VECTOR_DOUBLE_NEAR(R.Execute(fixedBlobs, movingBlobs).GetParameters(), cachedOutTx.GetParameters(), 1e-6) << "Registration with new smoothing sigmas";
+
+  R.UseFixedImageCacheOn();
+  R.ClearFixedImageCache();
+  EXPECT_NO_THROW( R.Execute(fixedBlobs, movingBlobs) );
+  EXPECT_EQ( 0u, R.GetNumberOfFixedImageCacheHits() );
+}
+
+TEST_F(sitkRegistrationMethodTest, ExecuteBatch)
+{
+  sitk::ImageRegistrationMethod R;
+  R.SetInterpolator(sitk::sitkLinear);
+
+  R.SetMetricAsMeanSquares();
+  R.SetOptimizerAsRegularStepGradientDescent(1.0, 1e-4, 100);
+
+  std::vector<unsigned int> shrinkFactors(2);
+  shrinkFactors[0] = 4;
+  shrinkFactors[1] = 1;
+  R.SetShrinkFactorsPerLevel( shrinkFactors );
+  R.SetSmoothingSigmasPerLevel( v2(2.0, 0.0) );
+
+  sitk::TranslationTransform tx(2u);
+  R.SetInitialTransform(tx, false);
+
+  std::vector<sitk::Image> movingImages( 3, movingBlobs );
+  movingImages[1] = fixedBlobs;
+
+  std::vector<sitk::Transform> expectedTx;
+  std::vector<double> expectedMetricValues;
+  for ( size_t i = 0; i < movingImages.size(); ++i )
+    {
+    expectedTx.push_back( R.Execute(fixedBlobs, movingImages[i]) );
+    expectedMetricValues.push_back( R.GetMetricValue() );
+    }
+
+  EXPECT_EQ( 0u, R.GetNumberOfConcurrentRegistrations() );
+  R.SetNumberOfConcurrentRegistrations( 2 );
+  EXPECT_EQ( 2u, R.GetNumberOfConcurrentRegistrations() );
+
+  std::vector<sitk::Transform> outTx = R.ExecuteBatch( fixedBlobs, movingImages );
+  ASSERT_EQ( movingImages.size(), outTx.size() );
+  ASSERT_EQ( movingImages.size(), R.GetBatchMetricValues().size() );
+  ASSERT_EQ( movingImages.size(), R.GetBatchOptimizerStopConditionDescriptions().size() );
+  ASSERT_EQ( movingImages.size(), R.GetBatchOptimizerIterations().size() );
+
+  for ( size_t i = 0; i < movingImages.size(); ++i )
+    {
+    EXPECT_VECTOR_DOUBLE_NEAR(expectedTx[i].GetParameters(), outTx[i].GetParameters(), 1e-6) << "Batch registration " << i;
+    EXPECT_NEAR( expectedMetricValues[i], R.GetBatchMetricValues()[i], 1e-6 );
+    EXPECT_FALSE( R.GetBatchOptimizerStopConditionDescriptions()[i].empty() );
+    }
+
+  // the initial transform is not modified
+  EXPECT_VECTOR_DOUBLE_NEAR(v2(0.0, 0.0), R.GetInitialTransform().GetParameters(), 1e-10);
+
+  // the registrations of the batch share the smoothed fixed images
+  R.UseFixedImageCacheOn();
+  outTx = R.ExecuteBatch( fixedBlobs, movingImages );
+  EXPECT_EQ( movingImages.size() - 1, R.GetNumberOfFixedImageCacheHits() );
+  for ( size_t i = 0; i < movingImages.size(); ++i )
+    {
+    EXPECT_VECTOR_DOUBLE_NEAR(expectedTx[i].GetParameters(), outTx[i].GetParameters(), 1e-6) << "Batch registration with the fixed image cache " << i;
+    }
+  R.UseFixedImageCacheOff();
+
+  // the cost surfaces of the batch registrations
+  R.SetOptimizerAsParallelExhaustive( std::vector<unsigned int>(2,2), 1.0 );
+  outTx = R.ExecuteBatch( fixedBlobs, movingImages );
+  ASSERT_EQ( movingImages.size(), R.GetBatchOptimizerCostSurfaces().size() );
+  ASSERT_EQ( movingImages.size()*25u, R.GetBatchOptimizerCostSurfaceValues().size() );
+  ASSERT_EQ( movingImages.size()*50u, R.GetBatchOptimizerCostSurfaceParameters().size() );
+  for ( size_t i = 0; i < movingImages.size(); ++i )
+    {
+    R.Execute( fixedBlobs, movingImages[i] );
+    const std::vector<double> expectedValues = R.GetOptimizerCostSurfaceValues();
+    EXPECT_EQ( std::vector<unsigned int>(2,5u), R.GetBatchOptimizerCostSurfaces()[i].GetSize() );
+    EXPECT_VECTOR_DOUBLE_NEAR( expectedValues,
+                               std::vector<double>( R.GetBatchOptimizerCostSurfaceValues().begin() + 25*i,
+                                                    R.GetBatchOptimizerCostSurfaceValues().begin() + 25*(i+1) ),
+                               1e-6 ) << "Batch cost surface " << i;
+    }
+
+  EXPECT_TRUE( R.ExecuteBatch( fixedBlobs, std::vector<sitk::Image>() ).empty() );
+
+  movingImages.push_back( sitk::Image( 10, 10, 10, sitk::sitkFloat32 ) );
+  EXPECT_THROW( R.ExecuteBatch( fixedBlobs, movingImages ), sitk::GenericException );
+}
@@ -501,6 +501,34 @@ TEST_F(Image, CopyOnWrite)
   EXPECT_EQ( sitk::Hash( imgCopy ), sitk::Hash( img0 ) ) << "Hash for shared and copy after set spacing";
 }
 
+TEST_F(Image, CopyOnWriteMetaData)
+{
+  sitk::Image img( 10, 10, sitk::sitkInt16 );
+  sitk::Image imgCopy = img;
+
+  // changing the meta-data should not copy the pixel buffer
+  imgCopy.SetOrigin( std::vector<double>( 2, 2.123 ) );
+  imgCopy.SetMetaData( "k1", "value" );
+  EXPECT_EQ( static_cast<const sitk::Image &>(img).GetBufferAsInt16(), static_cast<const sitk::Image &>(imgCopy).GetBufferAsInt16() )
+    << " Pixel buffer shared after setting meta-data";
+  EXPECT_EQ( std::vector<double>( 2, 0.0 ), img.GetOrigin() );
+  EXPECT_EQ( std::vector<double>( 2, 2.123 ), imgCopy.GetOrigin() );
+  EXPECT_FALSE( img.HasMetaDataKey( "k1" ) );
+  EXPECT_TRUE( imgCopy.HasMetaDataKey( "k1" ) );
+
+  EXPECT_TRUE( imgCopy.EraseMetaData( "k1" ) );
+  EXPECT_FALSE( imgCopy.HasMetaDataKey( "k1" ) );
+
+  // the shared pixel buffer must be copied before pixels are modified
+  std::vector<uint32_t> idx( 2, 1u );
+  imgCopy.SetPixelAsInt16( idx, 7 );
+  EXPECT_NE( static_cast<const sitk::Image &>(img).GetBufferAsInt16(), static_cast<const sitk::Image &>(imgCopy).GetBufferAsInt16() )
+    << " Pixel buffer unique after setting a pixel";
+  EXPECT_EQ( 0, img.GetPixelAsInt16( idx ) );
+  EXPECT_EQ( 7, imgCopy.GetPixelAsInt16( idx ) );
+  EXPECT_EQ( std::vector<double>( 2, 2.123 ), imgCopy.GetOrigin() );
+}
+
 TEST_F(Image,Operators)
 {
 
@@ -1574,6 +1602,96 @@ TEST_F(Image, GetBufferVector)
 
 }
 
+TEST_F(Image,BatchedPixelAccess)
+{
+  sitk::Image img = sitk::Image( 10, 20, sitk::sitkInt16 );
+
+  std::vector<uint32_t> idx( 2 );
+  idx[0] = 3; idx[1] = 4;
+  img.SetPixelAsInt16( idx, 7 );
+  idx[0] = 4; idx[1] = 4;
+  img.SetPixelAsInt16( idx, 9 );
+
+  std::vector<uint32_t> indexes;
+  indexes.push_back( 3 ); indexes.push_back( 4 );
+  indexes.push_back( 4 ); indexes.push_back( 4 );
+  indexes.push_back( 0 ); indexes.push_back( 0 );
+
+  std::vector<double> values = img.GetPixelsAsDouble( indexes );
+  ASSERT_EQ( 3u, values.size() );
+  EXPECT_EQ( 7.0, values[0] );
+  EXPECT_EQ( 9.0, values[1] );
+  EXPECT_EQ( 0.0, values[2] );
+
+  // scatter is copy on write
+  sitk::Image img2 = img;
+  values[2] = -3.0;
+  img2.SetPixelsAsDouble( indexes, values );
+  idx[0] = 0; idx[1] = 0;
+  EXPECT_EQ( -3, img2.GetPixelAsInt16( idx ) );
+  EXPECT_EQ( 0, img.GetPixelAsInt16( idx ) );
+
+  // interpolation
+  std::vector<double> points;
+  points.push_back( 3.5 ); points.push_back( 4.0 );
+  points.push_back( 3.6 ); points.push_back( 4.0 );
+  points.push_back( -2.0 ); points.push_back( 4.0 );
+  values = img.EvaluateAtContinuousIndexes( points );
+  ASSERT_EQ( 3u, values.size() );
+  EXPECT_DOUBLE_EQ( 8.0, values[0] );
+  EXPECT_DOUBLE_EQ( 8.2, values[1] );
+  EXPECT_EQ( 0.0, values[2] );
+
+  values = img.EvaluateAtContinuousIndexes( points, sitk::sitkNearestNeighbor, -1.0 );
+  EXPECT_EQ( 9.0, values[0] );
+  EXPECT_EQ( 9.0, values[1] );
+  EXPECT_EQ( -1.0, values[2] );
+
+  img.SetOrigin( std::vector<double>( 2, 10.0 ) );
+  img.SetSpacing( std::vector<double>( 2, 2.0 ) );
+  points.resize( 2 );
+  points[0] = 10.0 + 2.0*3.5;
+  points[1] = 10.0 + 2.0*4.0;
+  values = img.EvaluateAtPhysicalPoints( points );
+  ASSERT_EQ( 1u, values.size() );
+  EXPECT_DOUBLE_EQ( 8.0, values[0] );
+
+  // no pixel is set when any index is out of bounds
+  std::vector<uint32_t> badIndexes( 4, 0u );
+  badIndexes[2] = 10;
+  idx[0] = 0; idx[1] = 0;
+  const int16_t before = img.GetPixelAsInt16( idx );
+  EXPECT_ANY_THROW( img.SetPixelsAsDouble( badIndexes, std::vector<double>( 2, 5.0 ) ) );
+  EXPECT_EQ( before, img.GetPixelAsInt16( idx ) );
+
+  // out of bounds, mis-sized and unsupported requests
+  indexes[0] = 10;
+  EXPECT_ANY_THROW( img.GetPixelsAsDouble( indexes ) );
+  indexes.pop_back();
+  EXPECT_ANY_THROW( img.GetPixelsAsDouble( indexes ) );
+  EXPECT_ANY_THROW( img.EvaluateAtContinuousIndexes( points, sitk::sitkBSpline ) );
+  EXPECT_ANY_THROW( sitk::Image( 10, 10, sitk::sitkComplexFloat32 ).GetPixelsAsDouble( std::vector<uint32_t>( 2, 0u ) ) );
+
+  // vector images have a value for each component
+  sitk::Image vimg = sitk::Image( 5, 5, sitk::sitkVectorFloat32 );
+  std::vector<float> v( 2 );
+  v[0] = 1.0f; v[1] = 2.0f;
+  idx[0] = 1; idx[1] = 2;
+  vimg.SetPixelAsVectorFloat32( idx, v );
+  values = vimg.GetPixelsAsDouble( idx );
+  ASSERT_EQ( 2u, values.size() );
+  EXPECT_EQ( 1.0, values[0] );
+  EXPECT_EQ( 2.0, values[1] );
+
+  points.resize( 2 );
+  points[0] = 1.0;
+  points[1] = 1.5;
+  values = vimg.EvaluateAtContinuousIndexes( points );
+  ASSERT_EQ( 2u, values.size() );
+  EXPECT_DOUBLE_EQ( 0.5, values[0] );
+  EXPECT_DOUBLE_EQ( 1.0, values[1] );
+}
+
 TEST_F(Image,MetaDataDictionary)
 {
   sitk::Image img = sitk::Image( 10,10, 10, sitk::sitkFloat32 );
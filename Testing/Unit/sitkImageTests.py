@@ -78,6 +78,79 @@ class ImageTests(unittest.TestCase):
 
         self.assertEqual(len( image ), 100)
 
+    def test_inplace_operators(self):
+        """Test the in-place arithmetic and logic operators"""
+
+        image = sitk.Image( 10, 10, sitk.sitkInt32 )
+        alias = image
+
+        image += 2
+        self.assertTrue( image is alias )
+        self.assertEqual( image.GetPixel(4,4), 2 )
+
+        image *= image
+        image -= 1
+        self.assertEqual( image.GetPixel(4,4), 3 )
+
+        image //= 2
+        self.assertEqual( image.GetPixel(4,4), 1 )
+
+        image |= 6
+        image &= 3
+        image ^= 1
+        self.assertEqual( image.GetPixel(4,4), 2 )
+
+        image += 5
+        image %= 4
+        self.assertTrue( image is alias )
+        self.assertEqual( image.GetPixel(4,4), 3 )
+        image -= 1
+
+        # unsupported operands are not implemented
+        with self.assertRaises( TypeError ):
+            image += [1]
+        with self.assertRaises( TypeError ):
+            image %= None
+
+        # a copy shares the buffer, and must not be modified
+        copy = sitk.Image( image )
+        image += 1
+        self.assertEqual( image.GetPixel(4,4), 3 )
+        self.assertEqual( copy.GetPixel(4,4), 2 )
+
+        copy = sitk.Cast( image, sitk.sitkFloat32 )
+        copy /= 4.0
+        self.assertEqual( copy.GetPixel(4,4), 0.75 )
+
+
+    def test_image_expression(self):
+        """Test lazy image expressions"""
+
+        a = sitk.Image( 10, 10, sitk.sitkInt16 ) + 5
+        b = sitk.Image( 10, 10, sitk.sitkInt16 ) + 2
+        c = sitk.Image( 10, 10, sitk.sitkInt16 ) + 3
+
+        e = ( sitk.ImageExpression( a ) - b ) * c + 5
+        self.assertTrue( isinstance( e, sitk.ImageExpression ) )
+        self.assertEqual( e.GetNumberOfImages(), 3 )
+
+        result = e.Evaluate()
+        self.assertEqual( result.GetPixelID(), sitk.sitkInt16 )
+        self.assertEqual( result.GetPixel(4,4), 14 )
+        self.assertEqual( sitk.Hash( result ), sitk.Hash( ( a - b ) * c + 5 ) )
+
+        # images and constants on the left of an expression
+        e = 2 * a - sitk.ImageExpression( b )
+        self.assertEqual( e.GetNumberOfImages(), 2 )
+        self.assertEqual( e.Evaluate().GetPixel(4,4), 8 )
+        e = 10 - abs( -sitk.ImageExpression( c ) )
+        self.assertEqual( e.Evaluate().GetPixel(4,4), 7 )
+
+        e = a > sitk.ImageExpression( b )
+        self.assertEqual( e.Evaluate().GetPixel(4,4), 1 )
+        e = sitk.ImageExpression( b ) == 3
+        self.assertEqual( e.Evaluate().GetPixel(4,4), 0 )
+
 
 if __name__ == '__main__':
     unittest.main()
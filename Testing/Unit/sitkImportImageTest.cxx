@@ -78,6 +78,14 @@ TEST_F(Import,Required) {
   std::cout << importer.ToString() << std::endl;
 
   EXPECT_EQ( "ImportImageFilter", importer.GetName() );
+
+  // the import can not stream
+  uint8_buffer = std::vector< uint8_t >( 4*4*4, 1 );
+  importer.SetSize( std::vector< unsigned int >( 3, 4u ) );
+  importer.SetBufferAsUInt8( &uint8_buffer[0] );
+  EXPECT_NO_THROW( importer.Execute() );
+  importer.SetNumberOfStreamDivisions( 2 );
+  EXPECT_THROW( importer.Execute(), sitk::GenericException );
 }
 
 TEST_F(Import,BasicUsage) {
@@ -228,6 +236,46 @@ TEST_F(Import,Shallow) {
 
 }
 
+namespace
+{
+void IncrementCount( void *clientData )
+{
+  ++*static_cast<int *>( clientData );
+}
+}
+
+TEST_F(Import,BufferReleaseCallback) {
+
+  // This test verifies the buffer is released once no image uses it
+
+  uint8_buffer = std::vector< uint8_t >( 16*16, 3 );
+
+  int releaseCount = 0;
+
+  sitk::ImportImageFilter importer;
+  importer.SetSize( std::vector< unsigned int >( 2, 16u ) );
+  importer.SetBufferAsUInt8( &uint8_buffer[0] );
+  importer.SetBufferReleaseCallback( IncrementCount, &releaseCount );
+
+  {
+  sitk::Image image = importer.Execute();
+  sitk::Image image2 = image;
+  image.SetOrigin( std::vector<double>( 2, 1.0 ) );
+
+  EXPECT_EQ( 0, releaseCount );
+  image = sitk::Image();
+  EXPECT_EQ( 0, releaseCount );
+
+  std::vector<uint32_t> idx( 2, 0u );
+  EXPECT_EQ( 3, image2.GetPixelAsUInt8( idx ) );
+  }
+  EXPECT_EQ( 1, releaseCount );
+
+  importer.SetBufferReleaseCallback( NULL, NULL );
+  importer.Execute();
+  EXPECT_EQ( 1, releaseCount );
+}
+
 TEST_F(Import,ExhaustiveTypes) {
 
   sitk::ImportImageFilter importer;
@@ -174,5 +174,75 @@ class TestNumpySimpleITKInterface(unittest.TestCase):
       self.assertEqual(image[1,1,1], 25)
       self.assertEqual(image[2,2,2], 50)
 
+    def test_image_view_from_array(self):
+      """Test a SimpleITK Image sharing a numpy array's buffer."""
+
+      arr = np.arange(60, dtype=np.int16)
+      arr.shape = (sizeZ, sizeY, sizeX)
+
+      image = sitk.GetImageViewFromArray(arr)
+      self.assertEqual(image.GetSize(), (sizeX, sizeY, sizeZ))
+      self.assertEqual(sitk.Hash(image), sitk.Hash(sitk.GetImageFromArray(arr)))
+
+      # the buffer is shared
+      arr[1,1,1] = 7
+      self.assertEqual(image[1,1,1], 7)
+
+      # the image holds a reference to the array
+      del arr
+      self.assertEqual(image[2,2,2], 50)
+      image2 = sitk.Image(image)
+      del image
+      self.assertEqual(image2[1,1,1], 7)
+
+      # vector images
+      arr = np.zeros((sizeY, sizeX, 3), dtype=np.float32)
+      arr[1,2] = [1,2,3]
+      image = sitk.GetImageViewFromArray(arr, isVector=True)
+      self.assertEqual(image.GetSize(), (sizeX, sizeY))
+      self.assertEqual(image.GetNumberOfComponentsPerPixel(), 3)
+      self.assertEqual(image[2,1], (1,2,3))
+
+      # non-contiguous arrays are copied
+      arr = np.arange(60, dtype=np.float64)
+      arr.shape = (sizeZ, sizeY, sizeX)
+      image = sitk.GetImageViewFromArray(arr[:,:,::2])
+      self.assertEqual(image.GetSize(), ((sizeX+1)//2, sizeY, sizeZ))
+      self.assertEqual(image[1,0,0], 2.0)
+
+    def test_pixels_as_array(self):
+      """Test batched pixel access with numpy arrays."""
+
+      image = sitk.Image(sizeX, sizeY, sitk.sitkInt16)
+      image[3,4] = 7
+      image[1,2] = 9
+
+      indexes = np.array([[3,4],[1,2],[0,0]])
+      values = sitk.GetPixelsAsArray(image, indexes)
+      self.assertEqual(values.dtype, np.float64)
+      self.assertEqual(list(values), [7.0, 9.0, 0.0])
+      self.assertEqual(list(values), image.GetPixelsAsDouble(indexes.flatten().tolist()))
+
+      sitk.SetPixelsFromArray(image, indexes, np.array([1.0, 2.0, 3.0]))
+      self.assertEqual((image[3,4], image[1,2], image[0,0]), (1, 2, 3))
+
+      # nothing is set when an index is out of bounds
+      self.assertRaises(RuntimeError, sitk.SetPixelsFromArray, image, [[0,0],[sizeX,0]], [5.0, 5.0])
+      self.assertEqual(image[0,0], 3)
+
+      values = sitk.EvaluateAtContinuousIndexesAsArray(image, [[0.5,0.0],[-2.0,0.0]], sitk.sitkLinear, -1.0)
+      self.assertEqual(list(values), [1.5, -1.0])
+
+      image.SetSpacing((2.0, 2.0))
+      values = sitk.EvaluateAtPhysicalPointsAsArray(image, [[1.0,0.0]])
+      self.assertEqual(list(values), [1.5])
+
+      # vector images have a row of components for each index
+      image = sitk.Image(sizeX, sizeY, sitk.sitkVectorFloat32, 3)
+      image[1,2] = (1,2,3)
+      values = sitk.GetPixelsAsArray(image, [1,2,0,0])
+      self.assertEqual(values.shape, (2,3))
+      self.assertEqual(list(values[0]), [1.0, 2.0, 3.0])
+
 if __name__ == '__main__':
     unittest.main()
@@ -160,3 +160,112 @@ TEST(OperatorTests, AdditionalDivide)
   EXPECT_EQ( -0.25,  sitk::DivideReal(img1, -4).GetPixelAsDouble(idx) );
 
 }
+
+
+TEST(OperatorTests, InPlace)
+{
+
+  sitk::Image img1 ( 10, 10, sitk::sitkInt32 );
+  EXPECT_TRUE( img1.IsUnique() );
+
+  // a unique image reuses its buffer
+  const int32_t *buffer = img1.GetBufferAsInt32();
+  img1 += 1;
+  EXPECT_EQ( buffer, img1.GetBufferAsInt32() );
+  EXPECT_EQ( "116d707122e1c00c7328c57232a904df3a1f629d", sitk::Hash( img1 ) );
+
+  img1 *= img1;
+  img1 += img1;
+  EXPECT_EQ( buffer, img1.GetBufferAsInt32() );
+  EXPECT_EQ( "aca12668dde9598b74907488ae060a9c1cb71bd9", sitk::Hash( sitk::Cast( img1, sitk::sitkUInt8 ) ) );
+
+  // a shared image is not modified
+  sitk::Image img2 = img1;
+  EXPECT_FALSE( img1.IsUnique() );
+  EXPECT_FALSE( img2.IsUnique() );
+
+  img1 -= 1;
+  EXPECT_NE( img1.GetBufferAsInt32(), img2.GetBufferAsInt32() );
+  EXPECT_EQ( "116d707122e1c00c7328c57232a904df3a1f629d", sitk::Hash( img1 ) );
+  EXPECT_EQ( 2, img2.GetPixelAsInt32( std::vector<uint32_t>( 2, 4 ) ) );
+  EXPECT_TRUE( img1.IsUnique() );
+  EXPECT_TRUE( img2.IsUnique() );
+
+  // the output pixel type of DivideReal differs, so the result is
+  // assigned to the image
+  sitk::DivideRealImageFilter divider;
+  divider.ExecuteInPlace( img2, 4.0 );
+  EXPECT_EQ( sitk::sitkFloat64, img2.GetPixelID() );
+  EXPECT_EQ( 0.5, img2.GetPixelAsDouble( std::vector<uint32_t>( 2, 4 ) ) );
+
+}
+
+
+TEST(OperatorTests, ImageExpression)
+{
+
+  sitk::Image a ( 10, 10, sitk::sitkInt16 );
+  sitk::Image b ( 10, 10, sitk::sitkInt16 );
+  sitk::Image c ( 10, 10, sitk::sitkInt16 );
+  a += 5;
+  b += 2;
+  c += 3;
+
+  const std::vector<uint32_t> idx( 2, 4 );
+
+  // the fused expression matches the chain of filters
+  sitk::ImageExpression e = ( sitk::ImageExpression( a ) - b ) * c + 5;
+  EXPECT_EQ( 3u, e.GetNumberOfImages() );
+  EXPECT_EQ( "(((image0 - image1) * image2) + 5)", e.ToString() );
+
+  sitk::Image result = e.Evaluate();
+  EXPECT_EQ( sitk::sitkInt16, result.GetPixelID() );
+  EXPECT_EQ( 14, result.GetPixelAsInt16( idx ) );
+  EXPECT_EQ( sitk::Hash( ( a - b ) * c + 5 ), sitk::Hash( result ) );
+
+  // an image used several times is only one input
+  e = sitk::ImageExpression( a ) * a - 2.0 * sitk::ImageExpression( a );
+  EXPECT_EQ( 1u, e.GetNumberOfImages() );
+  EXPECT_EQ( 15, e.Evaluate().GetPixelAsInt16( idx ) );
+
+  e = sitk::Minimum( sitk::Abs( b - sitk::ImageExpression( a ) ), c ) + sitk::Maximum( 4.0, sitk::ImageExpression( b ) );
+  EXPECT_EQ( 7, e.Evaluate().GetPixelAsInt16( idx ) );
+
+  e = -sitk::Sqrt( sitk::ImageExpression( a ) * 5 );
+  EXPECT_EQ( -5, e.Evaluate().GetPixelAsInt16( idx ) );
+
+  // integer results are rounded to the nearest integer
+  EXPECT_EQ( 2, ( sitk::ImageExpression( a ) / 3 ).Evaluate().GetPixelAsInt16( idx ) );
+  EXPECT_EQ( -2, ( -sitk::ImageExpression( a ) / 3 ).Evaluate().GetPixelAsInt16( idx ) );
+  EXPECT_EQ( 1, ( sitk::ImageExpression( b ) / 3 ).Evaluate().GetPixelAsInt16( idx ) );
+
+  // comparisons evaluate to 1 or 0
+  EXPECT_EQ( 1, ( sitk::ImageExpression( a ) > b ).Evaluate().GetPixelAsInt16( idx ) );
+  EXPECT_EQ( 0, ( sitk::ImageExpression( a ) <= b ).Evaluate().GetPixelAsInt16( idx ) );
+  EXPECT_EQ( 1, ( c == sitk::ImageExpression( b ) + 1 ).Evaluate().GetPixelAsInt16( idx ) );
+  EXPECT_EQ( 0, ( c != sitk::ImageExpression( b ) + 1 ).Evaluate().GetPixelAsInt16( idx ) );
+
+  // intermediate values do not overflow, the result is clamped
+  sitk::Image u ( 10, 10, sitk::sitkUInt8 );
+  u += 200;
+  EXPECT_EQ( 150, ( ( sitk::ImageExpression( u ) + u ) - 250 ).Evaluate().GetPixelAsUInt8( idx ) );
+  EXPECT_EQ( 0, ( sitk::ImageExpression( 100.0 ) - u ).Evaluate().GetPixelAsUInt8( idx ) );
+  EXPECT_EQ( 255, ( sitk::ImageExpression( u ) * 2 ).Evaluate().GetPixelAsUInt8( idx ) );
+
+  sitk::Image f ( 10, 10, sitk::sitkFloat32 );
+  f += 4.0;
+  EXPECT_EQ( 0.5, ( sitk::Log( sitk::Exp( sitk::ImageExpression( f ) ) ) / 8.0 ).Evaluate().GetPixelAsFloat( idx ) );
+
+  // the images of the expression are not modified
+  EXPECT_EQ( 5, a.GetPixelAsInt16( idx ) );
+  EXPECT_EQ( 200, u.GetPixelAsUInt8( idx ) );
+
+  // errors
+  EXPECT_THROW( sitk::ImageExpression( 1.0 ).Evaluate(), sitk::GenericException );
+  EXPECT_THROW( ( sitk::ImageExpression( a ) + u ).Evaluate(), sitk::GenericException );
+  EXPECT_THROW( sitk::ImageExpression::Apply( sitk::ImageExpression::Add, sitk::ImageExpression( a ) ), sitk::GenericException );
+  EXPECT_THROW( sitk::ImageExpression::Apply( sitk::ImageExpression::Abs, sitk::ImageExpression( a ), sitk::ImageExpression( b ) ), sitk::GenericException );
+  sitk::Image v ( 10, 10, sitk::sitkVectorFloat32 );
+  EXPECT_THROW( ( sitk::ImageExpression( v ) + 1 ).Evaluate(), sitk::GenericException );
+
+}
@@ -21,6 +21,7 @@ import unittest
 
 
 import SimpleITK as sitk
+from multiprocessing.pool import ThreadPool
 
 
 class ProcessObjectTest(unittest.TestCase):
@@ -94,5 +95,25 @@ class ProcessObjectTest(unittest.TestCase):
         self.assertEqual(p,[0.0])
 
 
+    def test_ProcessObject_threaded_Command(self):
+        """Check that commands are invoked from concurrently executing filters"""
+
+        def run(i):
+            f = sitk.DiscreteGaussianImageFilter()
+            f.SetVariance(i+1)
+            p = [0.0]
+            f.AddCommand(sitk.sitkProgressEvent, lambda p=p: p.__setitem__(0, f.GetProgress()) )
+            img = f.Execute(sitk.Image(64,64,32,sitk.sitkFloat32))
+            return (p[0], img.GetSize())
+
+        pool = ThreadPool(4)
+        results = pool.map(run, range(8))
+        pool.close()
+        pool.join()
+
+        for r in results:
+            self.assertEqual(r, (1.0, (64,64,32)))
+
+
 if __name__ == '__main__':
     unittest.main()
@@ -42,6 +42,8 @@
 %CSharpTypemapHelper( uint32_t*, System.IntPtr )
 %CSharpTypemapHelper( float*, System.IntPtr )
 %CSharpTypemapHelper( double*, System.IntPtr )
+%CSharpTypemapHelper( const uint32_t*, System.IntPtr )
+%CSharpTypemapHelper( const double*, System.IntPtr )
 
 // Add override to ToString method
 %csmethodmodifiers ToString "public override";
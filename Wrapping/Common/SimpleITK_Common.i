@@ -95,6 +95,7 @@ namespace std
   %template(VectorFloat) vector<float>;
   %template(VectorDouble) vector<double>;
   %template(VectorOfImage) vector< itk::simple::Image >;
+  %template(VectorOfTransform) vector< itk::simple::Transform >;
   %template(VectorUIntList) vector< vector<unsigned int> >;
   %template(VectorString) vector< std::string >;
 
@@ -176,6 +177,9 @@ namespace std
 
 // Basic Filter Base
 %include "sitkProcessObject.h"
+%include "sitkPipeline.h"
+%include "sitkExecutionProfiler.h"
+%include "sitkThreadPool.h"
 %include "sitkImageFilter.h"
 
 %template(ImageFilter_0) itk::simple::ImageFilter<0>;
@@ -195,6 +199,8 @@ namespace std
 
  // Basic Filters
 %include "sitkHashImageFilter.h"
+%include "sitkImageExpression.h"
+%include "sitkImageExpressionFilter.h"
 %include "sitkBSplineTransformInitializerFilter.h"
 %include "sitkCenteredTransformInitializerFilter.h"
 %include "sitkCenteredVersorTransformInitializerFilter.h"
@@ -97,28 +97,28 @@
                return Add( self, other )
             try:
                return Add( self, float(other)  )
-            except ValueError:
+            except (ValueError, TypeError):
                return NotImplemented
         def __sub__( self, other ):
             if isinstance( other, Image ):
                return Subtract( self, other )
             try:
                return Subtract( self, float(other) )
-            except ValueError:
+            except (ValueError, TypeError):
                return NotImplemented
         def __mul__( self, other ):
             if isinstance( other, Image ):
                return Multiply( self, other )
             try:
                return Multiply( self, float(other) )
-            except ValueError:
+            except (ValueError, TypeError):
                return NotImplemented
         def __div__( self, other ):
             if isinstance( other, Image ):
                return Divide( self, other )
             try:
                return Divide( self, float(other) )
-            except ValueError:
+            except (ValueError, TypeError):
                return NotImplemented
         def __floordiv__( self, other ):
             if isinstance( other, Image ):
@@ -132,7 +132,7 @@
                return DivideReal( self, other )
             try:
                return DivideReal( self, float(other) )
-            except ValueError:
+            except (ValueError, TypeError):
                return NotImplemented
 
 
@@ -177,13 +177,64 @@
 
 
 
-         # NOTE: the __i*__ methods are not implemented because there
-         # currently in no way to make the underlying filters run
-         # inplace. But python will implement a default version based
-         # on the standard method
+        # NOTE: the in-place methods run the underlying filter in-place
+        # on the pixel buffer of self, when the buffer is not shared
+        # with another image. Otherwise the result is assigned to self.
+
         def __iadd__ ( self, other ):
-            self = Add( self, other )
-            return self;
+            if isinstance( other, Image ):
+               AddImageFilter().ExecuteInPlace( self, other )
+               return self
+            try:
+               AddImageFilter().ExecuteInPlace( self, float(other) )
+               return self
+            except (ValueError, TypeError):
+               return NotImplemented
+        def __isub__ ( self, other ):
+            if isinstance( other, Image ):
+               SubtractImageFilter().ExecuteInPlace( self, other )
+               return self
+            try:
+               SubtractImageFilter().ExecuteInPlace( self, float(other) )
+               return self
+            except (ValueError, TypeError):
+               return NotImplemented
+        def __imul__ ( self, other ):
+            if isinstance( other, Image ):
+               MultiplyImageFilter().ExecuteInPlace( self, other )
+               return self
+            try:
+               MultiplyImageFilter().ExecuteInPlace( self, float(other) )
+               return self
+            except (ValueError, TypeError):
+               return NotImplemented
+        def __idiv__ ( self, other ):
+            if isinstance( other, Image ):
+               DivideImageFilter().ExecuteInPlace( self, other )
+               return self
+            try:
+               DivideImageFilter().ExecuteInPlace( self, float(other) )
+               return self
+            except (ValueError, TypeError):
+               return NotImplemented
+        def __ifloordiv__ ( self, other ):
+            if isinstance( other, Image ):
+               DivideFloorImageFilter().ExecuteInPlace( self, other )
+               return self
+            try:
+               DivideFloorImageFilter().ExecuteInPlace( self, float(other) )
+               return self
+            except (ValueError, TypeError):
+               return NotImplemented
+        def __itruediv__ ( self, other ):
+            if isinstance( other, Image ):
+               DivideRealImageFilter().ExecuteInPlace( self, other )
+               return self
+            try:
+               DivideRealImageFilter().ExecuteInPlace( self, float(other) )
+               return self
+            except (ValueError, TypeError):
+               return NotImplemented
 
         # logic operators
 
@@ -225,6 +276,34 @@
                return NotImplemented
         def __invert__( self ): return BitwiseNot( self )
 
+        def __iand__ ( self, other ):
+            if isinstance( other, Image ):
+               AndImageFilter().ExecuteInPlace( self, other )
+               return self
+            try:
+               AndImageFilter().ExecuteInPlace( self, int(other) )
+               return self
+            except (ValueError, TypeError):
+               return NotImplemented
+        def __ior__ ( self, other ):
+            if isinstance( other, Image ):
+               OrImageFilter().ExecuteInPlace( self, other )
+               return self
+            try:
+               OrImageFilter().ExecuteInPlace( self, int(other) )
+               return self
+            except (ValueError, TypeError):
+               return NotImplemented
+        def __ixor__ ( self, other ):
+            if isinstance( other, Image ):
+               XorImageFilter().ExecuteInPlace( self, other )
+               return self
+            try:
+               XorImageFilter().ExecuteInPlace( self, int(other) )
+               return self
+            except (ValueError, TypeError):
+               return NotImplemented
+
         # Relational and Equality operators
 
         def __lt__( self, other ):
@@ -286,6 +365,15 @@
             except ValueError:
                return NotImplemented
         def __mod__( self, other ): return Modulus( self, other )
+        def __imod__ ( self, other ):
+            if isinstance( other, Image ):
+               ModulusImageFilter().ExecuteInPlace( self, other )
+               return self
+            try:
+               ModulusImageFilter().ExecuteInPlace( self, int(other) )
+               return self
+            except (ValueError, TypeError):
+               return NotImplemented
         def __abs__( self ): return Abs( self )
 
         # iterator and container methods
@@ -599,6 +687,58 @@
 
 
 
+}
+
+%extend itk::simple::ImageExpression {
+
+        %pythoncode %{
+
+        # Operators of a lazy expression record the operation, the
+        # other operand may be an ImageExpression, an Image or a
+        # constant. The expression is computed by Evaluate.
+
+        @staticmethod
+        def _operand( other ):
+            if isinstance( other, ImageExpression ):
+               return other
+            if isinstance( other, Image ):
+               return ImageExpression( other )
+            return ImageExpression( float(other) )
+
+        def _apply( self, operation, other, reverse=False ):
+            try:
+               other = ImageExpression._operand( other )
+            except (ValueError, TypeError):
+               return NotImplemented
+            if reverse:
+               return ImageExpression.Apply( operation, other, self )
+            return ImageExpression.Apply( operation, self, other )
+
+        def __add__( self, other ): return self._apply( ImageExpression.Add, other )
+        def __sub__( self, other ): return self._apply( ImageExpression.Subtract, other )
+        def __mul__( self, other ): return self._apply( ImageExpression.Multiply, other )
+        def __div__( self, other ): return self._apply( ImageExpression.Divide, other )
+        def __truediv__( self, other ): return self._apply( ImageExpression.Divide, other )
+
+        def __radd__( self, other ): return self._apply( ImageExpression.Add, other, True )
+        def __rsub__( self, other ): return self._apply( ImageExpression.Subtract, other, True )
+        def __rmul__( self, other ): return self._apply( ImageExpression.Multiply, other, True )
+        def __rdiv__( self, other ): return self._apply( ImageExpression.Divide, other, True )
+        def __rtruediv__( self, other ): return self._apply( ImageExpression.Divide, other, True )
+
+        def __lt__( self, other ): return self._apply( ImageExpression.Less, other )
+        def __le__( self, other ): return self._apply( ImageExpression.LessEqual, other )
+        def __eq__( self, other ): return self._apply( ImageExpression.Equal, other )
+        def __ne__( self, other ): return self._apply( ImageExpression.NotEqual, other )
+        def __gt__( self, other ): return self._apply( ImageExpression.Greater, other )
+        def __ge__( self, other ): return self._apply( ImageExpression.GreaterEqual, other )
+
+        def __neg__( self ): return ImageExpression.Apply( ImageExpression.UnaryMinus, self )
+        def __pos__( self ): return self
+        def __abs__( self ): return ImageExpression.Apply( ImageExpression.Abs, self )
+
+        %}
+
 }
 
 // This is included inline because SwigMethods (SimpleITKPYTHON_wrap.cxx)
@@ -609,6 +749,8 @@
 // Numpy array conversion support
 %native(_GetMemoryViewFromImage) PyObject *sitk_GetMemoryViewFromImage( PyObject *self, PyObject *args );
 %native(_SetImageFromArray) PyObject *sitk_SetImageFromArray( PyObject *self, PyObject *args );
+%native(_GetImageViewFromArray) PyObject *sitk_GetImageViewFromArray( PyObject *self, PyObject *args );
+%native(_AccessPixelsWithArrays) PyObject *sitk_AccessPixelsWithArrays( PyObject *self, PyObject *args );
 
 %pythoncode %{
 
@@ -761,6 +903,60 @@ def GetArrayFromImage(image):
     return numpy.array(arrayView, copy=True)
 
 
+def _get_pixel_values_array( image, points, dtype ):
+    """Returns the points as a C contiguous array with a row for each point, and an array for the values at the points."""
+
+    if not HAVE_NUMPY:
+        raise ImportError('Numpy not available.')
+
+    points = numpy.ascontiguousarray( points, dtype=dtype ).reshape( -1, image.GetDimension() )
+    numberOfComponents = image.GetNumberOfComponentsPerPixel()
+    if numberOfComponents > 1:
+      values = numpy.empty( ( points.shape[0], numberOfComponents ), dtype=numpy.float64 )
+    else:
+      values = numpy.empty( points.shape[0], dtype=numpy.float64 )
+    return points, values
+
+def GetPixelsAsArray( image, indexes ):
+    """Get the values of many pixels of a SimpleITK Image as a NumPy array.
+
+    The indexes are an array with a row of GetDimension() zero based indexes for each pixel. The values are returned as a float64 array with an element for each index, or a row of components for each index of a vector image. This is the same as Image.GetPixelsAsDouble, without converting the indexes and values to and from lists.
+    """
+
+    indexes, values = _get_pixel_values_array( image, indexes, numpy.uint32 )
+    _SimpleITK._AccessPixelsWithArrays( image, indexes, values, 0 )
+    return values
+
+def SetPixelsFromArray( image, indexes, values ):
+    """Set the values of many pixels of a SimpleITK Image from NumPy arrays.
+
+    The indexes and values have the layout returned by GetPixelsAsArray. This is the same as Image.SetPixelsAsDouble, without converting the indexes and values to lists. If an index is out of bounds no pixel is set.
+    """
+
+    indexes, unused = _get_pixel_values_array( image, indexes, numpy.uint32 )
+    values = numpy.ascontiguousarray( values, dtype=numpy.float64 )
+    _SimpleITK._AccessPixelsWithArrays( image, indexes, values, 1 )
+
+def EvaluateAtContinuousIndexesAsArray( image, indexes, interp=sitkLinear, defaultValue=0.0 ):
+    """Interpolate a SimpleITK Image at many continuous indexes, returning the values as a NumPy array.
+
+    The continuous indexes are an array with a row of GetDimension() values for each point, and the values have the layout returned by GetPixelsAsArray. This is the same as Image.EvaluateAtContinuousIndexes.
+    """
+
+    indexes, values = _get_pixel_values_array( image, indexes, numpy.float64 )
+    _SimpleITK._AccessPixelsWithArrays( image, indexes, values, 2, interp, defaultValue )
+    return values
+
+def EvaluateAtPhysicalPointsAsArray( image, points, interp=sitkLinear, defaultValue=0.0 ):
+    """Interpolate a SimpleITK Image at many physical points, returning the values as a NumPy array.
+
+    The points are an array with a row of GetDimension() coordinates for each point, and the values have the layout returned by GetPixelsAsArray. This is the same as Image.EvaluateAtPhysicalPoints.
+    """
+
+    points, values = _get_pixel_values_array( image, points, numpy.float64 )
+    _SimpleITK._AccessPixelsWithArrays( image, points, values, 3, interp, defaultValue )
+    return values
+
 def GetImageFromArray( arr, isVector=False):
     """Get a SimpleITK Image from a numpy array. If isVector is True, then a 3D array will be treated as a 2D vector image, otherwise it will be treated as a 3D image"""
 
@@ -779,9 +975,38 @@ def GetImageFromArray( arr, isVector=False):
       id = _get_sitk_pixelid( z )
       img = Image( z.shape[::-1], id )
 
-    _SimpleITK._SetImageFromArray( z.tostring(), img )
+    # the buffer of a C contiguous array is copied directly into the image
+    _SimpleITK._SetImageFromArray( numpy.ascontiguousarray( z ), img )
 
     return img
+
+def GetImageViewFromArray( arr, isVector=False):
+    """Get a SimpleITK Image which shares the buffer of a numpy array.
+
+    The image is a "view" of the array's buffer, so no pixels are copied when the array is C contiguous and writable, otherwise a copy is returned as with GetImageFromArray. A reference to the array is held until the last image sharing the buffer is destroyed. Modifying the array's or the image's pixels modifies both. If isVector is True, then a 3D array will be treated as a 2D vector image, otherwise it will be treated as a 3D image.
+    """
+
+    if not HAVE_NUMPY:
+        raise ImportError('Numpy not available.')
+
+    z = numpy.asarray( arr )
+
+    assert z.ndim in ( 2, 3, 4 ), \
+      "Only arrays of 2, 3 or 4 dimensions are supported."
+
+    if not z.flags['C_CONTIGUOUS'] or not z.flags['WRITEABLE']:
+      return GetImageFromArray( z, isVector )
+
+    if ( z.ndim == 3 and isVector ) or (z.ndim == 4):
+      if z.shape[-1] == 1:
+        return GetImageFromArray( z, isVector )
+      id = _get_sitk_vector_pixelid( z )
+      return _SimpleITK._GetImageViewFromArray( z, id, z.shape[-2::-1], z.shape[-1] )
+
+    id = _get_sitk_pixelid( z )
+    if id in ( sitkComplexFloat32, sitkComplexFloat64 ):
+      return GetImageFromArray( z, isVector )
+    return _SimpleITK._GetImageViewFromArray( z, id, z.shape[::-1], 1 )
 %}
 
 
@@ -790,6 +1015,14 @@ def GetImageFromArray( arr, isVector=False):
 // called from C++
 %feature("director") itk::simple::Command;
 
+// When SimpleITK_PYTHON_THREADS is enabled, swig releases the GIL for
+// the duration of each wrapped call, so procedures such as Execute,
+// ReadImage, WriteImage and ImageRegistrationMethod::Execute run
+// concurrently with other python threads. The GIL is reacquired in
+// PyCommand and director callbacks. Wrapped methods which use the
+// Python C API directly must keep the GIL.
+%nothreadallow itk::simple::ProcessObject::AddCommand( itk::simple::EventEnum e, PyObject *obj );
+
 %extend itk::simple::ProcessObject {
  int AddCommand( itk::simple::EventEnum e, PyObject *obj )
  {
@@ -21,6 +21,7 @@
 #include <functional>
 
 #include "sitkImage.h"
+#include "sitkImportImageFilter.h"
 #include "sitkConditional.h"
 #include "sitkExceptionObject.h"
 
@@ -334,6 +335,307 @@ fail:
   return NULL;
 }
 
+/** Releases the python buffer held by an image created with
+ * sitk_GetImageViewFromArray, once no image uses it.
+ */
+static void
+sitk_ReleaseImportedBuffer( void *clientData )
+{
+  PyGILState_STATE gstate = PyGILState_Ensure();
+
+  Py_buffer *pyBuffer = reinterpret_cast< Py_buffer * >( clientData );
+  PyBuffer_Release( pyBuffer );
+  delete pyBuffer;
+
+  PyGILState_Release( gstate );
+}
+
+/** An internal function that creates a SimpleITK Image which shares
+ * the buffer of a C contiguous and writable python buffer object
+ * (shallow). The python buffer is held until the last image sharing
+ * the pixels is destroyed.
+ */
+static PyObject *
+sitk_GetImageViewFromArray( PyObject *SWIGUNUSEDPARM(self), PyObject *args )
+{
+  PyObject *                  pyArray       = NULL;
+  PyObject *                  pySize        = NULL;
+  PyObject *                  pySizeSeq     = NULL;
+  int                         pixelID       = sitk::sitkUnknown;
+  unsigned int                numberOfComponents = 1;
+
+  std::vector< unsigned int > size;
+  size_t                      pixelSize     = 1;
+  size_t                      len           = 1;
+
+  sitk::ImportImageFilter     importer;
+  Py_buffer *                 pyBuffer      = NULL;
+
+  if( !PyArg_ParseTuple( args, "OiOI", &pyArray, &pixelID, &pySize, &numberOfComponents ) )
+    {
+    return NULL;
+    }
+
+  pySizeSeq = PySequence_Fast( pySize, "The size must be a sequence." );
+  if ( pySizeSeq == NULL )
+    {
+    return NULL;
+    }
+  for ( Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE( pySizeSeq ); ++i )
+    {
+    size.push_back( static_cast< unsigned int >( PyLong_AsUnsignedLong( PySequence_Fast_GET_ITEM( pySizeSeq, i ) ) ) );
+    }
+  Py_DECREF( pySizeSeq );
+  if ( PyErr_Occurred() )
+    {
+    return NULL;
+    }
+
+  pyBuffer = new Py_buffer;
+  memset( pyBuffer, 0, sizeof(Py_buffer) );
+  if ( PyObject_GetBuffer( pyArray, pyBuffer, PyBUF_C_CONTIGUOUS | PyBUF_WRITABLE ) != 0 )
+    {
+    delete pyBuffer;
+    return NULL;
+    }
+
+  switch( pixelID )
+    {
+    case sitk::ConditionalValue< sitk::sitkVectorUInt8 != sitk::sitkUnknown, sitk::sitkVectorUInt8, -14 >::Value:
+    case sitk::ConditionalValue< sitk::sitkUInt8 != sitk::sitkUnknown, sitk::sitkUInt8, -2 >::Value:
+      importer.SetBufferAsUInt8( static_cast< uint8_t * >( pyBuffer->buf ), numberOfComponents );
+      pixelSize  = sizeof( uint8_t );
+      break;
+    case sitk::ConditionalValue< sitk::sitkVectorInt8 != sitk::sitkUnknown, sitk::sitkVectorInt8, -15 >::Value:
+    case sitk::ConditionalValue< sitk::sitkInt8 != sitk::sitkUnknown, sitk::sitkInt8, -3 >::Value:
+      importer.SetBufferAsInt8( static_cast< int8_t * >( pyBuffer->buf ), numberOfComponents );
+      pixelSize  = sizeof( int8_t );
+      break;
+    case sitk::ConditionalValue< sitk::sitkVectorUInt16 != sitk::sitkUnknown, sitk::sitkVectorUInt16, -16 >::Value:
+    case sitk::ConditionalValue< sitk::sitkUInt16 != sitk::sitkUnknown, sitk::sitkUInt16, -4 >::Value:
+      importer.SetBufferAsUInt16( static_cast< uint16_t * >( pyBuffer->buf ), numberOfComponents );
+      pixelSize  = sizeof( uint16_t );
+      break;
+    case sitk::ConditionalValue< sitk::sitkVectorInt16 != sitk::sitkUnknown, sitk::sitkVectorInt16, -17 >::Value:
+    case sitk::ConditionalValue< sitk::sitkInt16 != sitk::sitkUnknown, sitk::sitkInt16, -5 >::Value:
+      importer.SetBufferAsInt16( static_cast< int16_t * >( pyBuffer->buf ), numberOfComponents );
+      pixelSize  = sizeof( int16_t );
+      break;
+    case sitk::ConditionalValue< sitk::sitkVectorUInt32 != sitk::sitkUnknown, sitk::sitkVectorUInt32, -18 >::Value:
+    case sitk::ConditionalValue< sitk::sitkUInt32 != sitk::sitkUnknown, sitk::sitkUInt32, -6 >::Value:
+      importer.SetBufferAsUInt32( static_cast< uint32_t * >( pyBuffer->buf ), numberOfComponents );
+      pixelSize  = sizeof( uint32_t );
+      break;
+    case sitk::ConditionalValue< sitk::sitkVectorInt32 != sitk::sitkUnknown, sitk::sitkVectorInt32, -19 >::Value:
+    case sitk::ConditionalValue< sitk::sitkInt32 != sitk::sitkUnknown, sitk::sitkInt32, -7 >::Value:
+      importer.SetBufferAsInt32( static_cast< int32_t * >( pyBuffer->buf ), numberOfComponents );
+      pixelSize  = sizeof( int32_t );
+      break;
+    case sitk::ConditionalValue< sitk::sitkVectorUInt64 != sitk::sitkUnknown, sitk::sitkVectorUInt64, -20 >::Value:
+    case sitk::ConditionalValue< sitk::sitkUInt64 != sitk::sitkUnknown, sitk::sitkUInt64, -8 >::Value:
+      importer.SetBufferAsUInt64( static_cast< uint64_t * >( pyBuffer->buf ), numberOfComponents );
+      pixelSize  = sizeof( uint64_t );
+      break;
+    case sitk::ConditionalValue< sitk::sitkVectorInt64 != sitk::sitkUnknown, sitk::sitkVectorInt64, -21 >::Value:
+    case sitk::ConditionalValue< sitk::sitkInt64 != sitk::sitkUnknown, sitk::sitkInt64, -9 >::Value:
+      importer.SetBufferAsInt64( static_cast< int64_t * >( pyBuffer->buf ), numberOfComponents );
+      pixelSize  = sizeof( int64_t );
+      break;
+    case sitk::ConditionalValue< sitk::sitkVectorFloat32 != sitk::sitkUnknown, sitk::sitkVectorFloat32, -22 >::Value:
+    case sitk::ConditionalValue< sitk::sitkFloat32 != sitk::sitkUnknown, sitk::sitkFloat32, -10 >::Value:
+      importer.SetBufferAsFloat( static_cast< float * >( pyBuffer->buf ), numberOfComponents );
+      pixelSize  = sizeof( float );
+      break;
+    case sitk::ConditionalValue< sitk::sitkVectorFloat64 != sitk::sitkUnknown, sitk::sitkVectorFloat64, -23 >::Value:
+    case sitk::ConditionalValue< sitk::sitkFloat64 != sitk::sitkUnknown, sitk::sitkFloat64, -11 >::Value:
+      importer.SetBufferAsDouble( static_cast< double * >( pyBuffer->buf ), numberOfComponents );
+      pixelSize  = sizeof( double );
+      break;
+    default:
+      PyErr_SetString( PyExc_RuntimeError, "Pixel type is not supported for a shared buffer." );
+      goto fail;
+    }
+
+  len = std::accumulate( size.begin(), size.end(), size_t(1), std::multiplies<size_t>() );
+  len *= numberOfComponents * pixelSize;
+
+  if ( pyBuffer->len < 0 || static_cast< size_t >( pyBuffer->len ) != len )
+    {
+    PyErr_SetString( PyExc_RuntimeError, "Size mismatch of image and Buffer." );
+    goto fail;
+    }
+
+  importer.SetSize( size );
+
+  try
+    {
+    // The image's pixel container releases the buffer when deleted.
+    importer.SetBufferReleaseCallback( sitk_ReleaseImportedBuffer, pyBuffer );
+    sitk::Image *sitkImage = new sitk::Image( importer.Execute() );
+    return SWIG_NewPointerObj( sitkImage, SWIGTYPE_p_itk__simple__Image, SWIG_POINTER_OWN );
+    }
+  catch( const std::exception &e )
+    {
+    std::string msg = "Exception thrown in SimpleITK new Image: ";
+    msg += e.what();
+    PyErr_SetString( PyExc_RuntimeError, msg.c_str() );
+    goto fail;
+    }
+
+fail:
+  PyBuffer_Release( pyBuffer );
+  delete pyBuffer;
+  return NULL;
+}
+
+/** Converts a python object to a SimpleITK Image pointer, setting a
+ * python exception on failure.
+ */
+static sitk::Image *
+sitk_GetImageFromPyObject( PyObject *pyImage )
+{
+  void * voidImage = NULL;
+  int res = SWIG_ConvertPtr( pyImage, &voidImage, SWIGTYPE_p_itk__simple__Image, 0 );
+  if( !SWIG_IsOK( res ) )
+    {
+    PyErr_SetString( PyExc_TypeError, "The argument needs to be of type 'sitk::Image *'." );
+    return NULL;
+    }
+  return reinterpret_cast< sitk::Image * >( voidImage );
+}
+
+/** Gets a C contiguous buffer of items with the expected size from a
+ * python buffer object.
+ */
+static int
+sitk_GetContiguousBuffer( PyObject *pyObject, Py_buffer *pyBuffer, Py_ssize_t itemSize, bool writable )
+{
+  const int flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | ( writable ? PyBUF_WRITABLE : 0 );
+  if ( PyObject_GetBuffer( pyObject, pyBuffer, flags ) != 0 )
+    {
+    return -1;
+    }
+  if ( pyBuffer->itemsize != itemSize )
+    {
+    PyBuffer_Release( pyBuffer );
+    PyErr_SetString( PyExc_TypeError, "Unexpected item size of buffer." );
+    return -1;
+    }
+  return 0;
+}
+
+/** An internal function for the batched pixel access methods of a
+ * SimpleITK Image, which work directly on the buffers of an array of
+ * indexes or points and an array of values. The operation is:
+ *  0 - GetPixelsAsDouble
+ *  1 - SetPixelsAsDouble
+ *  2 - EvaluateAtContinuousIndexes
+ *  3 - EvaluateAtPhysicalPoints
+ * The GIL is released while the pixels are accessed.
+ */
+static PyObject *
+sitk_AccessPixelsWithArrays( PyObject *SWIGUNUSEDPARM(self), PyObject *args )
+{
+  PyObject *                  pyImage       = NULL;
+  PyObject *                  pyPoints      = NULL;
+  PyObject *                  pyValues      = NULL;
+  int                         operation     = 0;
+  int                         interpolator  = sitk::sitkLinear;
+  double                      defaultValue  = 0.0;
+
+  sitk::Image *               sitkImage     = NULL;
+  size_t                      numberOfPoints = 0;
+  size_t                      pointSize     = 0;
+  size_t                      valueSize     = 0;
+  std::string                 errorMessage;
+
+  Py_buffer                   pointsBuffer;
+  Py_buffer                   valuesBuffer;
+  memset(&pointsBuffer, 0, sizeof(Py_buffer));
+  memset(&valuesBuffer, 0, sizeof(Py_buffer));
+
+  if( !PyArg_ParseTuple( args, "OOOi|id", &pyImage, &pyPoints, &pyValues, &operation, &interpolator, &defaultValue ) )
+    {
+    return NULL;
+    }
+
+  sitkImage = sitk_GetImageFromPyObject( pyImage );
+  if ( sitkImage == NULL )
+    {
+    return NULL;
+    }
+
+  // indexes are uint32_t, continuous indexes and points are double
+  pointSize = ( operation < 2 ) ? sizeof( uint32_t ) : sizeof( double );
+  if ( sitk_GetContiguousBuffer( pyPoints, &pointsBuffer, pointSize, false ) != 0 )
+    {
+    return NULL;
+    }
+  if ( sitk_GetContiguousBuffer( pyValues, &valuesBuffer, sizeof( double ), operation != 1 ) != 0 )
+    {
+    PyBuffer_Release( &pointsBuffer );
+    return NULL;
+    }
+
+  pointSize *= sitkImage->GetDimension();
+  valueSize = sitkImage->GetNumberOfComponentsPerPixel() * sizeof( double );
+  numberOfPoints = static_cast< size_t >( pointsBuffer.len ) / pointSize;
+  if ( numberOfPoints * pointSize != static_cast< size_t >( pointsBuffer.len )
+       || numberOfPoints * valueSize != static_cast< size_t >( valuesBuffer.len ) )
+    {
+    PyErr_SetString( PyExc_RuntimeError, "Size mismatch of image and Buffer." );
+    goto fail;
+    }
+
+  Py_BEGIN_ALLOW_THREADS
+  try
+    {
+    const sitk::InterpolatorEnum interp = static_cast< sitk::InterpolatorEnum >( interpolator );
+    switch( operation )
+      {
+      case 0:
+        sitkImage->GetPixelsAsDouble( static_cast< const uint32_t * >( pointsBuffer.buf ), numberOfPoints,
+                                      static_cast< double * >( valuesBuffer.buf ) );
+        break;
+      case 1:
+        sitkImage->SetPixelsAsDouble( static_cast< const uint32_t * >( pointsBuffer.buf ), numberOfPoints,
+                                      static_cast< const double * >( valuesBuffer.buf ) );
+        break;
+      case 2:
+        sitkImage->EvaluateAtContinuousIndexes( static_cast< const double * >( pointsBuffer.buf ), numberOfPoints,
+                                                static_cast< double * >( valuesBuffer.buf ), interp, defaultValue );
+        break;
+      case 3:
+        sitkImage->EvaluateAtPhysicalPoints( static_cast< const double * >( pointsBuffer.buf ), numberOfPoints,
+                                             static_cast< double * >( valuesBuffer.buf ), interp, defaultValue );
+        break;
+      default:
+        errorMessage = "Unknown pixel access operation.";
+      }
+    }
+  catch( const std::exception &e )
+    {
+    errorMessage = "Exception thrown in SimpleITK pixel access: ";
+    errorMessage += e.what();
+    }
+  Py_END_ALLOW_THREADS
+
+  if ( !errorMessage.empty() )
+    {
+    PyErr_SetString( PyExc_RuntimeError, errorMessage.c_str() );
+    goto fail;
+    }
+
+  PyBuffer_Release( &pointsBuffer );
+  PyBuffer_Release( &valuesBuffer );
+  Py_RETURN_NONE;
+
+fail:
+  PyBuffer_Release( &pointsBuffer );
+  PyBuffer_Release( &valuesBuffer );
+  return NULL;
+}
+
 #ifdef __cplusplus
 } // end extern "C"
 #endif
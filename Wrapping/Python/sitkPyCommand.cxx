@@ -104,6 +104,11 @@ void PyCommand::Execute()
     return;
     }
 
+  // Commands may be invoked while the GIL is released during a
+  // filter's execution, so it must be acquired before using any
+  // python object.
+  PyGILStateEnsure gil;
+
   // make sure that the CommandCallable is in fact callable
   if (!PyCallable_Check(this->m_Object))
     {
@@ -115,8 +120,6 @@ void PyCommand::Execute()
     }
   else
     {
-    PyGILStateEnsure gil;
-
     PyObject *result;
 
     result = PyObject_CallObject(this->m_Object, (PyObject *)NULL);